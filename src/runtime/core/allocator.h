@@ -0,0 +1,84 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#pragma once
+
+#include "core/concepts.h"
+#include "core/os/memory.h"
+
+OP_NAMESPACE_BEGIN
+
+/**
+ * Source of memory for containers.
+ *
+ * Containers store their allocator by value so allocators should be cheap to copy. Allocators that own memory, such as
+ * Arena, are used through a small handle that points at them instead.
+ */
+template <typename A>
+concept Allocator = requires(A allocator, NonNull<void> ptr, const core::Layout& layout) {
+	{ allocator.malloc(layout) } -> SameAs<NonNull<void>>;
+	{ allocator.realloc(ptr, layout, layout) } -> SameAs<NonNull<void>>;
+	allocator.free(ptr, layout);
+};
+
+OP_NAMESPACE_END
+
+OP_CORE_NAMESPACE_BEGIN
+
+/**
+ * Allocates through core::malloc. Has no state so containers using it take no extra space.
+ */
+class GlobalAllocator {
+public:
+	// Allocator
+	OP_ALWAYS_INLINE NonNull<void> malloc(const Layout& layout) const { return core::malloc(layout); }
+	OP_ALWAYS_INLINE NonNull<void>
+	realloc(NonNull<void> old_ptr, const Layout& old_layout, const Layout& new_layout) const {
+		return core::realloc(old_ptr, old_layout, new_layout);
+	}
+	OP_ALWAYS_INLINE void free(NonNull<void> ptr, const Layout& layout) const {
+		OP_UNUSED(layout);
+		core::free(ptr);
+	}
+	// ~Allocator
+};
+
+/**
+ * Allocates blocks of at least threshold bytes with core::malloc_large so they are backed by huge pages, and smaller
+ * blocks with core::malloc. Meant for buffers that grow to several megabytes and are walked linearly, such as ECS
+ * columns and font atlases.
+ */
+class LargePageAllocator {
+public:
+	static constexpr usize threshold = 2 * MB;
+
+	// Allocator
+	OP_ALWAYS_INLINE NonNull<void> malloc(const Layout& layout) const {
+		return layout.size >= threshold ? core::malloc_large(layout) : core::malloc(layout);
+	}
+	NonNull<void> realloc(NonNull<void> old_ptr, const Layout& old_layout, const Layout& new_layout) const {
+		if (old_layout.size < threshold && new_layout.size < threshold) {
+			return core::realloc(old_ptr, old_layout, new_layout);
+		}
+
+		auto result = malloc(new_layout);
+		core::copy(result, static_cast<void*>(old_ptr), old_layout.size < new_layout.size ? old_layout.size : new_layout.size);
+		free(old_ptr, old_layout);
+		return result;
+	}
+	OP_ALWAYS_INLINE void free(NonNull<void> ptr, const Layout& layout) const {
+		if (layout.size >= threshold) {
+			core::free_large(ptr, layout);
+		} else {
+			core::free(ptr);
+		}
+	}
+	// ~Allocator
+};
+
+OP_CORE_NAMESPACE_END
+
+// Export to op namespace
+OP_NAMESPACE_BEGIN
+using core::GlobalAllocator;
+using core::LargePageAllocator;
+OP_NAMESPACE_END
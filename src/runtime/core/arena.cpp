@@ -0,0 +1,180 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#include "core/arena.h"
+
+OP_CORE_NAMESPACE_BEGIN
+
+static OP_ALWAYS_INLINE usize align_up(usize value, usize alignment) {
+	OP_ASSERT(alignment > 0 && (alignment & (alignment - 1)) == 0, "Alignment must be a power of two");
+	return (value + alignment - 1) & ~(alignment - 1);
+}
+
+Arena::Arena(usize block_size) : m_block_size(block_size) { OP_ASSERT(block_size > 0); }
+
+Arena::Arena(Arena&& move) noexcept
+	: m_first(move.m_first)
+	, m_current(move.m_current)
+	, m_last(move.m_last)
+	, m_block_size(move.m_block_size) {
+	move.m_first = nullptr;
+	move.m_current = nullptr;
+	move.m_last = nullptr;
+}
+
+Arena& Arena::operator=(Arena&& move) noexcept {
+	if (this != &move) {
+		auto to_destroy = op::move(*this);
+		OP_UNUSED(to_destroy);
+
+		m_first = move.m_first;
+		m_current = move.m_current;
+		m_last = move.m_last;
+		m_block_size = move.m_block_size;
+
+		move.m_first = nullptr;
+		move.m_current = nullptr;
+		move.m_last = nullptr;
+	}
+	return *this;
+}
+
+Arena::~Arena() {
+	auto* block = m_first;
+	while (block != nullptr) {
+		auto* next = block->next;
+		core::free(block);
+		block = next;
+	}
+	m_first = nullptr;
+	m_current = nullptr;
+}
+
+NonNull<void> Arena::malloc(const Layout& layout) {
+	if (m_current != nullptr) {
+		const auto address = reinterpret_cast<usize>(m_current->data() + m_current->used);
+		const auto padding = align_up(address, layout.alignment) - address;
+		if (m_current->used + padding + layout.size <= m_current->size) {
+			m_last = m_current->data() + m_current->used + padding;
+			m_current->used += padding + layout.size;
+			return m_last;
+		}
+	}
+
+	next_block(layout);
+
+	const auto address = reinterpret_cast<usize>(m_current->data());
+	const auto padding = align_up(address, layout.alignment) - address;
+	m_last = m_current->data() + padding;
+	m_current->used = padding + layout.size;
+	return m_last;
+}
+
+NonNull<void> Arena::realloc(NonNull<void> old_ptr, const Layout& old_layout, const Layout& new_layout) {
+	// The most recent allocation can grow or shrink in place if the block has room.
+	auto* ptr = static_cast<u8*>(static_cast<void*>(old_ptr));
+	if (ptr == m_last && new_layout.alignment <= old_layout.alignment) {
+		const auto start = static_cast<usize>(ptr - m_current->data());
+		if (start + new_layout.size <= m_current->size) {
+			m_current->used = start + new_layout.size;
+			return old_ptr;
+		}
+	}
+
+	auto result = malloc(new_layout);
+	core::copy(result, static_cast<void*>(old_ptr), old_layout.size < new_layout.size ? old_layout.size : new_layout.size);
+	return result;
+}
+
+void Arena::free(NonNull<void> ptr, const Layout& layout) {
+	OP_UNUSED(layout);
+
+	// Only the most recent allocation can be given back. Everything else waits for a reset.
+	auto* bytes = static_cast<u8*>(static_cast<void*>(ptr));
+	if (bytes == m_last) {
+		m_current->used = static_cast<usize>(bytes - m_current->data());
+		m_last = nullptr;
+	}
+}
+
+Arena::Marker Arena::mark() const { return Marker{ m_current, m_current != nullptr ? m_current->used : 0 }; }
+
+void Arena::reset_to(const Marker& marker) {
+	m_last = nullptr;
+	if (marker.block == nullptr) {
+		reset();
+		return;
+	}
+
+	m_current = static_cast<Block*>(marker.block);
+	m_current->used = marker.used;
+}
+
+void Arena::reset() {
+	m_last = nullptr;
+	m_current = m_first;
+	if (m_current != nullptr) {
+		m_current->used = 0;
+	}
+}
+
+usize Arena::used_bytes() const {
+	if (m_current == nullptr) {
+		return 0;
+	}
+
+	usize result = 0;
+	for (auto* block = m_first; block != m_current; block = block->next) {
+		result += block->used;
+	}
+	return result + m_current->used;
+}
+
+usize Arena::allocated_bytes() const {
+	usize result = 0;
+	for (auto* block = m_first; block != nullptr; block = block->next) {
+		result += sizeof(Block) + block->size;
+	}
+	return result;
+}
+
+void Arena::next_block(const Layout& layout) {
+	// Worst case padding is alignment - 1 bytes as block data is only aligned to the block header.
+	const auto required = layout.size + layout.alignment - 1;
+
+	// Reuse blocks left over from before a reset when they are large enough.
+	auto* spare = m_current != nullptr ? m_current->next : m_first;
+	if (spare != nullptr && spare->size >= required) {
+		spare->used = 0;
+		m_current = spare;
+		return;
+	}
+
+	const auto size = required > m_block_size ? required : m_block_size;
+	void* ptr = core::malloc(Layout{ sizeof(Block) + size, alignof(Block) });
+	auto* block = static_cast<Block*>(ptr);
+	block->next = spare;
+	block->size = size;
+	block->used = 0;
+
+	if (m_current != nullptr) {
+		m_current->next = block;
+	} else {
+		m_first = block;
+	}
+	m_current = block;
+}
+
+FrameArena::FrameArena(usize block_size) : m_arenas{ Arena(block_size), Arena(block_size) } {}
+
+void FrameArena::begin_frame() {
+	m_frame += 1;
+	current().reset();
+}
+
+Arena& scratch_arena() {
+	// OP_THREAD_LOCAL can not run destructors so the blocks would leak when the thread exits.
+	static thread_local Arena arena;
+	return arena;
+}
+
+OP_CORE_NAMESPACE_END
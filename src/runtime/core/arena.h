@@ -0,0 +1,145 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#pragma once
+
+#include "core/allocator.h"
+#include "core/non_copyable.h"
+
+OP_CORE_NAMESPACE_BEGIN
+
+/**
+ * Linear allocator that hands out memory by bumping an offset through large blocks.
+ *
+ * Allocations are not freed individually. Only the most recent allocation can be grown, shrunk or freed in place, which
+ * covers a Vector being pushed to while nothing else allocates. Everything is released at once by reset, or back to a
+ * Marker taken earlier. Blocks are kept across resets so a warmed up arena stops calling core::malloc entirely.
+ *
+ * Destructors of objects placed in an arena are never run by the arena.
+ */
+class Arena : NonCopyable {
+public:
+	static constexpr usize default_block_size = 64 * 1024;
+
+	explicit Arena(usize block_size = default_block_size);
+	Arena(Arena&& move) noexcept;
+	Arena& operator=(Arena&& move) noexcept;
+	~Arena();
+
+	// Allocator
+	NonNull<void> malloc(const Layout& layout);
+	NonNull<void> realloc(NonNull<void> old_ptr, const Layout& old_layout, const Layout& new_layout);
+	void free(NonNull<void> ptr, const Layout& layout);
+	// ~Allocator
+
+	template <typename T, typename... Args>
+	T& make(Args&&... args) {
+		static_assert(std::is_trivially_destructible_v<T>, "Arena never runs destructors");
+		return *new (malloc(Layout::single<T>)) T(op::forward<Args>(args)...);
+	}
+
+	// A position in the arena that it can be reset back to.
+	struct Marker {
+		void* block;
+		usize used;
+	};
+	OP_NO_DISCARD Marker mark() const;
+	// Frees everything allocated after marker was taken.
+	void reset_to(const Marker& marker);
+	// Frees everything but keeps the blocks for reuse.
+	void reset();
+
+	// Bytes handed out since the last reset, including alignment padding.
+	OP_NO_DISCARD usize used_bytes() const;
+	// Bytes held in blocks, used or not.
+	OP_NO_DISCARD usize allocated_bytes() const;
+
+private:
+	struct Block {
+		Block* next;
+		usize size;
+		usize used;
+
+		OP_ALWAYS_INLINE u8* data() { return reinterpret_cast<u8*>(this + 1); }
+	};
+
+	// Moves to the next block with room for layout, allocating one if none of the spare blocks fit.
+	void next_block(const Layout& layout);
+
+	Block* m_first = nullptr;
+	Block* m_current = nullptr;
+	// Start of the most recent allocation so it can be resized in place.
+	u8* m_last = nullptr;
+	usize m_block_size;
+};
+
+/**
+ * Resets an arena back to where it was when the scope was created.
+ */
+class ArenaScope : NonCopyable {
+public:
+	explicit ArenaScope(Arena& arena) : m_arena(arena), m_marker(arena.mark()) {}
+	~ArenaScope() { m_arena.reset_to(m_marker); }
+
+private:
+	Arena& m_arena;
+	Arena::Marker m_marker;
+};
+
+/**
+ * Handle for allocating from an Arena through containers. The arena must outlive every container using it.
+ */
+class ArenaAllocator {
+public:
+	explicit ArenaAllocator(Arena& arena) : m_arena(&arena) {}
+
+	// Allocator
+	OP_ALWAYS_INLINE NonNull<void> malloc(const Layout& layout) const { return m_arena->malloc(layout); }
+	OP_ALWAYS_INLINE NonNull<void>
+	realloc(NonNull<void> old_ptr, const Layout& old_layout, const Layout& new_layout) const {
+		return m_arena->realloc(old_ptr, old_layout, new_layout);
+	}
+	OP_ALWAYS_INLINE void free(NonNull<void> ptr, const Layout& layout) const { m_arena->free(ptr, layout); }
+	// ~Allocator
+
+private:
+	Arena* m_arena;
+};
+
+/**
+ * Pair of arenas that take turns every frame.
+ *
+ * Memory allocated during a frame stays valid until the end of the next frame, so data built by one frame can be
+ * consumed by the next without copying. Starting a frame releases everything allocated two frames ago.
+ */
+class FrameArena : NonCopyable {
+public:
+	explicit FrameArena(usize block_size = Arena::default_block_size);
+
+	void begin_frame();
+
+	OP_ALWAYS_INLINE Arena& current() { return m_arenas[m_frame % 2]; }
+	OP_ALWAYS_INLINE Arena& previous() { return m_arenas[(m_frame + 1) % 2]; }
+	OP_ALWAYS_INLINE ArenaAllocator allocator() { return ArenaAllocator(current()); }
+	OP_NO_DISCARD OP_ALWAYS_INLINE u64 frame() const { return m_frame; }
+
+private:
+	Arena m_arenas[2];
+	u64 m_frame = 0;
+};
+
+/**
+ * Arena owned by the calling thread for temporary allocations that do not outlive the current scope. Always allocate
+ * from it inside an ArenaScope so nested users release their memory in order.
+ */
+Arena& scratch_arena();
+
+OP_CORE_NAMESPACE_END
+
+// Export to op namespace
+OP_NAMESPACE_BEGIN
+using core::Arena;
+using core::ArenaAllocator;
+using core::ArenaScope;
+using core::FrameArena;
+using core::scratch_arena;
+OP_NAMESPACE_END
@@ -36,6 +36,12 @@ public:
 	OP_NO_DISCARD OP_ALWAYS_INLINE T fetch_or(T arg, Order order = Order::SeqCst) const noexcept;
 	OP_NO_DISCARD OP_ALWAYS_INLINE T fetch_xor(T arg, Order order = Order::SeqCst) const noexcept;
 
+	// Blocks while the value equals old. May return spuriously, so callers recheck their condition.
+	OP_ALWAYS_INLINE void wait(T old, Order order = Order::SeqCst) const noexcept;
+	// Wakes threads blocked in wait. Cheap when nobody is waiting, but still a call into the standard library.
+	OP_ALWAYS_INLINE void notify_one() const noexcept;
+	OP_ALWAYS_INLINE void notify_all() const noexcept;
+
 private:
 	OP_ALWAYS_INLINE std::memory_order to_std(Order order) const {
 		static const std::memory_order convert[] = { std::memory_order_relaxed,
@@ -9,6 +9,7 @@ template <typename T>
 OP_ALWAYS_INLINE Atomic<T>& Atomic<T>::operator=(Atomic&& rhs) noexcept {
 	const auto order = std::memory_order_relaxed;
 	m_atomic.store(rhs.m_atomic.load(order), order);
+	return *this;
 }
 
 template <typename T>
@@ -69,4 +70,19 @@ OP_NO_DISCARD OP_ALWAYS_INLINE T Atomic<T>::fetch_xor(T arg, Order order) const
 	return m_atomic.fetch_xor(arg, to_std(order));
 }
 
+template <typename T>
+OP_ALWAYS_INLINE void Atomic<T>::wait(T old, Order order) const noexcept {
+	m_atomic.wait(old, to_std(order));
+}
+
+template <typename T>
+OP_ALWAYS_INLINE void Atomic<T>::notify_one() const noexcept {
+	m_atomic.notify_one();
+}
+
+template <typename T>
+OP_ALWAYS_INLINE void Atomic<T>::notify_all() const noexcept {
+	m_atomic.notify_all();
+}
+
 OP_CORE_NAMESPACE_END
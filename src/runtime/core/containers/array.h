@@ -4,40 +4,99 @@
 
 #include "core/containers/option.h"
 #include "core/containers/slice.h"
+#include "core/initializer_list.h"
 
 OP_CORE_NAMESPACE_BEGIN
 
+OP_HIDDEN_NAMESPACE_BEGIN
+
+// Elements that can sit in a plain C array without running constructors or destructors.
+template <typename Element>
+concept TrivialArrayElement =
+	std::is_trivially_copyable_v<Element> && std::is_trivially_default_constructible_v<Element>;
+
+template <typename Element, usize Count>
+struct ArrayStorage {
+	OP_ALWAYS_INLINE Element* data() { return reinterpret_cast<Element*>(bytes); }
+	OP_ALWAYS_INLINE const Element* data() const { return reinterpret_cast<const Element*>(bytes); }
+
+	alignas(Element) u8 bytes[sizeof(Element[Count])];
+};
+
+// A real array of elements so Array can be built and read in constant expressions.
+template <typename Element, usize Count>
+	requires TrivialArrayElement<Element>
+struct ArrayStorage<Element, Count> {
+	OP_ALWAYS_INLINE constexpr Element* data() { return elements; }
+	OP_ALWAYS_INLINE constexpr const Element* data() const { return elements; }
+
+	Element elements[Count];
+};
+
+OP_HIDDEN_NAMESPACE_END
+
+/**
+ * A vector with a fixed capacity that stores its elements inline.
+ *
+ * When Element is trivially copyable so is Array, which lets it be copied with memcpy and embedded in other trivially
+ * copyable types. When Element is also trivially default constructible Array can be built in constant expressions.
+ *
+ * @tparam Element The type of element to store in the array.
+ * @tparam Count The maximum number of elements.
+ */
 template <typename Element, usize Count>
 class Array {
 public:
 	static_assert(Count > 0, "Must have a Count greater than zero for this to be useful");
 
-	Array() = default;
+	constexpr Array() noexcept;
+	constexpr Array(InitializerList<Element> list) noexcept;
 
+	// The defaulted versions are picked when they apply, keeping Array trivially copyable.
+	Array(const Array& copy) noexcept
+		requires std::is_trivially_copyable_v<Element>
+	= default;
 	Array(const Array& copy) noexcept;
+	Array& operator=(const Array& copy) noexcept
+		requires std::is_trivially_copyable_v<Element>
+	= default;
 	Array& operator=(const Array& copy) noexcept;
+	Array(Array&& move) noexcept
+		requires std::is_trivially_copyable_v<Element>
+	= default;
 	Array(Array&& move) noexcept;
+	Array& operator=(Array&& move) noexcept
+		requires std::is_trivially_copyable_v<Element>
+	= default;
 	Array& operator=(Array&& move) noexcept;
 
+	~Array()
+		requires std::is_trivially_destructible_v<Element>
+	= default;
 	~Array();
 
-	OP_NO_DISCARD OP_ALWAYS_INLINE usize len() const { return m_len; }
+	OP_NO_DISCARD OP_ALWAYS_INLINE constexpr usize len() const { return m_len; }
+	OP_NO_DISCARD OP_ALWAYS_INLINE static constexpr usize cap() { return Count; }
 
-	OP_NO_DISCARD OP_ALWAYS_INLINE bool is_empty() const { return len() == 0; }
-	OP_NO_DISCARD OP_ALWAYS_INLINE operator bool() const { return !is_empty(); }
-	OP_NO_DISCARD OP_ALWAYS_INLINE bool is_valid_index(usize index) const;
+	OP_NO_DISCARD OP_ALWAYS_INLINE constexpr bool is_empty() const { return len() == 0; }
+	OP_NO_DISCARD OP_ALWAYS_INLINE constexpr bool is_full() const { return len() == Count; }
+	OP_NO_DISCARD OP_ALWAYS_INLINE constexpr operator bool() const { return !is_empty(); }
+	OP_NO_DISCARD OP_ALWAYS_INLINE constexpr bool is_valid_index(usize index) const { return index < len(); }
 
 	OP_ALWAYS_INLINE operator Slice<Element>();
 	OP_ALWAYS_INLINE operator Slice<Element const>() const;
 
-	OP_ALWAYS_INLINE Element* begin() { return reinterpret_cast<Element*>(m_bytes); }
-	OP_ALWAYS_INLINE Element* end() { return begin() + m_len; }
+	OP_ALWAYS_INLINE constexpr Element* begin() { return m_storage.data(); }
+	OP_ALWAYS_INLINE constexpr Element* end() { return begin() + m_len; }
+
+	OP_ALWAYS_INLINE constexpr const Element* begin() const { return m_storage.data(); }
+	OP_ALWAYS_INLINE constexpr const Element* end() const { return begin() + m_len; }
 
-	OP_ALWAYS_INLINE const Element* cbegin() const;
-	OP_ALWAYS_INLINE const Element* cend() const;
+	OP_ALWAYS_INLINE constexpr const Element* cbegin() const { return begin(); }
+	OP_ALWAYS_INLINE constexpr const Element* cend() const { return end(); }
 
-	OP_ALWAYS_INLINE Element& operator[](usize index);
-	OP_ALWAYS_INLINE const Element& operator[](usize index) const;
+	OP_ALWAYS_INLINE constexpr Element& operator[](usize index);
+	OP_ALWAYS_INLINE constexpr const Element& operator[](usize index) const;
 
 	OP_NO_DISCARD OP_ALWAYS_INLINE Option<Element&> last();
 	OP_NO_DISCARD OP_ALWAYS_INLINE Option<Element const&> last() const;
@@ -66,7 +125,7 @@ public:
 	 * @param item - element moved into array
 	 * @return index that the element was inserted at
 	 */
-	OP_ALWAYS_INLINE usize push(Element&& item);
+	OP_ALWAYS_INLINE constexpr usize push(Element&& item);
 
 	/**
 	 * Adds item to the end of array by copying it
@@ -74,7 +133,31 @@ public:
 	 * @param item - element copied into array
 	 * @return index that the element was inserted at
 	 */
-	OP_ALWAYS_INLINE usize push(const Element& item);
+	OP_ALWAYS_INLINE constexpr usize push(const Element& item);
+
+	/**
+	 * Appends a copy of every element in slice with a single memcpy when Element is trivially copyable. slice must
+	 * fit in the remaining capacity and must not point into this array.
+	 */
+	void extend(Slice<const Element> slice);
+
+	/**
+	 * Sets every slot up to the capacity to a copy of value, leaving the array full. Byte sized elements are filled
+	 * with a single memset.
+	 */
+	void fill(const Element& value);
+
+	/**
+	 * Index of the first element equal to value. Byte sized elements are searched with core::find_byte.
+	 */
+	OP_NO_DISCARD Option<usize> find(const Element& value) const;
+	OP_NO_DISCARD OP_ALWAYS_INLINE bool contains(const Element& value) const { return find(value).is_set(); }
+
+	/**
+	 * Compares the elements in order. Elements whose bytes fully decide equality are compared with a single memcmp.
+	 */
+	OP_NO_DISCARD bool operator==(const Array& other) const;
+	OP_NO_DISCARD OP_ALWAYS_INLINE bool operator!=(const Array& other) const { return !(*this == other); }
 
 	/**
 	 * Removes an item from the array by moving it out and then shifting moving
@@ -100,7 +183,7 @@ public:
 	void reset();
 
 private:
-	alignas(Element[Count]) u8 m_bytes[sizeof(Element[Count])];
+	hidden::ArrayStorage<Element, Count> m_storage;
 	usize m_len = 0;
 };
 
@@ -4,6 +4,26 @@
 
 OP_CORE_NAMESPACE_BEGIN
 
+template <typename Element, usize Count>
+constexpr Array<Element, Count>::Array() noexcept {
+	// Constant expressions can not leave any part of the result uninitialized.
+	if constexpr (hidden::TrivialArrayElement<Element>) {
+		if (std::is_constant_evaluated()) {
+			for (usize i = 0; i < Count; ++i) {
+				m_storage.elements[i] = Element{};
+			}
+		}
+	}
+}
+
+template <typename Element, usize Count>
+constexpr Array<Element, Count>::Array(InitializerList<Element> list) noexcept : Array() {
+	OP_ASSERT(list.size() <= Count, "Too many elements for the array");
+	for (const auto& item : list) {
+		push(item);
+	}
+}
+
 template <typename Element, usize Count>
 Array<Element, Count>::Array(const Array& copy) noexcept : m_len(copy.m_len) {
 	for (usize i = 0; i < m_len; ++i) {
@@ -30,7 +50,7 @@ Array<Element, Count>::Array(Array&& move) noexcept : m_len(move.m_len) {
 		new (begin() + i) Element(op::move(move[i]));
 	}
 
-	move.m_len = 0;
+	move.reset();
 }
 
 template <typename Element, usize Count>
@@ -43,22 +63,14 @@ Array<Element, Count>& Array<Element, Count>::operator=(Array&& move) noexcept {
 		new (begin() + i) Element(op::move(move[i]));
 	}
 
-	move.m_len = 0;
+	move.reset();
 
 	return *this;
 }
 
 template <typename Element, usize Count>
 Array<Element, Count>::~Array() {
-	for (usize i = 0; i < m_len; ++i) {
-		Element& item = begin()[i];
-		item.~Element();
-	}
-}
-
-template <typename Element, usize Count>
-OP_ALWAYS_INLINE bool Array<Element, Count>::is_valid_index(usize index) const {
-	return index < len();
+	reset();
 }
 
 template <typename Element, usize Count>
@@ -72,25 +84,15 @@ OP_ALWAYS_INLINE Array<Element, Count>::operator Slice<Element const>() const {
 }
 
 template <typename Element, usize Count>
-OP_ALWAYS_INLINE const Element* Array<Element, Count>::cbegin() const {
-	return reinterpret_cast<const Element*>(m_bytes);
-}
-
-template <typename Element, usize Count>
-OP_ALWAYS_INLINE const Element* Array<Element, Count>::cend() const {
-	return cbegin() + m_len;
-}
-
-template <typename Element, usize Count>
-OP_ALWAYS_INLINE Element& Array<Element, Count>::operator[](usize index) {
+OP_ALWAYS_INLINE constexpr Element& Array<Element, Count>::operator[](usize index) {
 	OP_ASSERT(is_valid_index(index), "Index out of bounds");
 	return begin()[index];
 }
 
 template <typename Element, usize Count>
-OP_ALWAYS_INLINE const Element& Array<Element, Count>::operator[](usize index) const {
+OP_ALWAYS_INLINE constexpr const Element& Array<Element, Count>::operator[](usize index) const {
 	OP_ASSERT(is_valid_index(index), "Index out of bounds");
-	return cbegin()[index];
+	return begin()[index];
 }
 
 template <typename Element, usize Count>
@@ -101,7 +103,7 @@ OP_ALWAYS_INLINE Option<Element&> Array<Element, Count>::last() {
 
 template <typename Element, usize Count>
 OP_ALWAYS_INLINE Option<Element const&> Array<Element, Count>::last() const {
-	if (len() > 0) return cbegin()[len() - 1];
+	if (len() > 0) return begin()[len() - 1];
 	return nullptr;
 }
 
@@ -127,28 +129,108 @@ OP_ALWAYS_INLINE void Array<Element, Count>::insert(usize index, const Element&
 }
 
 template <typename Element, usize Count>
-OP_ALWAYS_INLINE usize Array<Element, Count>::push(Element&& item) {
+OP_ALWAYS_INLINE constexpr usize Array<Element, Count>::push(Element&& item) {
+	OP_ASSERT(len() != Count, "Array is at max capacity.");
+
 	const auto index = len();
-	insert(index, op::move(item));
+	if constexpr (hidden::TrivialArrayElement<Element>) {
+		// Placement new is not allowed in constant expressions, assignment does the same for trivial types.
+		m_storage.elements[index] = item;
+	} else {
+		new (begin() + index) Element(op::move(item));
+	}
+	m_len += 1;
 	return index;
 }
 
 template <typename Element, usize Count>
-OP_ALWAYS_INLINE usize Array<Element, Count>::push(const Element& item) {
+OP_ALWAYS_INLINE constexpr usize Array<Element, Count>::push(const Element& item) {
 	Element copy = item;
 	return push(op::move(copy));
 }
 
+template <typename Element, usize Count>
+void Array<Element, Count>::extend(Slice<const Element> slice) {
+	if (slice.len() == 0) {
+		return;
+	}
+	OP_ASSERT(slice.len() <= Count - m_len, "Array is at max capacity.");
+	OP_ASSERT(slice.begin() >= end() || slice.end() <= begin(), "Can not extend an array with its own elements");
+
+	if constexpr (std::is_trivially_copyable_v<Element>) {
+		core::copy(end(), slice.begin(), slice.len() * sizeof(Element));
+	} else {
+		for (usize i = 0; i < slice.len(); ++i) {
+			new (end() + i) Element(slice[i]);
+		}
+	}
+	m_len += slice.len();
+}
+
+template <typename Element, usize Count>
+void Array<Element, Count>::fill(const Element& value) {
+	if constexpr (sizeof(Element) == 1 && std::is_trivially_copyable_v<Element>) {
+		u8 byte;
+		core::copy(&byte, &value, 1);
+		core::set(begin(), byte, Count);
+	} else {
+		for (usize i = 0; i < m_len; ++i) {
+			begin()[i] = value;
+		}
+		for (usize i = m_len; i < Count; ++i) {
+			new (begin() + i) Element(value);
+		}
+	}
+	m_len = Count;
+}
+
+template <typename Element, usize Count>
+Option<usize> Array<Element, Count>::find(const Element& value) const {
+	if constexpr (sizeof(Element) == 1 && std::has_unique_object_representations_v<Element>) {
+		u8 byte;
+		core::copy(&byte, &value, 1);
+		const auto index = core::find_byte(begin(), byte, m_len);
+		if (index != m_len) {
+			return index;
+		}
+	} else {
+		for (usize i = 0; i < m_len; ++i) {
+			if (begin()[i] == value) {
+				return i;
+			}
+		}
+	}
+	return nullopt;
+}
+
+template <typename Element, usize Count>
+bool Array<Element, Count>::operator==(const Array& other) const {
+	if (m_len != other.m_len) {
+		return false;
+	}
+
+	// Padding or values like -0.0 and NaN make bytes a poor stand in for ==, which this trait rules out.
+	if constexpr (std::has_unique_object_representations_v<Element>) {
+		return m_len == 0 || core::compare(begin(), other.begin(), m_len * sizeof(Element)) == 0;
+	} else {
+		for (usize i = 0; i < m_len; ++i) {
+			if (!(begin()[i] == other.begin()[i])) {
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
 template <typename Element, usize Count>
 Element Array<Element, Count>::remove(usize index) {
 	OP_ASSERT(is_valid_index(index), "Index out of bounds");
 
-	Element result = op::move(begin()[index]);
-	void* clear = &begin()[index];
-	core::set(clear, 0, sizeof(Element));
+	auto* src = begin() + index;
+	Element result = op::move(*src);
+	src->~Element();
 	if (index < m_len - 1) {
-		auto* src = begin() + index;
-		op::core::move(src, src + 1, (len() - index) * sizeof(Element));
+		core::move(src, src + 1, (m_len - index - 1) * sizeof(Element));
 	}
 	m_len -= 1;
 	return result;
@@ -158,17 +240,22 @@ template <typename Element, usize Count>
 OP_ALWAYS_INLINE Option<Element> Array<Element, Count>::pop() {
 	if (m_len > 0) {
 		m_len -= 1;
-		return op::move(begin()[m_len]);
+		auto& last = begin()[m_len];
+		Option<Element> result = op::move(last);
+		last.~Element();
+		return result;
 	}
 	return nullptr;
 }
 
 template <typename Element, usize Count>
 void Array<Element, Count>::reset() {
-	const i32 count = static_cast<i32>(len());
-	for (i32 i = count - 1; i >= 0; i -= 1) {
-		remove(static_cast<usize>(i));
+	if constexpr (!std::is_trivially_destructible_v<Element>) {
+		for (usize i = 0; i < m_len; ++i) {
+			begin()[i].~Element();
+		}
 	}
+	m_len = 0;
 }
 
 OP_CORE_NAMESPACE_END
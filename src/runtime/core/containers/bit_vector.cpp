@@ -0,0 +1,61 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#include "core/containers/bit_vector.h"
+
+OP_CORE_NAMESPACE_BEGIN
+
+AtomicBitVector::AtomicBitVector(usize len) : m_len(len) {
+	const auto count = hidden::word_count(len);
+	m_words.reserve(count);
+	for (usize index = 0; index < count; ++index) {
+		m_words.push(Atomic<u64>(0));
+	}
+}
+
+bool AtomicBitVector::set(usize index) const {
+	OP_ASSERT(index < m_len, "Index out of bounds");
+	const auto mask = hidden::bit_mask(index);
+	return (m_words[index / hidden::bits_per_word].fetch_or(mask, Order::AcqRel) & mask) == 0;
+}
+
+bool AtomicBitVector::unset(usize index) const {
+	OP_ASSERT(index < m_len, "Index out of bounds");
+	const auto mask = hidden::bit_mask(index);
+	return (m_words[index / hidden::bits_per_word].fetch_and(~mask, Order::AcqRel) & mask) != 0;
+}
+
+bool AtomicBitVector::is_set(usize index) const {
+	OP_ASSERT(index < m_len, "Index out of bounds");
+	return (m_words[index / hidden::bits_per_word].load(Order::Acquire) & hidden::bit_mask(index)) != 0;
+}
+
+Option<usize> AtomicBitVector::claim_first_unset() const {
+	for (usize word_index = 0; word_index < m_words.len(); ++word_index) {
+		// Bits past len in the last word count as set so they are never handed out.
+		const auto tail_bits = m_len - word_index * hidden::bits_per_word;
+		const auto outside = tail_bits >= hidden::bits_per_word ? 0 : ~u64(0) << tail_bits;
+
+		const auto& word = m_words[word_index];
+		auto current = word.load(Order::Relaxed) | outside;
+		while (current != ~u64(0)) {
+			const auto mask = u64(1) << count_trailing_zeros(~current);
+			const auto previous = word.fetch_or(mask, Order::AcqRel);
+			if ((previous & mask) == 0) {
+				return word_index * hidden::bits_per_word + count_trailing_zeros(mask);
+			}
+			// Another thread took the bit first. Try the next free one in the same word.
+			current = previous | outside;
+		}
+	}
+	return nullopt;
+}
+
+usize AtomicBitVector::count() const {
+	usize result = 0;
+	for (const auto& word : m_words) {
+		result += count_ones(word.load(Order::Relaxed));
+	}
+	return result;
+}
+
+OP_CORE_NAMESPACE_END
@@ -0,0 +1,127 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#pragma once
+
+#include "core/atomic.h"
+#include "core/containers/bitset.h"
+#include "core/containers/vector.h"
+
+OP_CORE_NAMESPACE_BEGIN
+
+/**
+ * A growable set of bits stored in 64 bit words.
+ *
+ * Bits past the last word are treated as unset, so setting a bit grows the storage as needed and two vectors with
+ * different word counts can still be combined and compared. Set operations work a whole word at a time.
+ *
+ * @tparam A The allocator the words are stored in.
+ */
+template <Allocator A = GlobalAllocator>
+class BitVector {
+public:
+	BitVector() = default;
+	explicit BitVector(A allocator) : m_words(allocator) {}
+
+	// Makes room for bits up to but not including len without allocating.
+	void reserve(usize len);
+
+	void set(usize index);
+	void unset(usize index);
+	OP_NO_DISCARD OP_ALWAYS_INLINE bool is_set(usize index) const {
+		return (word(index / hidden::bits_per_word) & hidden::bit_mask(index)) != 0;
+	}
+
+	// Unsets every bit but keeps the storage.
+	void reset();
+
+	// Number of set bits.
+	OP_NO_DISCARD OP_ALWAYS_INLINE usize count() const {
+		return m_words.is_empty() ? 0 : count_ones(m_words.begin(), m_words.len() * sizeof(u64));
+	}
+	OP_NO_DISCARD bool is_empty() const;
+
+	// True if every bit set in other is also set in this.
+	template <Allocator B>
+	OP_NO_DISCARD bool contains_all(const BitVector<B>& other) const;
+	// True if at least one bit is set in both.
+	template <Allocator B>
+	OP_NO_DISCARD bool intersects(const BitVector<B>& other) const;
+
+	OP_NO_DISCARD OP_ALWAYS_INLINE Option<usize> first_set() const { return next_set(0); }
+	// Lowest set bit at or after from.
+	OP_NO_DISCARD OP_ALWAYS_INLINE Option<usize> next_set(usize from) const {
+		return hidden::next_set_bit(words(), from);
+	}
+
+	// Calls callable with the index of every set bit in ascending order.
+	template <typename Callable>
+	void for_each_set(Callable&& callable) const;
+
+	template <Allocator B>
+	BitVector& operator&=(const BitVector<B>& other);
+	template <Allocator B>
+	BitVector& operator|=(const BitVector<B>& other);
+	// Unsets every bit that is set in other.
+	template <Allocator B>
+	BitVector& and_not(const BitVector<B>& other);
+
+	// Equal when the same bits are set, regardless of how many words either one stores.
+	template <Allocator B>
+	OP_NO_DISCARD bool operator==(const BitVector<B>& other) const;
+	template <Allocator B>
+	OP_NO_DISCARD OP_ALWAYS_INLINE bool operator!=(const BitVector<B>& other) const {
+		return !(*this == other);
+	}
+
+	// The words holding the bits. Bit i is bit i % 64 of word i / 64.
+	OP_NO_DISCARD OP_ALWAYS_INLINE Slice<u64 const> words() const { return m_words; }
+
+private:
+	template <Allocator B>
+	friend class BitVector;
+
+	OP_ALWAYS_INLINE u64 word(usize index) const { return index < m_words.len() ? m_words[index] : 0; }
+
+	Vector<u64, A> m_words;
+};
+
+/**
+ * A fixed size set of bits that many threads can set and unset at once.
+ *
+ * Every operation is a single atomic read-modify-write on the word holding the bit. claim_first_unset scans for a word
+ * with a free bit and takes it with fetch_or, so allocators can hand out slots without a lock.
+ */
+class AtomicBitVector {
+public:
+	AtomicBitVector() = default;
+	explicit AtomicBitVector(usize len);
+
+	OP_NO_DISCARD OP_ALWAYS_INLINE usize len() const { return m_len; }
+
+	// Sets the bit. Returns true if this call changed it, false if it was already set.
+	bool set(usize index) const;
+	// Unsets the bit. Returns true if this call changed it, false if it was already unset.
+	bool unset(usize index) const;
+	OP_NO_DISCARD bool is_set(usize index) const;
+
+	// Finds an unset bit and sets it. Returns its index, or nullopt if every bit was set during the scan.
+	OP_NO_DISCARD Option<usize> claim_first_unset() const;
+
+	// Number of set bits at the time each word was read.
+	OP_NO_DISCARD usize count() const;
+
+private:
+	Vector<Atomic<u64>> m_words;
+	usize m_len = 0;
+};
+
+OP_CORE_NAMESPACE_END
+
+// Include the implementation
+#include "core/containers/bit_vector.inl"
+
+// Export to op namespace
+OP_NAMESPACE_BEGIN
+using core::AtomicBitVector;
+using core::BitVector;
+OP_NAMESPACE_END
@@ -0,0 +1,116 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+OP_CORE_NAMESPACE_BEGIN
+
+template <Allocator A>
+void BitVector<A>::reserve(usize len) {
+	const auto needed = hidden::word_count(len);
+	if (needed > m_words.len()) {
+		m_words.resize(needed);
+	}
+}
+
+template <Allocator A>
+void BitVector<A>::set(usize index) {
+	reserve(index + 1);
+	m_words[index / hidden::bits_per_word] |= hidden::bit_mask(index);
+}
+
+template <Allocator A>
+void BitVector<A>::unset(usize index) {
+	const auto word_index = index / hidden::bits_per_word;
+	if (word_index < m_words.len()) {
+		m_words[word_index] &= ~hidden::bit_mask(index);
+	}
+}
+
+template <Allocator A>
+void BitVector<A>::reset() {
+	if (!m_words.is_empty()) {
+		core::set(m_words.begin(), 0, m_words.len() * sizeof(u64));
+	}
+}
+
+template <Allocator A>
+bool BitVector<A>::is_empty() const {
+	return m_words.is_empty() || find_first_set(m_words.begin(), m_words.len()) == m_words.len() * hidden::bits_per_word;
+}
+
+template <Allocator A>
+template <Allocator B>
+bool BitVector<A>::contains_all(const BitVector<B>& other) const {
+	u64 missing = 0;
+	for (usize index = 0; index < other.m_words.len(); ++index) {
+		missing |= other.m_words[index] & ~word(index);
+	}
+	return missing == 0;
+}
+
+template <Allocator A>
+template <Allocator B>
+bool BitVector<A>::intersects(const BitVector<B>& other) const {
+	const auto len = m_words.len() < other.m_words.len() ? m_words.len() : other.m_words.len();
+	u64 shared = 0;
+	for (usize index = 0; index < len; ++index) {
+		shared |= m_words[index] & other.m_words[index];
+	}
+	return shared != 0;
+}
+
+template <Allocator A>
+template <typename Callable>
+void BitVector<A>::for_each_set(Callable&& callable) const {
+	for (usize index = 0; index < m_words.len(); ++index) {
+		auto bits = m_words[index];
+		while (bits != 0) {
+			callable(index * hidden::bits_per_word + count_trailing_zeros(bits));
+			// Clears the lowest set bit.
+			bits &= bits - 1;
+		}
+	}
+}
+
+template <Allocator A>
+template <Allocator B>
+BitVector<A>& BitVector<A>::operator&=(const BitVector<B>& other) {
+	for (usize index = 0; index < m_words.len(); ++index) {
+		m_words[index] &= other.word(index);
+	}
+	return *this;
+}
+
+template <Allocator A>
+template <Allocator B>
+BitVector<A>& BitVector<A>::operator|=(const BitVector<B>& other) {
+	if (other.m_words.len() > m_words.len()) {
+		m_words.resize(other.m_words.len());
+	}
+	for (usize index = 0; index < other.m_words.len(); ++index) {
+		m_words[index] |= other.m_words[index];
+	}
+	return *this;
+}
+
+template <Allocator A>
+template <Allocator B>
+BitVector<A>& BitVector<A>::and_not(const BitVector<B>& other) {
+	const auto len = m_words.len() < other.m_words.len() ? m_words.len() : other.m_words.len();
+	for (usize index = 0; index < len; ++index) {
+		m_words[index] &= ~other.m_words[index];
+	}
+	return *this;
+}
+
+template <Allocator A>
+template <Allocator B>
+bool BitVector<A>::operator==(const BitVector<B>& other) const {
+	const auto len = m_words.len() > other.m_words.len() ? m_words.len() : other.m_words.len();
+	for (usize index = 0; index < len; ++index) {
+		if (word(index) != other.word(index)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+OP_CORE_NAMESPACE_END
@@ -0,0 +1,204 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#pragma once
+
+#include "core/containers/option.h"
+#include "core/containers/slice.h"
+#include "core/os/memory.h"
+
+OP_CORE_NAMESPACE_BEGIN
+
+OP_HIDDEN_NAMESPACE_BEGIN
+
+inline constexpr usize bits_per_word = 64;
+
+OP_ALWAYS_INLINE constexpr usize word_count(usize bits) { return (bits + bits_per_word - 1) / bits_per_word; }
+OP_ALWAYS_INLINE constexpr u64 bit_mask(usize index) { return u64(1) << (index % bits_per_word); }
+
+// Lowest set bit at or after from in words, or nullopt.
+inline Option<usize> next_set_bit(Slice<u64 const> words, usize from) {
+	auto word_index = from / bits_per_word;
+	if (word_index >= words.len()) {
+		return nullopt;
+	}
+
+	// Mask off the bits below from in the first word, then let find_first_set skip the empty words after it.
+	const auto first = words[word_index] & (~u64(0) << (from % bits_per_word));
+	if (first != 0) {
+		return word_index * bits_per_word + count_trailing_zeros(first);
+	}
+
+	word_index += 1;
+	const auto remaining = words.len() - word_index;
+	if (remaining == 0) {
+		return nullopt;
+	}
+	const auto found = find_first_set(words.begin() + word_index, remaining);
+	if (found == remaining * bits_per_word) {
+		return nullopt;
+	}
+	return word_index * bits_per_word + found;
+}
+
+OP_HIDDEN_NAMESPACE_END
+
+/**
+ * A fixed size set of bits stored inline in 64 bit words.
+ *
+ * Set operations work a whole word at a time, and iteration jumps from one set bit to the next with count trailing
+ * zeros. Bitset is trivially copyable and usable in constant expressions.
+ *
+ * @tparam N The number of bits.
+ */
+template <usize N>
+class Bitset {
+	static_assert(N > 0, "Bitset needs at least one bit");
+
+public:
+	static constexpr usize word_count = hidden::word_count(N);
+
+	constexpr Bitset() = default;
+
+	OP_NO_DISCARD OP_ALWAYS_INLINE static constexpr usize len() { return N; }
+
+	OP_ALWAYS_INLINE constexpr void set(usize index) {
+		OP_ASSERT(index < N, "Index out of bounds");
+		m_words[index / hidden::bits_per_word] |= hidden::bit_mask(index);
+	}
+	OP_ALWAYS_INLINE constexpr void unset(usize index) {
+		OP_ASSERT(index < N, "Index out of bounds");
+		m_words[index / hidden::bits_per_word] &= ~hidden::bit_mask(index);
+	}
+	OP_NO_DISCARD OP_ALWAYS_INLINE constexpr bool is_set(usize index) const {
+		OP_ASSERT(index < N, "Index out of bounds");
+		return (m_words[index / hidden::bits_per_word] & hidden::bit_mask(index)) != 0;
+	}
+
+	// Sets every bit.
+	constexpr void set_all() {
+		for (auto& word : m_words) {
+			word = ~u64(0);
+		}
+		m_words[word_count - 1] &= tail_mask();
+	}
+	// Unsets every bit.
+	constexpr void reset() {
+		for (auto& word : m_words) {
+			word = 0;
+		}
+	}
+
+	// Number of set bits.
+	OP_NO_DISCARD OP_ALWAYS_INLINE usize count() const { return count_ones(m_words, sizeof(m_words)); }
+
+	OP_NO_DISCARD constexpr bool is_empty() const {
+		u64 any = 0;
+		for (auto word : m_words) {
+			any |= word;
+		}
+		return any == 0;
+	}
+
+	// True if every bit set in other is also set in this.
+	OP_NO_DISCARD constexpr bool contains_all(const Bitset& other) const {
+		u64 missing = 0;
+		for (usize index = 0; index < word_count; ++index) {
+			missing |= other.m_words[index] & ~m_words[index];
+		}
+		return missing == 0;
+	}
+
+	// True if at least one bit is set in both.
+	OP_NO_DISCARD constexpr bool intersects(const Bitset& other) const {
+		u64 shared = 0;
+		for (usize index = 0; index < word_count; ++index) {
+			shared |= other.m_words[index] & m_words[index];
+		}
+		return shared != 0;
+	}
+
+	OP_NO_DISCARD OP_ALWAYS_INLINE Option<usize> first_set() const { return next_set(0); }
+	// Lowest set bit at or after from.
+	OP_NO_DISCARD OP_ALWAYS_INLINE Option<usize> next_set(usize from) const {
+		return hidden::next_set_bit(words(), from);
+	}
+
+	// Calls callable with the index of every set bit in ascending order.
+	template <typename Callable>
+	void for_each_set(Callable&& callable) const {
+		for (usize index = 0; index < word_count; ++index) {
+			auto word = m_words[index];
+			while (word != 0) {
+				callable(index * hidden::bits_per_word + count_trailing_zeros(word));
+				// Clears the lowest set bit.
+				word &= word - 1;
+			}
+		}
+	}
+
+	constexpr Bitset& operator&=(const Bitset& other) {
+		for (usize index = 0; index < word_count; ++index) {
+			m_words[index] &= other.m_words[index];
+		}
+		return *this;
+	}
+	constexpr Bitset& operator|=(const Bitset& other) {
+		for (usize index = 0; index < word_count; ++index) {
+			m_words[index] |= other.m_words[index];
+		}
+		return *this;
+	}
+	constexpr Bitset& operator^=(const Bitset& other) {
+		for (usize index = 0; index < word_count; ++index) {
+			m_words[index] ^= other.m_words[index];
+		}
+		return *this;
+	}
+	// Unsets every bit that is set in other.
+	constexpr Bitset& and_not(const Bitset& other) {
+		for (usize index = 0; index < word_count; ++index) {
+			m_words[index] &= ~other.m_words[index];
+		}
+		return *this;
+	}
+
+	OP_NO_DISCARD constexpr Bitset operator&(const Bitset& other) const { return Bitset(*this) &= other; }
+	OP_NO_DISCARD constexpr Bitset operator|(const Bitset& other) const { return Bitset(*this) |= other; }
+	OP_NO_DISCARD constexpr Bitset operator^(const Bitset& other) const { return Bitset(*this) ^= other; }
+	OP_NO_DISCARD constexpr Bitset operator~() const {
+		Bitset result;
+		for (usize index = 0; index < word_count; ++index) {
+			result.m_words[index] = ~m_words[index];
+		}
+		result.m_words[word_count - 1] &= tail_mask();
+		return result;
+	}
+
+	OP_NO_DISCARD constexpr bool operator==(const Bitset& other) const {
+		for (usize index = 0; index < word_count; ++index) {
+			if (m_words[index] != other.m_words[index]) {
+				return false;
+			}
+		}
+		return true;
+	}
+	OP_NO_DISCARD OP_ALWAYS_INLINE constexpr bool operator!=(const Bitset& other) const { return !(*this == other); }
+
+	// The words holding the bits. Bit i is bit i % 64 of word i / 64. Bits past N are always zero.
+	OP_NO_DISCARD OP_ALWAYS_INLINE Slice<u64 const> words() const { return Slice<u64 const>(m_words, word_count); }
+
+private:
+	// Bits of the last word that are part of the set.
+	OP_ALWAYS_INLINE static constexpr u64 tail_mask() {
+		return N % hidden::bits_per_word == 0 ? ~u64(0) : (u64(1) << (N % hidden::bits_per_word)) - 1;
+	}
+
+	u64 m_words[word_count] = {};
+};
+
+OP_CORE_NAMESPACE_END
+
+// Export to op namespace
+OP_NAMESPACE_BEGIN
+using core::Bitset;
+OP_NAMESPACE_END
@@ -0,0 +1,135 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#pragma once
+
+#include "core/atomic.h"
+#include "core/concepts.h"
+#include "core/containers/option.h"
+
+OP_CORE_NAMESPACE_BEGIN
+
+/**
+ * A slot map that many threads may insert into, remove from and look up in at the same time without a lock.
+ *
+ * Slots live in fixed size pages that are never moved or freed before the map, so a slot can always be read. Every slot
+ * has an atomic version that is odd while it holds a value. Lookups compare it against the version stored in the key,
+ * and removal bumps it with a compare exchange so exactly one thread wins. Freed slots go on a lock free stack whose
+ * head carries a tag that changes on every update, so a pop can not be fooled by the same slot being popped and pushed
+ * back in between (the ABA problem).
+ *
+ * A reference returned by get stays valid until its key is removed. Removing a key while another thread still uses its
+ * value is a race the caller has to rule out, the same as with any owner handing out references.
+ *
+ * @tparam T The type of element to store in the slot map.
+ * @tparam PageLen The number of slots per page. Must be a power of two.
+ * @tparam MaxPages The number of pages the map can grow to. The page table is stored inline.
+ */
+template <Movable T, usize PageLen = 1024, usize MaxPages = 1024>
+class ConcurrentSlotMap {
+	static_assert(PageLen > 0 && (PageLen & (PageLen - 1)) == 0, "PageLen must be a power of two");
+	static_assert(PageLen * MaxPages < static_cast<usize>(~u32(0)), "Slot indices must fit in a u32");
+
+public:
+	class Key {
+	public:
+		explicit Key(u32 index, u32 version) : m_index(index), m_version(version) {}
+
+		OP_ALWAYS_INLINE bool operator==(const Key& other) const {
+			return m_index == other.m_index && m_version == other.m_version;
+		}
+		OP_ALWAYS_INLINE bool operator!=(const Key& other) const { return !(*this == other); }
+
+		OP_NO_DISCARD OP_ALWAYS_INLINE u32 index() const { return m_index; }
+		OP_NO_DISCARD OP_ALWAYS_INLINE u32 version() const { return m_version; }
+
+	private:
+		friend class ConcurrentSlotMap<T, PageLen, MaxPages>;
+
+		u32 m_index;
+		u32 m_version;
+	};
+
+	static constexpr usize max_len = PageLen * MaxPages;
+
+	ConcurrentSlotMap();
+
+	ConcurrentSlotMap(const ConcurrentSlotMap& copy) = delete;
+	ConcurrentSlotMap& operator=(const ConcurrentSlotMap& copy) = delete;
+	// Moving is not thread safe. No other thread may use either map.
+	ConcurrentSlotMap(ConcurrentSlotMap&& move) noexcept;
+	ConcurrentSlotMap& operator=(ConcurrentSlotMap&& move) noexcept;
+
+	~ConcurrentSlotMap();
+
+	OP_NO_DISCARD Key insert(T&& value);
+
+	OP_NO_DISCARD Option<T&> get(const Key& key);
+
+	OP_NO_DISCARD Option<T const&> get(const Key& key) const;
+
+	OP_NO_DISCARD bool contains(const Key& key) const;
+
+	Option<T> remove(const Key& key);
+
+	// Number of values at the time of the call. Other threads may change it right after.
+	OP_NO_DISCARD OP_ALWAYS_INLINE usize len() const { return m_len.load(Order::Relaxed); }
+	OP_NO_DISCARD OP_ALWAYS_INLINE bool is_empty() const { return len() == 0; }
+
+	/**
+	 * Calls callable with the key and value of every occupied slot in index order. Values inserted during the walk may or
+	 * may not be visited. No other thread may remove while it runs.
+	 */
+	template <typename Callable>
+	void for_each(Callable&& callable);
+	template <typename Callable>
+	void for_each(Callable&& callable) const;
+
+	// Bytes allocated for pages. Does not include memory owned by the values.
+	OP_NO_DISCARD usize allocated_bytes() const;
+
+private:
+	struct Slot {
+		// Odd while the slot holds a value.
+		Atomic<u32> version;
+		// Next index on the free stack while the slot is free.
+		Atomic<u32> next_free;
+		alignas(T) u8 storage[sizeof(T)];
+
+		OP_ALWAYS_INLINE T& value() { return *reinterpret_cast<T*>(storage); }
+		OP_ALWAYS_INLINE T const& value() const { return *reinterpret_cast<T const*>(storage); }
+	};
+
+	static constexpr u32 invalid_index = ~u32(0);
+
+	// The slot a key refers to if it currently holds the key's value.
+	Slot* find(const Key& key) const;
+	OP_ALWAYS_INLINE Slot& slot(u32 index) const {
+		auto* page = m_pages[index / PageLen].load(Order::Acquire);
+		OP_ASSERT(page != nullptr, "Slot has not been allocated");
+		return page[index % PageLen];
+	}
+	// Allocates the page holding index unless another thread already did.
+	void ensure_page(u32 index);
+
+	void push_free(u32 index);
+	u32 pop_free();
+
+	void destroy();
+
+	Atomic<Slot*> m_pages[MaxPages];
+	// Tag in the upper 32 bits, index of the top slot in the lower 32 bits.
+	Atomic<u64> m_free_head = invalid_index;
+	// Slots below this index have been handed out at least once.
+	Atomic<u32> m_next_index = 0;
+	Atomic<usize> m_len = 0;
+};
+
+OP_CORE_NAMESPACE_END
+
+// Include the implementation
+#include "core/containers/concurrent_slot_map.inl"
+
+// Export to op namespace
+OP_NAMESPACE_BEGIN
+using core::ConcurrentSlotMap;
+OP_NAMESPACE_END
@@ -0,0 +1,258 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#include "core/os/memory.h"
+
+OP_CORE_NAMESPACE_BEGIN
+
+template <Movable T, usize PageLen, usize MaxPages>
+ConcurrentSlotMap<T, PageLen, MaxPages>::ConcurrentSlotMap() {
+	for (auto& page : m_pages) {
+		page.store(nullptr, Order::Relaxed);
+	}
+}
+
+template <Movable T, usize PageLen, usize MaxPages>
+ConcurrentSlotMap<T, PageLen, MaxPages>::ConcurrentSlotMap(ConcurrentSlotMap&& move) noexcept
+	: m_free_head(move.m_free_head.load(Order::Relaxed))
+	, m_next_index(move.m_next_index.load(Order::Relaxed))
+	, m_len(move.m_len.load(Order::Relaxed)) {
+	for (usize index = 0; index < MaxPages; ++index) {
+		m_pages[index].store(move.m_pages[index].exchange(nullptr, Order::Relaxed), Order::Relaxed);
+	}
+	move.m_free_head.store(invalid_index, Order::Relaxed);
+	move.m_next_index.store(0, Order::Relaxed);
+	move.m_len.store(0, Order::Relaxed);
+}
+
+template <Movable T, usize PageLen, usize MaxPages>
+ConcurrentSlotMap<T, PageLen, MaxPages>&
+ConcurrentSlotMap<T, PageLen, MaxPages>::operator=(ConcurrentSlotMap&& move) noexcept {
+	if (this != &move) {
+		destroy();
+
+		for (usize index = 0; index < MaxPages; ++index) {
+			m_pages[index].store(move.m_pages[index].exchange(nullptr, Order::Relaxed), Order::Relaxed);
+		}
+		m_free_head.store(move.m_free_head.exchange(invalid_index, Order::Relaxed), Order::Relaxed);
+		m_next_index.store(move.m_next_index.exchange(0, Order::Relaxed), Order::Relaxed);
+		m_len.store(move.m_len.exchange(0, Order::Relaxed), Order::Relaxed);
+	}
+	return *this;
+}
+
+template <Movable T, usize PageLen, usize MaxPages>
+ConcurrentSlotMap<T, PageLen, MaxPages>::~ConcurrentSlotMap() {
+	destroy();
+}
+
+template <Movable T, usize PageLen, usize MaxPages>
+ConcurrentSlotMap<T, PageLen, MaxPages>::Key ConcurrentSlotMap<T, PageLen, MaxPages>::insert(T&& value) {
+	auto index = pop_free();
+	if (index == invalid_index) {
+		index = m_next_index.fetch_add(1, Order::Relaxed);
+		OP_ASSERT(index < max_len, "ConcurrentSlotMap is full");
+		ensure_page(index);
+	}
+
+	auto& result = slot(index);
+	new (result.storage) T(op::move(value));
+
+	// Nobody else can touch a slot while it is off the free stack and even, so a plain increment is enough. The release
+	// store publishes the value to lookups that acquire the version.
+	const auto version = result.version.load(Order::Relaxed) + 1;
+	result.version.store(version, Order::Release);
+
+	auto len = m_len.fetch_add(1, Order::Relaxed);
+	OP_UNUSED(len);
+	return Key(index, version);
+}
+
+template <Movable T, usize PageLen, usize MaxPages>
+Option<T&> ConcurrentSlotMap<T, PageLen, MaxPages>::get(const Key& key) {
+	auto* found = find(key);
+	if (found != nullptr) {
+		return found->value();
+	}
+	return nullopt;
+}
+
+template <Movable T, usize PageLen, usize MaxPages>
+Option<T const&> ConcurrentSlotMap<T, PageLen, MaxPages>::get(const Key& key) const {
+	auto* found = find(key);
+	if (found != nullptr) {
+		return found->value();
+	}
+	return nullopt;
+}
+
+template <Movable T, usize PageLen, usize MaxPages>
+bool ConcurrentSlotMap<T, PageLen, MaxPages>::contains(const Key& key) const {
+	return find(key) != nullptr;
+}
+
+template <Movable T, usize PageLen, usize MaxPages>
+Option<T> ConcurrentSlotMap<T, PageLen, MaxPages>::remove(const Key& key) {
+	auto* found = find(key);
+	if (found == nullptr) {
+		return nullopt;
+	}
+
+	// Only the thread that moves the version on owns the value. Everyone else sees a stale key.
+	auto exchanged = found->version.compare_exchange_strong(key.m_version, key.m_version + 1, Order::AcqRel);
+	if (!exchanged) {
+		return nullopt;
+	}
+
+	Option<T> result = op::move(found->value());
+	found->value().~T();
+
+	auto len = m_len.fetch_sub(1, Order::Relaxed);
+	OP_UNUSED(len);
+	push_free(key.m_index);
+	return result;
+}
+
+template <Movable T, usize PageLen, usize MaxPages>
+template <typename Callable>
+void ConcurrentSlotMap<T, PageLen, MaxPages>::for_each(Callable&& callable) {
+	const auto count = m_next_index.load(Order::Relaxed);
+	for (u32 index = 0; index < count; ++index) {
+		auto* page = m_pages[index / PageLen].load(Order::Acquire);
+		if (page == nullptr) {
+			continue;
+		}
+		auto& current = page[index % PageLen];
+		const auto version = current.version.load(Order::Acquire);
+		if ((version & 1) != 0) {
+			callable(Key(index, version), current.value());
+		}
+	}
+}
+
+template <Movable T, usize PageLen, usize MaxPages>
+template <typename Callable>
+void ConcurrentSlotMap<T, PageLen, MaxPages>::for_each(Callable&& callable) const {
+	const auto count = m_next_index.load(Order::Relaxed);
+	for (u32 index = 0; index < count; ++index) {
+		auto* page = m_pages[index / PageLen].load(Order::Acquire);
+		if (page == nullptr) {
+			continue;
+		}
+		auto const& current = page[index % PageLen];
+		const auto version = current.version.load(Order::Acquire);
+		if ((version & 1) != 0) {
+			callable(Key(index, version), current.value());
+		}
+	}
+}
+
+template <Movable T, usize PageLen, usize MaxPages>
+usize ConcurrentSlotMap<T, PageLen, MaxPages>::allocated_bytes() const {
+	usize result = 0;
+	for (auto& page : m_pages) {
+		if (page.load(Order::Relaxed) != nullptr) {
+			result += PageLen * sizeof(Slot);
+		}
+	}
+	return result;
+}
+
+template <Movable T, usize PageLen, usize MaxPages>
+ConcurrentSlotMap<T, PageLen, MaxPages>::Slot* ConcurrentSlotMap<T, PageLen, MaxPages>::find(const Key& key) const {
+	// Even versions belong to free slots and never match a value.
+	if ((key.m_version & 1) == 0 || key.m_index >= max_len) {
+		return nullptr;
+	}
+
+	auto* page = m_pages[key.m_index / PageLen].load(Order::Acquire);
+	if (page == nullptr) {
+		return nullptr;
+	}
+
+	auto& result = page[key.m_index % PageLen];
+	if (result.version.load(Order::Acquire) != key.m_version) {
+		return nullptr;
+	}
+	return &result;
+}
+
+template <Movable T, usize PageLen, usize MaxPages>
+void ConcurrentSlotMap<T, PageLen, MaxPages>::ensure_page(u32 index) {
+	auto& entry = m_pages[index / PageLen];
+	if (entry.load(Order::Acquire) != nullptr) {
+		return;
+	}
+
+	void* ptr = core::malloc(core::Layout::array<Slot>(PageLen));
+	auto* page = static_cast<Slot*>(ptr);
+	for (usize slot_index = 0; slot_index < PageLen; ++slot_index) {
+		new (&page[slot_index].version) Atomic<u32>(0);
+		new (&page[slot_index].next_free) Atomic<u32>(invalid_index);
+	}
+
+	// Several threads can reach a new page at once. The first to publish wins and the others give their page back.
+	if (!entry.compare_exchange_strong(nullptr, page, Order::AcqRel)) {
+		core::free(page);
+	}
+}
+
+template <Movable T, usize PageLen, usize MaxPages>
+void ConcurrentSlotMap<T, PageLen, MaxPages>::push_free(u32 index) {
+	auto& pushed = slot(index);
+	auto head = m_free_head.load(Order::Relaxed);
+	while (true) {
+		pushed.next_free.store(static_cast<u32>(head), Order::Relaxed);
+
+		const auto tag = (head >> 32) + 1;
+		const auto desired = (tag << 32) | index;
+		if (m_free_head.compare_exchange_weak(head, desired, Order::Release)) {
+			return;
+		}
+		head = m_free_head.load(Order::Relaxed);
+	}
+}
+
+template <Movable T, usize PageLen, usize MaxPages>
+u32 ConcurrentSlotMap<T, PageLen, MaxPages>::pop_free() {
+	auto head = m_free_head.load(Order::Acquire);
+	while (static_cast<u32>(head) != invalid_index) {
+		const auto index = static_cast<u32>(head);
+		// The slot may be popped by another thread before this read, in which case the tag makes the exchange fail.
+		const auto next = slot(index).next_free.load(Order::Relaxed);
+
+		const auto tag = (head >> 32) + 1;
+		const auto desired = (tag << 32) | next;
+		if (m_free_head.compare_exchange_weak(head, desired, Order::Acquire)) {
+			return index;
+		}
+		head = m_free_head.load(Order::Acquire);
+	}
+	return invalid_index;
+}
+
+template <Movable T, usize PageLen, usize MaxPages>
+void ConcurrentSlotMap<T, PageLen, MaxPages>::destroy() {
+	const auto count = m_next_index.load(Order::Relaxed);
+	for (usize page_index = 0; page_index < MaxPages; ++page_index) {
+		auto* page = m_pages[page_index].load(Order::Relaxed);
+		if (page == nullptr) {
+			continue;
+		}
+
+		if constexpr (!std::is_trivially_destructible_v<T>) {
+			for (usize slot_index = 0; slot_index < PageLen && page_index * PageLen + slot_index < count; ++slot_index) {
+				if ((page[slot_index].version.load(Order::Relaxed) & 1) != 0) {
+					page[slot_index].value().~T();
+				}
+			}
+		}
+		core::free(page);
+		m_pages[page_index].store(nullptr, Order::Relaxed);
+	}
+
+	m_free_head.store(invalid_index, Order::Relaxed);
+	m_next_index.store(0, Order::Relaxed);
+	m_len.store(0, Order::Relaxed);
+}
+
+OP_CORE_NAMESPACE_END
@@ -56,6 +56,7 @@ public:
 	Function(Functor&& f) : Super(op::forward<Functor>(f)) {}
 
 	Function(Function&& move) noexcept = default;
+	Function& operator=(Function&& move) noexcept = default;
 
 	~Function() = default;
 };
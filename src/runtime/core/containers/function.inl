@@ -1,6 +1,11 @@
 // Copyright Colby Hall. All Rights Reserved.
 
 #include "core/os/memory.h"
+#include "core/slab.h"
+
+OP_SUPPRESS_WARNINGS_STD_BEGIN
+#include <functional>
+OP_SUPPRESS_WARNINGS_STD_END
 
 OP_CORE_NAMESPACE_BEGIN
 OP_HIDDEN_NAMESPACE_BEGIN
@@ -53,6 +58,7 @@ public:
 		other.m_callable = nullptr;
 
 		m_storage = op::move(other.m_storage);
+		return *this;
 	}
 
 	R operator()(Param... params) const {
@@ -89,6 +95,7 @@ private:
 
 struct IFunctionWrapper {
 	virtual void* ptr() = 0;
+	virtual core::Layout layout() const = 0;
 	virtual ~IFunctionWrapper() = default;
 };
 
@@ -99,6 +106,7 @@ struct FunctionWrapper : public IFunctionWrapper {
 	~FunctionWrapper() override = default;
 
 	void* ptr() override { return &t; }
+	core::Layout layout() const override { return core::Layout::single<FunctionWrapper>; }
 
 	T t;
 };
@@ -114,8 +122,9 @@ struct UniqueStorage {
 	~UniqueStorage() {
 		if (m_ptr) {
 			auto* f = static_cast<IFunctionWrapper*>(m_ptr);
+			const auto layout = f->layout();
 			f->~IFunctionWrapper();
-			core::free(m_ptr);
+			SlabAllocator().free(m_ptr, layout);
 			m_ptr = nullptr;
 		}
 	}
@@ -123,7 +132,7 @@ struct UniqueStorage {
 	// ~IStorage
 	template <typename F>
 	std::remove_reference_t<F>* bind(F&& f) {
-		void* memory = core::malloc(core::Layout::single<FunctionWrapper<F>>);
+		void* memory = SlabAllocator().malloc(core::Layout::single<FunctionWrapper<F>>);
 		auto* result = new (memory) FunctionWrapper<F>(op::forward<F>(f));
 		m_ptr = memory;
 
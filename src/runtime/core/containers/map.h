@@ -2,73 +2,179 @@
 
 #pragma once
 
+#include "core/allocator.h"
 #include "core/containers/function.h"
 #include "core/containers/vector.h"
 #include "core/hash.h"
 #include "core/non_copyable.h"
+#include "core/os/memory.h"
+#include "core/os/memory_tracking.h"
 #include "core/type_traits.h"
 
+#if OP_CPU_X86
+	#include <emmintrin.h>
+#endif
+
 OP_CORE_NAMESPACE_BEGIN
 
-template <typename Key, typename Value, typename Hasher>
+OP_HIDDEN_NAMESPACE_BEGIN
+
+// Control byte for every slot in a Map. Full slots store the low 7 bits of the key's hash so the top bit is only set for
+// empty and deleted slots.
+using MapCtrl = i8;
+inline constexpr MapCtrl map_ctrl_empty = -128;
+inline constexpr MapCtrl map_ctrl_deleted = -2;
+
+/**
+ * A window of control bytes that is matched against in parallel. Bit i of every returned mask refers to the i-th byte
+ * of the window.
+ */
+class MapGroup {
+public:
+	static constexpr usize width = 16;
+
+#if OP_CPU_X86
+	OP_ALWAYS_INLINE explicit MapGroup(MapCtrl const* ctrl)
+		: m_ctrl(_mm_loadu_si128(reinterpret_cast<__m128i const*>(ctrl))) {}
+
+	OP_NO_DISCARD OP_ALWAYS_INLINE u32 match(MapCtrl h2) const {
+		return static_cast<u32>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), m_ctrl)));
+	}
+	OP_NO_DISCARD OP_ALWAYS_INLINE u32 match_empty() const { return match(map_ctrl_empty); }
+	OP_NO_DISCARD OP_ALWAYS_INLINE u32 match_empty_or_deleted() const {
+		return static_cast<u32>(_mm_movemask_epi8(m_ctrl));
+	}
+
+private:
+	__m128i m_ctrl;
+#else
+	OP_ALWAYS_INLINE explicit MapGroup(MapCtrl const* ctrl) {
+		for (usize index = 0; index < width; ++index) {
+			m_ctrl[index] = ctrl[index];
+		}
+	}
+
+	OP_NO_DISCARD OP_ALWAYS_INLINE u32 match(MapCtrl h2) const {
+		u32 result = 0;
+		for (usize index = 0; index < width; ++index) {
+			result |= static_cast<u32>(m_ctrl[index] == h2) << index;
+		}
+		return result;
+	}
+	OP_NO_DISCARD OP_ALWAYS_INLINE u32 match_empty() const { return match(map_ctrl_empty); }
+	OP_NO_DISCARD OP_ALWAYS_INLINE u32 match_empty_or_deleted() const {
+		u32 result = 0;
+		for (usize index = 0; index < width; ++index) {
+			result |= static_cast<u32>(m_ctrl[index] < 0) << index;
+		}
+		return result;
+	}
+
+private:
+	MapCtrl m_ctrl[width];
+#endif
+};
+
+OP_HIDDEN_NAMESPACE_END
+
+template <typename Key, typename Value, Hasher H, Allocator A>
 class Map;
 
-template <typename Key, typename Value, typename Hasher>
+template <typename Key, typename Value, Hasher H, Allocator A>
 class MapIterator {
 public:
-	OP_ALWAYS_INLINE explicit MapIterator(Map<Key, Value, Hasher>& map) : m_map(map) {}
+	OP_ALWAYS_INLINE explicit MapIterator(Map<Key, Value, H, A>& map) : m_map(map) { skip_empty(); }
 
-	OP_ALWAYS_INLINE operator bool() const { return m_index < m_map.m_buckets.len(); }
+	OP_ALWAYS_INLINE operator bool() const { return m_index < m_map.m_cap; }
 	OP_ALWAYS_INLINE MapIterator& operator++() {
 		m_index += 1;
+		skip_empty();
 		return *this;
 	}
-	OP_ALWAYS_INLINE const Key& key() const { return m_map.m_buckets[m_index].key; }
-	OP_ALWAYS_INLINE Value& value() const { return m_map.m_buckets[m_index].value; }
+	OP_ALWAYS_INLINE const Key& key() const { return m_map.m_slots[m_index].key; }
+	OP_ALWAYS_INLINE Value& value() const { return m_map.m_slots[m_index].value; }
 
 private:
+	OP_ALWAYS_INLINE void skip_empty() {
+		while (m_index < m_map.m_cap && m_map.m_ctrl[m_index] < 0) {
+			m_index += 1;
+		}
+	}
+
 	usize m_index = 0;
-	Map<Key, Value, Hasher>& m_map;
+	Map<Key, Value, H, A>& m_map;
 };
 
-template <typename Key, typename Value, typename Hasher>
+template <typename Key, typename Value, Hasher H, Allocator A>
 class ConstMapIterator {
 public:
-	OP_ALWAYS_INLINE explicit ConstMapIterator(const Map<Key, Value, Hasher>& map) : m_map(map) {}
+	OP_ALWAYS_INLINE explicit ConstMapIterator(const Map<Key, Value, H, A>& map) : m_map(map) { skip_empty(); }
 
-	OP_ALWAYS_INLINE operator bool() const { return m_index < m_map.m_buckets.len(); }
+	OP_ALWAYS_INLINE operator bool() const { return m_index < m_map.m_cap; }
 	OP_ALWAYS_INLINE ConstMapIterator& operator++() {
 		m_index += 1;
+		skip_empty();
 		return *this;
 	}
-	OP_ALWAYS_INLINE const Key& key() const { return m_map.m_buckets[m_index].key; }
-	OP_ALWAYS_INLINE const Value& value() const { return m_map.m_buckets[m_index].value; }
+	OP_ALWAYS_INLINE const Key& key() const { return m_map.m_slots[m_index].key; }
+	OP_ALWAYS_INLINE const Value& value() const { return m_map.m_slots[m_index].value; }
 
 private:
+	OP_ALWAYS_INLINE void skip_empty() {
+		while (m_index < m_map.m_cap && m_map.m_ctrl[m_index] < 0) {
+			m_index += 1;
+		}
+	}
+
 	usize m_index = 0;
-	const Map<Key, Value, Hasher>& m_map;
+	const Map<Key, Value, H, A>& m_map;
 };
 
-template <typename Key, typename Value, typename Hasher = FNV1Hasher>
+/**
+ * An open addressing hash map in the style of SwissTable.
+ *
+ * Every slot has a control byte holding 7 bits of the key's hash, or a marker for empty and deleted slots. Lookups probe
+ * a group of 16 control bytes at a time and only compare keys whose hash bits match, so most misses never touch the
+ * slots at all. Insert and remove are amortized O(1).
+ *
+ * Removal only leaves a tombstone when the slot's group was full, as a probe may have passed over it. Otherwise the slot
+ * goes straight back to empty. Tombstones count against the load factor and are dropped whenever the table is rehashed.
+ *
+ * Inserting or removing may move values so references returned by find are invalidated by both.
+ *
+ * @tparam H The hasher used for keys.
+ * @tparam A The allocator the control bytes and slots are stored in.
+ */
+template <typename Key, typename Value, Hasher H = WyHasher, Allocator A = GlobalAllocator>
 class Map {
-	struct Bucket {
+	struct Slot {
 		Key key;
 		Value value;
-		i32 next;
 	};
-	static_assert(std::is_base_of_v<core::Hasher, Hasher>, "Hasher must be a valid Hasher");
 
 public:
 	constexpr Map() = default;
+	explicit Map(A allocator) : m_allocator(allocator) {}
+
+	Map(const Map& copy);
+	Map& operator=(const Map& copy);
+	Map(Map&& move) noexcept;
+	Map& operator=(Map&& move) noexcept;
+
+	~Map();
 
-	using ConstIterator = ConstMapIterator<Key, Value, Hasher>;
-	using Iterator = MapIterator<Key, Value, Hasher>;
+	using ConstIterator = ConstMapIterator<Key, Value, H, A>;
+	using Iterator = MapIterator<Key, Value, H, A>;
 
+	// Makes room for at least amount more elements without rehashing.
 	void reserve(usize amount);
-	OP_NO_DISCARD OP_ALWAYS_INLINE usize len() const { return m_buckets.len(); }
-	OP_NO_DISCARD OP_ALWAYS_INLINE usize cap() const { return m_buckets.cap(); }
-	OP_NO_DISCARD OP_ALWAYS_INLINE bool is_empty() const { return m_buckets.is_empty(); }
+	OP_NO_DISCARD OP_ALWAYS_INLINE usize len() const { return m_len; }
+	// Number of elements the map can hold before it has to grow.
+	OP_NO_DISCARD OP_ALWAYS_INLINE usize cap() const { return capacity_to_growth(m_cap); }
+	OP_NO_DISCARD OP_ALWAYS_INLINE bool is_empty() const { return m_len == 0; }
+	OP_NO_DISCARD OP_ALWAYS_INLINE const A& allocator() const { return m_allocator; }
 
+	// Inserts the value or replaces the value already stored for key.
 	void insert(const Key& key, Value&& value);
 	void insert(const Key& key, const Value& value);
 
@@ -78,18 +184,57 @@ public:
 	Option<Value const&> find(const Key& key) const;
 	Option<Value&> find_mut(const Key& key);
 
+	/**
+	 * Lookups with a hash computed up front by hash_key, for hot keys that are looked up repeatedly.
+	 *
+	 * @safety hash must be hash_key(key). Any other value makes the lookup miss.
+	 */
+	Option<Value const&> find_hashed(const Key& key, u64 hash) const;
+	Option<Value&> find_mut_hashed(const Key& key, u64 hash);
+
+	OP_NO_DISCARD static OP_ALWAYS_INLINE u64 hash_key(const Key& key) { return op::hash<H>(key); }
+
 	OP_ALWAYS_INLINE ConstIterator iter() const;
 	OP_ALWAYS_INLINE Iterator iter_mut();
 
 private:
-	friend class MapIterator<Key, Value, Hasher>;
-	friend class ConstMapIterator<Key, Value, Hasher>;
+	friend class MapIterator<Key, Value, H, A>;
+	friend class ConstMapIterator<Key, Value, H, A>;
+
+	using Ctrl = hidden::MapCtrl;
+	using Group = hidden::MapGroup;
+
+	static constexpr usize min_cap = Group::width;
 
-	OP_ALWAYS_INLINE usize key_to_layout_index(const Key& key) const;
-	void refresh_layout();
+	// Max load factor of 7/8.
+	OP_NO_DISCARD static OP_ALWAYS_INLINE constexpr usize capacity_to_growth(usize cap) { return cap - cap / 8; }
+
+	OP_NO_DISCARD static OP_ALWAYS_INLINE Ctrl h2(u64 hash) { return static_cast<Ctrl>(hash & 0x7f); }
+
+	// Control bytes and slots share one allocation with the slots aligned after the control bytes.
+	OP_NO_DISCARD static OP_ALWAYS_INLINE usize slots_offset(usize cap) {
+		return (cap + Group::width + alignof(Slot) - 1) & ~(alignof(Slot) - 1);
+	}
+	OP_NO_DISCARD static OP_ALWAYS_INLINE Layout layout_for(usize cap) {
+		return Layout{ slots_offset(cap) + sizeof(Slot) * cap, alignof(Slot) };
+	}
 
-	Vector<Bucket> m_buckets;
-	Vector<i32> m_layout;
+	OP_NO_DISCARD Option<usize> find_index(const Key& key, u64 hash) const;
+	OP_NO_DISCARD usize find_insert_index(u64 hash) const;
+
+	OP_ALWAYS_INLINE void set_ctrl(usize index, Ctrl ctrl);
+	void erase_at(usize index);
+	void resize(usize new_cap);
+	void destroy();
+
+	// m_cap control bytes followed by a copy of the first group so groups can be loaded from any index.
+	Ctrl* m_ctrl = nullptr;
+	Slot* m_slots = nullptr;
+	// Zero or a power of two no smaller than min_cap.
+	usize m_cap = 0;
+	usize m_len = 0;
+	usize m_growth_left = 0;
+	OP_NO_UNIQUE_ADDRESS A m_allocator;
 };
 
 OP_CORE_NAMESPACE_END
@@ -100,4 +245,4 @@ OP_CORE_NAMESPACE_END
 // Export to op namespace
 OP_NAMESPACE_BEGIN
 using core::Map;
-OP_NAMESPACE_END
\ No newline at end of file
+OP_NAMESPACE_END
@@ -1,161 +1,325 @@
 // Copyright Colby Hall. All Rights Reserved.
 
+#include <bit>
+
 OP_CORE_NAMESPACE_BEGIN
 
-template <typename Key, typename Value, typename Hasher>
-void Map<Key, Value, Hasher>::reserve(usize amount) {
-	m_buckets.reserve(amount);
-	m_layout.reserve(amount);
+template <typename Key, typename Value, Hasher H, Allocator A>
+Map<Key, Value, H, A>::Map(const Map& copy) : m_allocator(copy.m_allocator) {
+	reserve(copy.len());
+	for (auto it = copy.iter(); it; ++it) {
+		insert(it.key(), it.value());
+	}
 }
 
-template <typename Key, typename Value, typename Hasher>
-void Map<Key, Value, Hasher>::insert(const Key& key, Value&& value) {
-	m_buckets.push(Bucket{ key, op::forward<Value>(value), -1 });
+template <typename Key, typename Value, Hasher H, Allocator A>
+Map<Key, Value, H, A>& Map<Key, Value, H, A>::operator=(const Map& copy) {
+	if (this != &copy) {
+		Map to_copy = copy;
+		*this = op::move(to_copy);
+	}
+	return *this;
+}
 
-	refresh_layout();
+template <typename Key, typename Value, Hasher H, Allocator A>
+Map<Key, Value, H, A>::Map(Map&& move) noexcept
+	: m_ctrl(move.m_ctrl)
+	, m_slots(move.m_slots)
+	, m_cap(move.m_cap)
+	, m_len(move.m_len)
+	, m_growth_left(move.m_growth_left)
+	, m_allocator(move.m_allocator) {
+	move.m_ctrl = nullptr;
+	move.m_slots = nullptr;
+	move.m_cap = 0;
+	move.m_len = 0;
+	move.m_growth_left = 0;
 }
 
-template <typename Key, typename Value, typename Hasher>
-void Map<Key, Value, Hasher>::insert(const Key& key, const Value& value) {
-	m_buckets.push(Bucket{ key, value, -1 });
+template <typename Key, typename Value, Hasher H, Allocator A>
+Map<Key, Value, H, A>& Map<Key, Value, H, A>::operator=(Map&& move) noexcept {
+	if (this != &move) {
+		destroy();
+
+		m_ctrl = move.m_ctrl;
+		m_slots = move.m_slots;
+		m_cap = move.m_cap;
+		m_len = move.m_len;
+		m_growth_left = move.m_growth_left;
+		m_allocator = move.m_allocator;
+
+		move.m_ctrl = nullptr;
+		move.m_slots = nullptr;
+		move.m_cap = 0;
+		move.m_len = 0;
+		move.m_growth_left = 0;
+	}
+	return *this;
+}
 
-	refresh_layout();
+template <typename Key, typename Value, Hasher H, Allocator A>
+Map<Key, Value, H, A>::~Map() {
+	destroy();
 }
 
-template <typename Key, typename Value, typename Hasher>
-Option<Value> Map<Key, Value, Hasher>::remove(const Key& key) {
-	if (m_buckets.is_empty()) {
-		return nullptr;
+template <typename Key, typename Value, Hasher H, Allocator A>
+void Map<Key, Value, H, A>::reserve(usize amount) {
+	const auto desired = m_len + amount;
+	if (desired <= cap()) {
+		return;
 	}
 
-	const auto index = key_to_layout_index(key);
-	const auto mapped = m_layout[index];
-	if (mapped == -1) {
-		return nullptr;
+	usize new_cap = min_cap;
+	while (capacity_to_growth(new_cap) < desired) {
+		new_cap *= 2;
 	}
+	resize(new_cap);
+}
 
-	Bucket* bucket = &m_buckets[mapped];
-	i32 bucket_index = -1;
-	while (true) {
-		bucket_index = bucket->next;
-		if (bucket->key == key) return bucket->value;
-		if (bucket->next == -1) break;
-		bucket = &m_buckets[bucket->next];
+template <typename Key, typename Value, Hasher H, Allocator A>
+void Map<Key, Value, H, A>::insert(const Key& key, Value&& value) {
+	const auto hash = hash_key(key);
+
+	if (m_len > 0) {
+		auto existing = find_index(key, hash);
+		if (existing.is_set()) {
+			m_slots[existing.unwrap()].value = op::move(value);
+			return;
+		}
 	}
 
-	Bucket result = m_buckets.remove((usize)bucket_index);
-	refresh_layout();
-	return result.value;
+	if (m_growth_left == 0) {
+		// If most of the used capacity is tombstones rehashing at the same size is enough to make room.
+		const auto new_cap = m_cap == 0 ? min_cap : (m_len + 1 > capacity_to_growth(m_cap) / 2 ? m_cap * 2 : m_cap);
+		resize(new_cap);
+	}
+
+	const auto index = find_insert_index(hash);
+	if (m_ctrl[index] == hidden::map_ctrl_empty) {
+		m_growth_left -= 1;
+	}
+	set_ctrl(index, h2(hash));
+	new (m_slots + index) Slot{ key, op::move(value) };
+	m_len += 1;
 }
 
-template <typename Key, typename Value, typename Hasher>
-void Map<Key, Value, Hasher>::retain(FunctionRef<bool(const Key&, const Value&)> keep) {
-	// Reverse iterate to remove to prevent shifting entire array
-	i32 index = static_cast<i32>(m_buckets.len()) - 1;
-	for (; index >= 0; index--) {
-		auto& bucket = m_buckets[index];
-		if (!keep(bucket.key, bucket.value)) {
-			m_buckets.remove(index);
+template <typename Key, typename Value, Hasher H, Allocator A>
+void Map<Key, Value, H, A>::insert(const Key& key, const Value& value) {
+	Value copy = value;
+	insert(key, op::move(copy));
+}
+
+template <typename Key, typename Value, Hasher H, Allocator A>
+Option<Value> Map<Key, Value, H, A>::remove(const Key& key) {
+	if (m_len == 0) {
+		return nullopt;
+	}
+
+	auto index_opt = find_index(key, hash_key(key));
+	if (!index_opt.is_set()) {
+		return nullopt;
+	}
+
+	const auto index = index_opt.unwrap();
+	Option<Value> result = op::move(m_slots[index].value);
+	erase_at(index);
+	return result;
+}
+
+template <typename Key, typename Value, Hasher H, Allocator A>
+void Map<Key, Value, H, A>::retain(FunctionRef<bool(const Key&, const Value&)> keep) {
+	for (usize index = 0; index < m_cap; ++index) {
+		if (m_ctrl[index] < 0) continue;
+
+		auto& slot = m_slots[index];
+		if (!keep(slot.key, slot.value)) {
+			erase_at(index);
 		}
 	}
-	refresh_layout();
 }
 
-template <typename Key, typename Value, typename Hasher>
-Option<Value&> Map<Key, Value, Hasher>::find_mut(const Key& key) {
-	if (m_buckets.is_empty()) {
-		return nullptr;
+template <typename Key, typename Value, Hasher H, Allocator A>
+Option<Value&> Map<Key, Value, H, A>::find_mut(const Key& key) {
+	return find_mut_hashed(key, hash_key(key));
+}
+
+template <typename Key, typename Value, Hasher H, Allocator A>
+Option<Value const&> Map<Key, Value, H, A>::find(const Key& key) const {
+	return find_hashed(key, hash_key(key));
+}
+
+template <typename Key, typename Value, Hasher H, Allocator A>
+Option<Value&> Map<Key, Value, H, A>::find_mut_hashed(const Key& key, u64 hash) {
+	if (m_len == 0) {
+		return nullopt;
 	}
 
-	const auto index = key_to_layout_index(key);
-	const auto mapped = m_layout[index];
-	if (mapped == -1) {
-		return nullptr;
+	auto index = find_index(key, hash);
+	if (!index.is_set()) {
+		return nullopt;
 	}
+	return m_slots[index.unwrap()].value;
+}
 
-	Bucket* bucket = &m_buckets[mapped];
-	while (true) {
-		if (bucket->key == key) return bucket->value;
-		if (bucket->next == -1) break;
-		bucket = &m_buckets[bucket->next];
+template <typename Key, typename Value, Hasher H, Allocator A>
+Option<Value const&> Map<Key, Value, H, A>::find_hashed(const Key& key, u64 hash) const {
+	if (m_len == 0) {
+		return nullopt;
 	}
 
-	return nullptr;
+	auto index = find_index(key, hash);
+	if (!index.is_set()) {
+		return nullopt;
+	}
+	return m_slots[index.unwrap()].value;
 }
 
-template <typename Key, typename Value, typename Hasher>
-Option<Value const&> Map<Key, Value, Hasher>::find(const Key& key) const {
-	if (m_buckets.is_empty()) {
-		return nullptr;
-	}
+template <typename Key, typename Value, Hasher H, Allocator A>
+Option<usize> Map<Key, Value, H, A>::find_index(const Key& key, u64 hash) const {
+	const auto mask = m_cap - 1;
+	const auto tag = h2(hash);
+
+	// Triangular probing over groups visits every group once when the capacity is a power of two.
+	usize position = static_cast<usize>(hash >> 7) & mask;
+	usize step = 0;
+	while (true) {
+		const auto group = Group(m_ctrl + position);
+		for (auto matches = group.match(tag); matches != 0; matches &= matches - 1) {
+			const auto index = (position + static_cast<usize>(std::countr_zero(matches))) & mask;
+			if (m_slots[index].key == key) {
+				return index;
+			}
+		}
 
-	const auto index = key_to_layout_index(key);
-	const auto mapped = m_layout[index];
-	if (mapped == -1) {
-		return nullptr;
+		// An empty slot ends every probe sequence that could contain the key.
+		if (group.match_empty() != 0) {
+			return nullopt;
+		}
+
+		step += Group::width;
+		position = (position + step) & mask;
 	}
+}
+
+template <typename Key, typename Value, Hasher H, Allocator A>
+usize Map<Key, Value, H, A>::find_insert_index(u64 hash) const {
+	const auto mask = m_cap - 1;
 
-	Bucket const* bucket = &m_buckets[mapped];
+	usize position = static_cast<usize>(hash >> 7) & mask;
+	usize step = 0;
 	while (true) {
-		if (bucket->key == key) return bucket->value;
-		if (bucket->next == -1) break;
-		bucket = &m_buckets[bucket->next];
+		const auto group = Group(m_ctrl + position);
+		const auto available = group.match_empty_or_deleted();
+		if (available != 0) {
+			return (position + static_cast<usize>(std::countr_zero(available))) & mask;
+		}
+
+		step += Group::width;
+		position = (position + step) & mask;
 	}
+}
 
-	return nullptr;
+template <typename Key, typename Value, Hasher H, Allocator A>
+inline void Map<Key, Value, H, A>::set_ctrl(usize index, Ctrl ctrl) {
+	m_ctrl[index] = ctrl;
+
+	// Keep the copy of the first group in sync so groups loaded near the end wrap around.
+	if (index < Group::width) {
+		m_ctrl[m_cap + index] = ctrl;
+	}
 }
 
-template <typename Key, typename Value, typename Hasher>
-inline usize Map<Key, Value, Hasher>::key_to_layout_index(const Key& key) const {
-	Hasher hasher = {};
-	op::Hash<Hasher, Key> hash;
-	hash(hasher, key);
-	const u64 the_hash = hasher.finish();
-	return the_hash % m_buckets.len();
+template <typename Key, typename Value, Hasher H, Allocator A>
+void Map<Key, Value, H, A>::erase_at(usize index) {
+	m_slots[index].~Slot();
+	m_len -= 1;
+
+	// A probe only continues past a group with no empty slots. If every group containing this slot also contains an
+	// empty slot then no probe ever went past it and it can be marked empty instead of deleted.
+	const auto mask = m_cap - 1;
+	const auto index_before = (index - Group::width) & mask;
+	const auto empty_after = Group(m_ctrl + index).match_empty();
+	const auto empty_before = Group(m_ctrl + index_before).match_empty();
+	const auto was_never_full =
+		empty_before != 0 && empty_after != 0 &&
+		static_cast<usize>(std::countr_zero(empty_after) + std::countl_zero(empty_before << 16)) < Group::width;
+
+	if (was_never_full) {
+		set_ctrl(index, hidden::map_ctrl_empty);
+		m_growth_left += 1;
+	} else {
+		set_ctrl(index, hidden::map_ctrl_deleted);
+	}
 }
 
-template <typename Key, typename Value, typename Hasher>
-void Map<Key, Value, Hasher>::refresh_layout() {
-	// Reset the layout array to all be invalid
-	m_layout.reset();
-	for (usize i = 0; i < m_buckets.len(); ++i) {
-		m_layout.push(-1);
+template <typename Key, typename Value, Hasher H, Allocator A>
+void Map<Key, Value, H, A>::resize(usize new_cap) {
+	OP_ASSERT(new_cap >= min_cap && (new_cap & (new_cap - 1)) == 0, "Map capacity must be a power of two");
+	OP_ASSERT(capacity_to_growth(new_cap) >= m_len);
+
+	auto* old_ctrl = m_ctrl;
+	auto* old_slots = m_slots;
+	const auto old_cap = m_cap;
+
+	MemoryScope scope(MemoryCategory::Map);
+	void* ptr = m_allocator.malloc(layout_for(new_cap));
+	auto* memory = static_cast<u8*>(ptr);
+
+	const auto ctrl_size = new_cap + Group::width;
+	m_ctrl = reinterpret_cast<Ctrl*>(memory);
+	m_slots = reinterpret_cast<Slot*>(memory + slots_offset(new_cap));
+	m_cap = new_cap;
+	m_growth_left = capacity_to_growth(new_cap) - m_len;
+	core::set(m_ctrl, static_cast<u8>(hidden::map_ctrl_empty), ctrl_size);
+
+	if (old_ctrl == nullptr) {
+		return;
 	}
 
-	// Layout buckets by hash(key) & buckets.len() and build tree if collision
-	// detected
-	for (usize i = 0; i < m_buckets.len(); ++i) {
-		auto& bucket = m_buckets[i];
+	for (usize index = 0; index < old_cap; ++index) {
+		if (old_ctrl[index] < 0) continue;
 
-		const auto layout_index = key_to_layout_index(bucket.key);
-		bucket.next = -1;
+		auto& slot = old_slots[index];
+		const auto hash = hash_key(slot.key);
+		const auto new_index = find_insert_index(hash);
+		set_ctrl(new_index, h2(hash));
+		new (m_slots + new_index) Slot{ op::move(slot) };
+		slot.~Slot();
+	}
 
-		// Check what index lies in the layout array
-		auto found = m_layout[layout_index];
+	m_allocator.free(old_ctrl, layout_for(old_cap));
+}
 
-		// If its invalid then simply set the bucket index
-		if (found == -1) {
-			m_layout[layout_index] = (i32)i;
-		} else {
-			// If its valid then descend the bucket tree until an empty spot is
-			// found
-			auto* other = &m_buckets[found];
-			while (other->next != -1) {
-				other = &m_buckets[(usize)other->next];
+template <typename Key, typename Value, Hasher H, Allocator A>
+void Map<Key, Value, H, A>::destroy() {
+	if (m_ctrl == nullptr) {
+		return;
+	}
+
+	if constexpr (!std::is_trivially_destructible_v<Slot>) {
+		for (usize index = 0; index < m_cap; ++index) {
+			if (m_ctrl[index] >= 0) {
+				m_slots[index].~Slot();
 			}
-			other->next = (i32)i;
 		}
 	}
+
+	m_allocator.free(m_ctrl, layout_for(m_cap));
+	m_ctrl = nullptr;
+	m_slots = nullptr;
+	m_cap = 0;
+	m_len = 0;
+	m_growth_left = 0;
 }
 
-template <typename Key, typename Value, typename Hasher>
-inline ConstMapIterator<Key, Value, Hasher> Map<Key, Value, Hasher>::iter() const {
+template <typename Key, typename Value, Hasher H, Allocator A>
+inline ConstMapIterator<Key, Value, H, A> Map<Key, Value, H, A>::iter() const {
 	return ConstMapIterator(*this);
 }
 
-template <typename Key, typename Value, typename Hasher>
-inline MapIterator<Key, Value, Hasher> Map<Key, Value, Hasher>::iter_mut() {
+template <typename Key, typename Value, Hasher H, Allocator A>
+inline MapIterator<Key, Value, H, A> Map<Key, Value, H, A>::iter_mut() {
 	return MapIterator(*this);
 }
 
-OP_CORE_NAMESPACE_END
\ No newline at end of file
+OP_CORE_NAMESPACE_END
@@ -0,0 +1,70 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#pragma once
+
+#include "core/atomic.h"
+#include "core/concepts.h"
+#include "core/containers/option.h"
+
+OP_CORE_NAMESPACE_BEGIN
+
+/**
+ * A bounded queue that any number of threads can push to and pop from without a lock.
+ *
+ * Every cell carries a sequence number that says whose turn it is: a producer may fill the cell at position p once its
+ * sequence is p, and a consumer may empty it once its sequence is p + 1. Producers and consumers only contend on their
+ * own position counter, which sit on separate cache lines. Push and pop fail instead of blocking when the queue is full
+ * or empty. Elements only have to be movable, so move only payloads like Function work.
+ *
+ * @tparam T The type of element to store in the queue.
+ */
+template <Movable T>
+class MpmcQueue {
+public:
+	// cap must be a power of two.
+	explicit MpmcQueue(usize cap);
+
+	MpmcQueue(const MpmcQueue& copy) = delete;
+	MpmcQueue& operator=(const MpmcQueue& copy) = delete;
+
+	~MpmcQueue();
+
+	/**
+	 * Moves value into the queue. Returns false and leaves value untouched if the queue is full.
+	 */
+	OP_NO_DISCARD bool push(T&& value);
+
+	/**
+	 * Moves the oldest element out of the queue, or returns nullopt if it is empty.
+	 */
+	OP_NO_DISCARD Option<T> pop();
+
+	// Number of elements at the time of the call. Other threads may change it right after.
+	OP_NO_DISCARD usize len() const;
+	OP_NO_DISCARD OP_ALWAYS_INLINE bool is_empty() const { return len() == 0; }
+	OP_NO_DISCARD OP_ALWAYS_INLINE usize cap() const { return m_mask + 1; }
+
+private:
+	struct Cell {
+		Atomic<usize> sequence;
+		alignas(T) u8 storage[sizeof(T)];
+
+		OP_ALWAYS_INLINE T& value() { return *reinterpret_cast<T*>(storage); }
+	};
+
+	Cell* m_cells;
+	usize m_mask;
+
+	alignas(OP_CACHE_LINE_SIZE) Atomic<usize> m_push_position = 0;
+	alignas(OP_CACHE_LINE_SIZE) Atomic<usize> m_pop_position = 0;
+};
+
+OP_CORE_NAMESPACE_END
+
+// Include the implementation
+#include "core/containers/mpmc_queue.inl"
+
+// Export to op namespace
+OP_NAMESPACE_BEGIN
+using core::MpmcQueue;
+OP_NAMESPACE_END
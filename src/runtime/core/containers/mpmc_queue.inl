@@ -0,0 +1,87 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#include "core/os/memory.h"
+
+OP_CORE_NAMESPACE_BEGIN
+
+template <Movable T>
+MpmcQueue<T>::MpmcQueue(usize cap) : m_mask(cap - 1) {
+	OP_ASSERT(cap > 0 && (cap & (cap - 1)) == 0, "Capacity must be a power of two");
+
+	void* ptr = core::malloc(core::Layout::array<Cell>(cap));
+	m_cells = static_cast<Cell*>(ptr);
+	for (usize index = 0; index < cap; ++index) {
+		new (&m_cells[index].sequence) Atomic<usize>(index);
+	}
+}
+
+template <Movable T>
+MpmcQueue<T>::~MpmcQueue() {
+	while (pop().is_set()) {
+	}
+	core::free(m_cells);
+}
+
+template <Movable T>
+bool MpmcQueue<T>::push(T&& value) {
+	Cell* cell;
+	auto position = m_push_position.load(Order::Relaxed);
+	while (true) {
+		cell = &m_cells[position & m_mask];
+		const auto sequence = cell->sequence.load(Order::Acquire);
+		const auto difference = static_cast<isize>(sequence) - static_cast<isize>(position);
+		if (difference == 0) {
+			// The cell is free for this lap. Claim the position before another producer does.
+			if (m_push_position.compare_exchange_weak(position, position + 1, Order::Relaxed)) {
+				break;
+			}
+			position = m_push_position.load(Order::Relaxed);
+		} else if (difference < 0) {
+			// The consumer of the previous lap has not emptied the cell yet.
+			return false;
+		} else {
+			position = m_push_position.load(Order::Relaxed);
+		}
+	}
+
+	new (cell->storage) T(op::move(value));
+	cell->sequence.store(position + 1, Order::Release);
+	return true;
+}
+
+template <Movable T>
+Option<T> MpmcQueue<T>::pop() {
+	Cell* cell;
+	auto position = m_pop_position.load(Order::Relaxed);
+	while (true) {
+		cell = &m_cells[position & m_mask];
+		const auto sequence = cell->sequence.load(Order::Acquire);
+		const auto difference = static_cast<isize>(sequence) - static_cast<isize>(position + 1);
+		if (difference == 0) {
+			if (m_pop_position.compare_exchange_weak(position, position + 1, Order::Relaxed)) {
+				break;
+			}
+			position = m_pop_position.load(Order::Relaxed);
+		} else if (difference < 0) {
+			// No producer has filled the cell for this lap.
+			return nullopt;
+		} else {
+			position = m_pop_position.load(Order::Relaxed);
+		}
+	}
+
+	Option<T> result = op::move(cell->value());
+	cell->value().~T();
+	// Hand the cell to the producer of the next lap.
+	cell->sequence.store(position + m_mask + 1, Order::Release);
+	return result;
+}
+
+template <Movable T>
+usize MpmcQueue<T>::len() const {
+	const auto pushed = m_push_position.load(Order::Relaxed);
+	const auto popped = m_pop_position.load(Order::Relaxed);
+	return pushed > popped ? pushed - popped : 0;
+}
+
+OP_CORE_NAMESPACE_END
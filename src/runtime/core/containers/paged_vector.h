@@ -0,0 +1,137 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#pragma once
+
+#include "core/atomic.h"
+#include "core/concepts.h"
+#include "core/containers/option.h"
+#include "core/containers/slice.h"
+#include "core/containers/vector.h"
+
+OP_CORE_NAMESPACE_BEGIN
+
+template <Movable Element, usize PageLen>
+class PagedVector;
+
+template <Movable Element, usize PageLen, bool Const>
+class PagedVectorIterator {
+	using Owner = std::conditional_t<Const, const PagedVector<Element, PageLen>, PagedVector<Element, PageLen>>;
+	using Reference = std::conditional_t<Const, const Element&, Element&>;
+
+public:
+	OP_ALWAYS_INLINE PagedVectorIterator(Owner& owner, usize index) : m_owner(&owner), m_index(index) {}
+
+	OP_ALWAYS_INLINE Reference operator*() const { return (*m_owner)[m_index]; }
+	OP_ALWAYS_INLINE PagedVectorIterator& operator++() {
+		m_index += 1;
+		return *this;
+	}
+	OP_ALWAYS_INLINE bool operator!=(const PagedVectorIterator& rhs) const { return m_index != rhs.m_index; }
+
+private:
+	Owner* m_owner;
+	usize m_index;
+};
+
+/**
+ * A dynamic array that stores its elements in fixed size pages so they never move once pushed.
+ *
+ * References and pointers to elements stay valid until the element is popped or the vector is destroyed. Indexing is
+ * O(1) through a table of pages, and each page is contiguous so hot loops can walk a page at a time.
+ *
+ * A single thread may push while others read elements below a length they observed. The page table is published
+ * atomically and tables that were outgrown are kept until destruction, so readers never see freed memory.
+ *
+ * @tparam Element The type of element to store in the vector.
+ * @tparam PageLen The number of elements per page. Must be a power of two.
+ */
+template <Movable Element, usize PageLen = 64>
+class PagedVector {
+	static_assert(PageLen > 0 && (PageLen & (PageLen - 1)) == 0, "PageLen must be a power of two");
+
+public:
+	PagedVector() = default;
+
+	PagedVector(const PagedVector& copy) = delete;
+	PagedVector& operator=(const PagedVector& copy) = delete;
+	PagedVector(PagedVector&& move) noexcept;
+	PagedVector& operator=(PagedVector&& move) noexcept;
+
+	~PagedVector();
+
+	using Iterator = PagedVectorIterator<Element, PageLen, false>;
+	using ConstIterator = PagedVectorIterator<Element, PageLen, true>;
+
+	OP_ALWAYS_INLINE usize len() const { return m_len.load(Order::Acquire); }
+	// Number of elements that fit in the pages allocated so far.
+	OP_ALWAYS_INLINE usize cap() const { return m_page_count * PageLen; }
+
+	OP_ALWAYS_INLINE bool is_empty() const { return len() == 0; }
+	OP_ALWAYS_INLINE operator bool() const { return !is_empty(); }
+	OP_ALWAYS_INLINE bool is_valid_index(usize index) const { return index < len(); }
+
+	OP_ALWAYS_INLINE Element& operator[](usize index);
+	OP_ALWAYS_INLINE const Element& operator[](usize index) const;
+
+	OP_NO_DISCARD OP_ALWAYS_INLINE Option<Element&> last() {
+		const auto length = len();
+		if (length > 0) return (*this)[length - 1];
+		return nullopt;
+	}
+	OP_NO_DISCARD OP_ALWAYS_INLINE Option<Element const&> last() const {
+		const auto length = len();
+		if (length > 0) return (*this)[length - 1];
+		return nullopt;
+	}
+
+	// Number of pages holding at least one element.
+	OP_ALWAYS_INLINE usize page_count() const { return (len() + PageLen - 1) / PageLen; }
+	// The elements stored in a page. Every page but the last is full.
+	Slice<Element> page(usize page_index);
+	Slice<Element const> page(usize page_index) const;
+
+	OP_ALWAYS_INLINE Iterator begin() { return Iterator(*this, 0); }
+	OP_ALWAYS_INLINE Iterator end() { return Iterator(*this, len()); }
+
+	OP_ALWAYS_INLINE ConstIterator begin() const { return ConstIterator(*this, 0); }
+	OP_ALWAYS_INLINE ConstIterator end() const { return ConstIterator(*this, len()); }
+
+	// Makes room for at least amount more elements without allocating pages.
+	void reserve(usize amount);
+
+	OP_ALWAYS_INLINE usize push(Element&& item);
+	OP_ALWAYS_INLINE usize push(const Element& item);
+	template <typename... Args>
+		requires std::is_constructible_v<Element, Args&&...>
+	Element& emplace(Args&&... args);
+
+	Option<Element> pop();
+	// Drops every element but keeps the pages.
+	void reset();
+
+	// Bytes allocated for pages and page tables including unused capacity.
+	OP_NO_DISCARD usize allocated_bytes() const;
+
+private:
+	// Returns the address of the slot at index, allocating a page if index is the first slot past the last page.
+	Element* slot_for_push(usize index);
+	void add_page();
+	void destroy();
+
+	Atomic<Element**> m_pages = nullptr;
+	Atomic<usize> m_len = 0;
+	usize m_page_count = 0;
+	usize m_page_cap = 0;
+	// Outgrown page tables. Readers may still hold them so they are only freed with the vector.
+	Vector<Element**> m_retired_tables;
+};
+
+OP_CORE_NAMESPACE_END
+
+// Include the implementation
+#include "core/containers/paged_vector.inl"
+
+// Export to op namespace
+OP_NAMESPACE_BEGIN
+using core::PagedVector;
+OP_NAMESPACE_END
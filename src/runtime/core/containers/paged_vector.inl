@@ -0,0 +1,201 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#include "core/os/memory.h"
+
+OP_CORE_NAMESPACE_BEGIN
+
+template <Movable Element, usize PageLen>
+PagedVector<Element, PageLen>::PagedVector(PagedVector&& move) noexcept
+	: m_pages(move.m_pages.load(Order::Relaxed))
+	, m_len(move.m_len.load(Order::Relaxed))
+	, m_page_count(move.m_page_count)
+	, m_page_cap(move.m_page_cap)
+	, m_retired_tables(op::move(move.m_retired_tables)) {
+	move.m_pages.store(nullptr, Order::Relaxed);
+	move.m_len.store(0, Order::Relaxed);
+	move.m_page_count = 0;
+	move.m_page_cap = 0;
+}
+
+template <Movable Element, usize PageLen>
+PagedVector<Element, PageLen>& PagedVector<Element, PageLen>::operator=(PagedVector&& move) noexcept {
+	if (this != &move) {
+		destroy();
+
+		m_pages.store(move.m_pages.load(Order::Relaxed), Order::Relaxed);
+		m_len.store(move.m_len.load(Order::Relaxed), Order::Relaxed);
+		m_page_count = move.m_page_count;
+		m_page_cap = move.m_page_cap;
+		m_retired_tables = op::move(move.m_retired_tables);
+
+		move.m_pages.store(nullptr, Order::Relaxed);
+		move.m_len.store(0, Order::Relaxed);
+		move.m_page_count = 0;
+		move.m_page_cap = 0;
+	}
+	return *this;
+}
+
+template <Movable Element, usize PageLen>
+PagedVector<Element, PageLen>::~PagedVector() {
+	destroy();
+}
+
+template <Movable Element, usize PageLen>
+OP_ALWAYS_INLINE Element& PagedVector<Element, PageLen>::operator[](usize index) {
+	OP_ASSERT(is_valid_index(index), "Index out of bounds");
+	auto** pages = m_pages.load(Order::Acquire);
+	return pages[index / PageLen][index % PageLen];
+}
+
+template <Movable Element, usize PageLen>
+OP_ALWAYS_INLINE const Element& PagedVector<Element, PageLen>::operator[](usize index) const {
+	OP_ASSERT(is_valid_index(index), "Index out of bounds");
+	auto** pages = m_pages.load(Order::Acquire);
+	return pages[index / PageLen][index % PageLen];
+}
+
+template <Movable Element, usize PageLen>
+Slice<Element> PagedVector<Element, PageLen>::page(usize page_index) {
+	OP_ASSERT(page_index < page_count(), "Page index out of bounds");
+	const auto first = page_index * PageLen;
+	const auto remaining = len() - first;
+	return Slice<Element>(m_pages.load(Order::Acquire)[page_index], remaining < PageLen ? remaining : PageLen);
+}
+
+template <Movable Element, usize PageLen>
+Slice<Element const> PagedVector<Element, PageLen>::page(usize page_index) const {
+	OP_ASSERT(page_index < page_count(), "Page index out of bounds");
+	const auto first = page_index * PageLen;
+	const auto remaining = len() - first;
+	return Slice<Element const>(m_pages.load(Order::Acquire)[page_index], remaining < PageLen ? remaining : PageLen);
+}
+
+template <Movable Element, usize PageLen>
+void PagedVector<Element, PageLen>::reserve(usize amount) {
+	const auto desired = m_len.load(Order::Relaxed) + amount;
+	while (cap() < desired) {
+		add_page();
+	}
+}
+
+template <Movable Element, usize PageLen>
+OP_ALWAYS_INLINE usize PagedVector<Element, PageLen>::push(Element&& item) {
+	const auto index = m_len.load(Order::Relaxed);
+	new (slot_for_push(index)) Element(op::forward<Element>(item));
+
+	// Publish the element only once it is fully constructed.
+	m_len.store(index + 1, Order::Release);
+	return index;
+}
+
+template <Movable Element, usize PageLen>
+OP_ALWAYS_INLINE usize PagedVector<Element, PageLen>::push(const Element& item) {
+	Element copy = item;
+	return push(op::move(copy));
+}
+
+template <Movable Element, usize PageLen>
+template <typename... Args>
+	requires std::is_constructible_v<Element, Args&&...>
+Element& PagedVector<Element, PageLen>::emplace(Args&&... args) {
+	const auto index = m_len.load(Order::Relaxed);
+	auto* result = new (slot_for_push(index)) Element(op::forward<Args>(args)...);
+
+	m_len.store(index + 1, Order::Release);
+	return *result;
+}
+
+template <Movable Element, usize PageLen>
+Option<Element> PagedVector<Element, PageLen>::pop() {
+	const auto length = m_len.load(Order::Relaxed);
+	if (length == 0) {
+		return nullopt;
+	}
+
+	m_len.store(length - 1, Order::Release);
+	auto& last = m_pages.load(Order::Relaxed)[(length - 1) / PageLen][(length - 1) % PageLen];
+	Option<Element> result = op::move(last);
+	last.~Element();
+	return result;
+}
+
+template <Movable Element, usize PageLen>
+void PagedVector<Element, PageLen>::reset() {
+	const auto length = m_len.load(Order::Relaxed);
+	m_len.store(0, Order::Release);
+
+	if constexpr (!std::is_trivially_destructible_v<Element>) {
+		auto** pages = m_pages.load(Order::Relaxed);
+		for (usize index = 0; index < length; ++index) {
+			pages[index / PageLen][index % PageLen].~Element();
+		}
+	}
+}
+
+template <Movable Element, usize PageLen>
+usize PagedVector<Element, PageLen>::allocated_bytes() const {
+	usize result = m_page_count * PageLen * sizeof(Element) + m_page_cap * sizeof(Element*);
+
+	// Every retired table was half the size of the one that replaced it.
+	usize retired_cap = m_page_cap;
+	for (usize index = 0; index < m_retired_tables.len(); ++index) {
+		retired_cap /= 2;
+		result += retired_cap * sizeof(Element*);
+	}
+	return result + m_retired_tables.cap() * sizeof(Element**);
+}
+
+template <Movable Element, usize PageLen>
+Element* PagedVector<Element, PageLen>::slot_for_push(usize index) {
+	if (index == cap()) {
+		add_page();
+	}
+	return m_pages.load(Order::Relaxed)[index / PageLen] + index % PageLen;
+}
+
+template <Movable Element, usize PageLen>
+void PagedVector<Element, PageLen>::add_page() {
+	auto** pages = m_pages.load(Order::Relaxed);
+
+	if (m_page_count == m_page_cap) {
+		const auto new_page_cap = m_page_cap == 0 ? 4 : m_page_cap * 2;
+		void* ptr = core::malloc(core::Layout::array<Element*>(new_page_cap));
+		auto** new_pages = static_cast<Element**>(ptr);
+		if (pages != nullptr) {
+			core::copy(new_pages, pages, m_page_count * sizeof(Element*));
+			m_retired_tables.push(pages);
+		}
+
+		pages = new_pages;
+		m_page_cap = new_page_cap;
+		m_pages.store(pages, Order::Release);
+	}
+
+	void* page = core::malloc(core::Layout::array<Element>(PageLen));
+	pages[m_page_count] = static_cast<Element*>(page);
+	m_page_count += 1;
+}
+
+template <Movable Element, usize PageLen>
+void PagedVector<Element, PageLen>::destroy() {
+	reset();
+
+	auto** pages = m_pages.load(Order::Relaxed);
+	for (usize index = 0; index < m_page_count; ++index) {
+		core::free(pages[index]);
+	}
+	if (pages != nullptr) {
+		core::free(pages);
+	}
+	for (auto* table : m_retired_tables) {
+		core::free(table);
+	}
+
+	m_pages.store(nullptr, Order::Relaxed);
+	m_page_count = 0;
+	m_page_cap = 0;
+	m_retired_tables.reset();
+}
+
+OP_CORE_NAMESPACE_END
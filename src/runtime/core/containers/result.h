@@ -20,10 +20,11 @@ public:
 		new (p) Error(op::forward<Error>(e));
 	}
 
-	Result(Result&& other) noexcept : m_set(other.m_set), m_ok(other.m_ok), m_data(other.m_data) {
+	// The contents are relocated bitwise and other is left empty.
+	Result(Result&& other) noexcept : m_set(other.m_set), m_ok(other.m_ok) {
+		core::copy(m_data, other.m_data, sizeof(m_data));
 		other.m_set = false;
 		other.m_ok = false;
-		other.m_data = {};
 	}
 	Result& operator=(Result&& other) noexcept {
 		auto to_destroy = op::move(*this);
@@ -31,9 +32,10 @@ public:
 
 		m_set = other.m_set;
 		m_ok = other.m_ok;
-		m_data = other.m_data;
+		core::copy(m_data, other.m_data, sizeof(m_data));
 		other.m_set = false;
 		other.m_ok = false;
+		return *this;
 	}
 
 	~Result() {
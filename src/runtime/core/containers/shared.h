@@ -2,8 +2,10 @@
 
 #pragma once
 
+#include "core/allocator.h"
 #include "core/atomic.h"
 #include "core/containers/option.h"
+#include "core/slab.h"
 
 OP_CORE_NAMESPACE_BEGIN
 
@@ -24,13 +26,33 @@ public:
 
 	template <typename... Args>
 	static Shared<Base, Mode> make(Args&&... args) {
+		return make_in(SlabAllocator(), op::forward<Args>(args)...);
+	}
+
+	/**
+	 * Constructs the value and its counters in one block allocated from allocator.
+	 *
+	 * The allocator is kept in the block and used to free it, so Shared's type does not depend on where it was allocated.
+	 */
+	template <Allocator A, typename... Args>
+	static Shared<Base, Mode> make_in(A allocator, Args&&... args) {
 		struct Combined {
 			SharedCounter<Mode> counter;
 			Base base;
+			OP_NO_UNIQUE_ADDRESS A allocator;
+
+			static void release(SharedCounter<Mode> const* counter) {
+				// counter is the first member so it shares the block's address.
+				auto* combined = reinterpret_cast<Combined*>(const_cast<SharedCounter<Mode>*>(counter));
+				A allocator = combined->allocator;
+				combined->allocator.~A();
+				allocator.free(combined, core::Layout::single<Combined>);
+			}
 		};
 
 		const auto layout = core::Layout::single<Combined>;
-		Combined* ptr = new (core::malloc(layout)) Combined{ SharedCounter<Mode>(), Base(op::move(args)...) };
+		Combined* ptr = new (allocator.malloc(layout))
+			Combined{ SharedCounter<Mode>(&Combined::release), Base(op::forward<Args>(args)...), allocator };
 
 		auto result = Shared(&ptr->counter, &ptr->base);
 		if constexpr (std::is_base_of_v<SharedFromThisBase, Base>) {
@@ -180,7 +202,12 @@ private:
 template <>
 class SharedCounter<SMode::NonAtomic> {
 public:
-	SharedCounter() = default;
+	// Frees the block holding the counter once the last reference is gone.
+	using Release = void (*)(SharedCounter const*);
+
+	explicit SharedCounter(Release release) : m_release(release) {}
+
+	OP_ALWAYS_INLINE void release() const { m_release(this); }
 
 	OP_ALWAYS_INLINE u32 strong() const { return m_strong; }
 	OP_ALWAYS_INLINE u32 weak() const { return m_weak; }
@@ -206,12 +233,18 @@ public:
 private:
 	mutable u32 m_strong = 1;
 	mutable u32 m_weak = 0;
+	Release m_release;
 };
 
 template <>
 class SharedCounter<SMode::Atomic> {
 public:
-	SharedCounter() = default;
+	// Frees the block holding the counter once the last reference is gone.
+	using Release = void (*)(SharedCounter const*);
+
+	explicit SharedCounter(Release release) : m_release(release) {}
+
+	OP_ALWAYS_INLINE void release() const { m_release(this); }
 
 	OP_ALWAYS_INLINE u32 strong() const { return m_strong.load(); }
 	OP_ALWAYS_INLINE u32 weak() const { return m_weak.load(); }
@@ -225,6 +258,7 @@ public:
 private:
 	Atomic<u32> m_strong = 1;
 	Atomic<u32> m_weak = 0;
+	Release m_release;
 };
 
 class SharedFromThisBase {};
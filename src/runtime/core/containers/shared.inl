@@ -19,13 +19,13 @@ Shared<Base, Mode>::~Shared() {
 			// to account for this
 			if constexpr (std::is_base_of_v<SharedFromThisBase, Base>) {
 				if (weak_count == 1) {
-					core::free(m_counter);
+					c.release();
 				}
 			}
 			// Free the memory if we have no weak references
 			else {
 				if (weak_count == 0) {
-					core::free(m_counter);
+					c.release();
 				}
 			}
 
@@ -51,7 +51,7 @@ Weak<Base, Mode>::~Weak() {
 		const auto weak_count = c.remove_weak();
 
 		if (strong_count == 0 && weak_count == 0) {
-			core::free(m_counter);
+			c.release();
 			m_counter = nullptr;
 		}
 	}
@@ -10,8 +10,9 @@ OP_CORE_NAMESPACE_BEGIN
  * A slot map is a data structure that allows for constant time insertion and removal of elements.
  *
  * @tparam T The type of element to store in the slot map.
+ * @tparam A The allocator the slots are stored in.
  */
-template <typename T>
+template <typename T, Allocator A = GlobalAllocator>
 class SlotMap {
 public:
 	class Key {
@@ -23,14 +24,18 @@ public:
 		}
 		OP_ALWAYS_INLINE bool operator!=(const Key& other) const { return !(*this == other); }
 
+		OP_NO_DISCARD OP_ALWAYS_INLINE u32 index() const { return m_index; }
+		OP_NO_DISCARD OP_ALWAYS_INLINE u32 version() const { return m_version; }
+
 	private:
-		friend class SlotMap<T>;
+		friend class SlotMap<T, A>;
 
 		u32 m_index;
 		u32 m_version;
 	};
 
 	SlotMap() = default;
+	explicit SlotMap(A allocator) : m_elements(allocator), m_free_indices(allocator) {}
 
 	OP_NO_DISCARD Key insert(T&& value);
 
@@ -42,13 +47,29 @@ public:
 
 	Option<T> remove(const Key& key);
 
+	OP_NO_DISCARD OP_ALWAYS_INLINE usize len() const { return m_elements.len() - m_free_indices.len(); }
+	OP_NO_DISCARD OP_ALWAYS_INLINE bool is_empty() const { return len() == 0; }
+
+	/**
+	 * Calls callable with the key and value of every occupied slot in index order.
+	 */
+	template <typename Callable>
+	void for_each(Callable&& callable);
+	template <typename Callable>
+	void for_each(Callable&& callable) const;
+
+	// Bytes allocated by the slot map including unused capacity. Does not include memory owned by the values.
+	OP_NO_DISCARD OP_ALWAYS_INLINE usize allocated_bytes() const {
+		return m_elements.cap() * sizeof(Slot) + m_free_indices.cap() * sizeof(u32);
+	}
+
 private:
 	struct Slot {
 		u32 version;
 		Option<T> value;
 	};
-	Vector<Slot> m_elements;
-	Vector<u32> m_free_indices;
+	Vector<Slot, A> m_elements;
+	Vector<u32, A> m_free_indices;
 };
 
 OP_CORE_NAMESPACE_END
@@ -2,48 +2,79 @@
 
 OP_CORE_NAMESPACE_BEGIN
 
-template <typename T>
-SlotMap<T>::Key SlotMap<T>::insert(T&& value) {
+template <typename T, Allocator A>
+SlotMap<T, A>::Key SlotMap<T, A>::insert(T&& value) {
 	u32 index;
 	constexpr u32 initial_version = 1;
 	if (m_free_indices.is_empty()) {
 		index = static_cast<u32>(m_elements.len());
 		m_elements.push({ initial_version, op::move(value) });
 	} else {
-		index = m_free_indices.pop();
-		m_elements[index] = { initial_version, op::move(value) };
+		// Reused slots keep the version bumped by remove so old keys stay invalid.
+		index = m_free_indices.pop().unwrap();
+		m_elements[index].value = op::move(value);
 	}
 	return Key(index, m_elements[index].version);
 }
 
-template <typename T>
-Option<T&> SlotMap<T>::get(const Key& key) {
+template <typename T, Allocator A>
+Option<T&> SlotMap<T, A>::get(const Key& key) {
 	if (contains(key)) {
 		return m_elements[key.m_index].value.as_mut();
 	}
 	return nullopt;
 }
 
-template <typename T>
-Option<T const&> SlotMap<T>::get(const Key& key) const {
+template <typename T, Allocator A>
+Option<T const&> SlotMap<T, A>::get(const Key& key) const {
 	if (contains(key)) {
 		return m_elements[key.m_index].value.as_ref();
 	}
 	return nullopt;
 }
 
-template <typename T>
-bool SlotMap<T>::contains(const Key& key) const {
+template <typename T, Allocator A>
+bool SlotMap<T, A>::contains(const Key& key) const {
 	return key.m_index < m_elements.len() && m_elements[key.m_index].version == key.m_version;
 }
 
-template <typename T>
-Option<T> SlotMap<T>::remove(const Key& key) {
+template <typename T, Allocator A>
+Option<T> SlotMap<T, A>::remove(const Key& key) {
 	if (contains(key)) {
+		auto& slot = m_elements[key.m_index];
+		slot.version += 1;
 		m_free_indices.push(key.m_index);
-		return op::move(m_elements[key.m_index].value);
+
+		// Option::unwrap leaves trivially copyable values set so clear the slot explicitly for for_each.
+		auto value = slot.value.unwrap();
+		if constexpr (std::is_trivially_copyable_v<T>) {
+			slot.value = nullopt;
+		}
+		return value;
 	}
 	return nullopt;
 }
 
+template <typename T, Allocator A>
+template <typename Callable>
+void SlotMap<T, A>::for_each(Callable&& callable) {
+	for (u32 index = 0; index < m_elements.len(); ++index) {
+		auto& slot = m_elements[index];
+		if (slot.value.is_set()) {
+			callable(Key(index, slot.version), slot.value.as_mut().unwrap());
+		}
+	}
+}
+
+template <typename T, Allocator A>
+template <typename Callable>
+void SlotMap<T, A>::for_each(Callable&& callable) const {
+	for (u32 index = 0; index < m_elements.len(); ++index) {
+		auto& slot = m_elements[index];
+		if (slot.value.is_set()) {
+			callable(Key(index, slot.version), slot.value.as_ref().unwrap());
+		}
+	}
+}
+
 OP_CORE_NAMESPACE_END
\ No newline at end of file
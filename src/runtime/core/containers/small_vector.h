@@ -0,0 +1,105 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#pragma once
+
+#include "core/concepts.h"
+#include "core/containers/option.h"
+#include "core/containers/slice.h"
+
+OP_CORE_NAMESPACE_BEGIN
+
+/**
+ * A dynamic array that stores up to N elements inline and only allocates once it grows past them.
+ *
+ * Has the same interface as Vector. Which buffer is in use is derived from the capacity rather than stored as a pointer
+ * so a SmallVector can be relocated bitwise, e.g. when the Vector holding it grows.
+ *
+ * @tparam Element The type of element to store in the vector.
+ * @tparam N The number of elements stored inline.
+ */
+template <Movable Element, usize N>
+class SmallVector {
+	static_assert(N > 0, "SmallVector needs an inline capacity, use Vector instead");
+
+public:
+	SmallVector() = default;
+
+	static SmallVector from(Slice<const Element> slice);
+
+	SmallVector(const SmallVector& copy) noexcept;
+	SmallVector& operator=(const SmallVector& copy) noexcept;
+	SmallVector(SmallVector&& move) noexcept;
+	SmallVector& operator=(SmallVector&& move) noexcept;
+
+	~SmallVector();
+
+	OP_ALWAYS_INLINE usize len() const { return m_len; }
+	OP_ALWAYS_INLINE usize cap() const { return m_cap; }
+	// True while the elements are stored inline and no memory has been allocated.
+	OP_ALWAYS_INLINE bool is_inline() const { return m_cap == N; }
+
+	OP_ALWAYS_INLINE bool is_empty() const { return len() == 0; }
+	OP_ALWAYS_INLINE operator bool() const { return !is_empty(); }
+	OP_ALWAYS_INLINE bool is_valid_index(usize index) const { return index < len(); }
+
+	OP_ALWAYS_INLINE operator Slice<Element>() { return Slice<Element>(data(), m_len); }
+	OP_ALWAYS_INLINE operator Slice<Element const>() const { return Slice<Element const>(data(), m_len); }
+
+	OP_ALWAYS_INLINE Element* begin() { return data(); }
+	OP_ALWAYS_INLINE Element* end() { return data() + m_len; }
+
+	OP_ALWAYS_INLINE const Element* begin() const { return data(); }
+	OP_ALWAYS_INLINE const Element* end() const { return data() + m_len; }
+
+	OP_ALWAYS_INLINE Element& operator[](usize index) {
+		OP_ASSERT(is_valid_index(index), "Index out of bounds");
+		return data()[index];
+	}
+	OP_ALWAYS_INLINE const Element& operator[](usize index) const {
+		OP_ASSERT(is_valid_index(index), "Index out of bounds");
+		return data()[index];
+	}
+
+	OP_NO_DISCARD OP_ALWAYS_INLINE Option<Element&> last() {
+		if (len() > 0) return data()[len() - 1];
+		return nullopt;
+	}
+	OP_NO_DISCARD OP_ALWAYS_INLINE Option<Element const&> last() const {
+		if (len() > 0) return data()[len() - 1];
+		return nullopt;
+	}
+
+	void reserve(usize amount);
+
+	void insert(usize index, Element&& item);
+	OP_ALWAYS_INLINE void insert(usize index, const Element& item_to_copy);
+	OP_ALWAYS_INLINE usize push(Element&& item);
+	OP_ALWAYS_INLINE usize push(const Element& item);
+
+	Element remove(usize index);
+	OP_ALWAYS_INLINE Option<Element> pop();
+	void reset();
+
+private:
+	OP_ALWAYS_INLINE Element* data() { return is_inline() ? reinterpret_cast<Element*>(m_inline) : m_heap; }
+	OP_ALWAYS_INLINE const Element* data() const {
+		return is_inline() ? reinterpret_cast<const Element*>(m_inline) : m_heap;
+	}
+
+	usize m_len = 0;
+	usize m_cap = N;
+	union {
+		Element* m_heap;
+		alignas(Element) u8 m_inline[sizeof(Element) * N];
+	};
+};
+
+OP_CORE_NAMESPACE_END
+
+// Include the implementation
+#include "core/containers/small_vector.inl"
+
+// Export to op namespace
+OP_NAMESPACE_BEGIN
+using core::SmallVector;
+OP_NAMESPACE_END
@@ -0,0 +1,176 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#include "core/os/memory.h"
+
+OP_CORE_NAMESPACE_BEGIN
+
+template <Movable Element, usize N>
+SmallVector<Element, N> SmallVector<Element, N>::from(Slice<const Element> slice) {
+	SmallVector<Element, N> result;
+	result.reserve(slice.len());
+
+	for (usize i = 0; i < slice.len(); ++i) {
+		new (result.data() + i) Element(slice[i]);
+	}
+	result.m_len = slice.len();
+
+	return result;
+}
+
+template <Movable Element, usize N>
+SmallVector<Element, N>::SmallVector(const SmallVector& copy) noexcept {
+	reserve(copy.m_len);
+	for (usize i = 0; i < copy.m_len; ++i) {
+		new (data() + i) Element(copy[i]);
+	}
+	m_len = copy.m_len;
+}
+
+template <Movable Element, usize N>
+SmallVector<Element, N>& SmallVector<Element, N>::operator=(const SmallVector& copy) noexcept {
+	if (this != &copy) {
+		SmallVector to_copy = copy;
+		*this = op::move(to_copy);
+	}
+	return *this;
+}
+
+template <Movable Element, usize N>
+SmallVector<Element, N>::SmallVector(SmallVector&& move) noexcept : m_len(move.m_len)
+																   , m_cap(move.m_cap) {
+	if (move.is_inline()) {
+		// Inline elements have to be moved one by one as the buffer is part of the object
+		auto* src = reinterpret_cast<Element*>(move.m_inline);
+		auto* dst = reinterpret_cast<Element*>(m_inline);
+		for (usize i = 0; i < m_len; ++i) {
+			new (dst + i) Element(op::move(src[i]));
+			src[i].~Element();
+		}
+	} else {
+		m_heap = move.m_heap;
+	}
+
+	move.m_len = 0;
+	move.m_cap = N;
+}
+
+template <Movable Element, usize N>
+SmallVector<Element, N>& SmallVector<Element, N>::operator=(SmallVector&& move) noexcept {
+	if (this != &move) {
+		this->~SmallVector();
+		new (this) SmallVector(op::move(move));
+	}
+	return *this;
+}
+
+template <Movable Element, usize N>
+SmallVector<Element, N>::~SmallVector() {
+	auto* ptr = data();
+	for (usize i = 0; i < m_len; ++i) {
+		ptr[i].~Element();
+	}
+
+	if (!is_inline()) {
+		core::free(m_heap);
+	}
+	m_len = 0;
+	m_cap = N;
+}
+
+template <Movable Element, usize N>
+void SmallVector<Element, N>::reserve(usize amount) {
+	const auto desired = m_len + amount;
+	if (desired <= m_cap) {
+		return;
+	}
+
+	auto new_cap = m_cap * 2;
+	while (new_cap < desired) {
+		new_cap *= 2;
+	}
+
+	// Elements are relocated bitwise the same as Vector does when it reallocates
+	if (is_inline()) {
+		void* ptr = core::malloc(core::Layout::array<Element>(new_cap));
+		core::copy(ptr, m_inline, m_len * sizeof(Element));
+		m_heap = static_cast<Element*>(ptr);
+	} else {
+		void* ptr =
+			core::realloc(m_heap, core::Layout::array<Element>(m_cap), core::Layout::array<Element>(new_cap));
+		m_heap = static_cast<Element*>(ptr);
+	}
+	m_cap = new_cap;
+}
+
+template <Movable Element, usize N>
+void SmallVector<Element, N>::insert(usize index, Element&& item) {
+	OP_ASSERT(index <= m_len);
+	if (len() == cap()) reserve(1);
+
+	auto* src = data() + index;
+	if (index != len()) {
+		core::move(src + 1, src, (len() - index) * sizeof(Element));
+	}
+
+	new (src) Element(op::forward<Element>(item));
+	m_len += 1;
+}
+
+template <Movable Element, usize N>
+OP_ALWAYS_INLINE void SmallVector<Element, N>::insert(usize index, const Element& item) {
+	Element copy = item;
+	insert(index, op::move(copy));
+}
+
+template <Movable Element, usize N>
+OP_ALWAYS_INLINE usize SmallVector<Element, N>::push(Element&& item) {
+	const auto index = len();
+	insert(index, op::move(item));
+	return index;
+}
+
+template <Movable Element, usize N>
+OP_ALWAYS_INLINE usize SmallVector<Element, N>::push(const Element& item) {
+	Element copy = item;
+	return push(op::move(copy));
+}
+
+template <Movable Element, usize N>
+Element SmallVector<Element, N>::remove(usize index) {
+	OP_ASSERT(is_valid_index(index), "Index out of bounds");
+
+	auto* src = data() + index;
+	auto result = op::move(*src);
+	src->~Element();
+
+	// Shift the elements after the removed one down to close the gap
+	if (index < m_len - 1) {
+		core::move(src, src + 1, (len() - index - 1) * sizeof(Element));
+	}
+	m_len -= 1;
+
+	return result;
+}
+
+template <Movable Element, usize N>
+OP_ALWAYS_INLINE Option<Element> SmallVector<Element, N>::pop() {
+	if (m_len > 0) {
+		m_len -= 1;
+		auto* last = data() + m_len;
+		Option<Element> result = op::move(*last);
+		last->~Element();
+		return result;
+	}
+	return nullopt;
+}
+
+template <Movable Element, usize N>
+void SmallVector<Element, N>::reset() {
+	auto* ptr = data();
+	for (usize i = 0; i < m_len; ++i) {
+		ptr[i].~Element();
+	}
+	m_len = 0;
+}
+
+OP_CORE_NAMESPACE_END
@@ -0,0 +1,69 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#pragma once
+
+#include "core/atomic.h"
+#include "core/concepts.h"
+#include "core/containers/option.h"
+
+OP_CORE_NAMESPACE_BEGIN
+
+/**
+ * A bounded ring buffer for exactly one producer thread and one consumer thread.
+ *
+ * Push and pop are wait free: each side owns one position, publishes it with a release store and only reads the other
+ * side's position when its cached copy says the buffer looks full or empty. The two sides live on separate cache lines
+ * so they do not slow each other down.
+ *
+ * @tparam T The type of element to store in the queue.
+ */
+template <Movable T>
+class SpscQueue {
+public:
+	// cap must be a power of two.
+	explicit SpscQueue(usize cap);
+
+	SpscQueue(const SpscQueue& copy) = delete;
+	SpscQueue& operator=(const SpscQueue& copy) = delete;
+
+	~SpscQueue();
+
+	/**
+	 * Moves value into the queue. Returns false and leaves value untouched if the queue is full. Producer thread only.
+	 */
+	OP_NO_DISCARD bool push(T&& value);
+
+	/**
+	 * Moves the oldest element out of the queue, or returns nullopt if it is empty. Consumer thread only.
+	 */
+	OP_NO_DISCARD Option<T> pop();
+
+	// Number of elements at the time of the call. Other threads may change it right after.
+	OP_NO_DISCARD usize len() const;
+	OP_NO_DISCARD OP_ALWAYS_INLINE bool is_empty() const { return len() == 0; }
+	OP_NO_DISCARD OP_ALWAYS_INLINE usize cap() const { return m_mask + 1; }
+
+private:
+	OP_ALWAYS_INLINE T* slot(usize position) const { return m_elements + (position & m_mask); }
+
+	T* m_elements;
+	usize m_mask;
+
+	// Written by the producer.
+	alignas(OP_CACHE_LINE_SIZE) Atomic<usize> m_push_position = 0;
+	usize m_cached_pop_position = 0;
+
+	// Written by the consumer.
+	alignas(OP_CACHE_LINE_SIZE) Atomic<usize> m_pop_position = 0;
+	usize m_cached_push_position = 0;
+};
+
+OP_CORE_NAMESPACE_END
+
+// Include the implementation
+#include "core/containers/spsc_queue.inl"
+
+// Export to op namespace
+OP_NAMESPACE_BEGIN
+using core::SpscQueue;
+OP_NAMESPACE_END
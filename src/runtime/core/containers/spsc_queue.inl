@@ -0,0 +1,61 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#include "core/os/memory.h"
+
+OP_CORE_NAMESPACE_BEGIN
+
+template <Movable T>
+SpscQueue<T>::SpscQueue(usize cap) : m_mask(cap - 1) {
+	OP_ASSERT(cap > 0 && (cap & (cap - 1)) == 0, "Capacity must be a power of two");
+
+	void* ptr = core::malloc(core::Layout::array<T>(cap));
+	m_elements = static_cast<T*>(ptr);
+}
+
+template <Movable T>
+SpscQueue<T>::~SpscQueue() {
+	while (pop().is_set()) {
+	}
+	core::free(m_elements);
+}
+
+template <Movable T>
+bool SpscQueue<T>::push(T&& value) {
+	const auto position = m_push_position.load(Order::Relaxed);
+	if (position - m_cached_pop_position > m_mask) {
+		m_cached_pop_position = m_pop_position.load(Order::Acquire);
+		if (position - m_cached_pop_position > m_mask) {
+			return false;
+		}
+	}
+
+	new (slot(position)) T(op::move(value));
+	m_push_position.store(position + 1, Order::Release);
+	return true;
+}
+
+template <Movable T>
+Option<T> SpscQueue<T>::pop() {
+	const auto position = m_pop_position.load(Order::Relaxed);
+	if (position == m_cached_push_position) {
+		m_cached_push_position = m_push_position.load(Order::Acquire);
+		if (position == m_cached_push_position) {
+			return nullopt;
+		}
+	}
+
+	auto* element = slot(position);
+	Option<T> result = op::move(*element);
+	element->~T();
+	m_pop_position.store(position + 1, Order::Release);
+	return result;
+}
+
+template <Movable T>
+usize SpscQueue<T>::len() const {
+	const auto pushed = m_push_position.load(Order::Acquire);
+	const auto popped = m_pop_position.load(Order::Acquire);
+	return pushed > popped ? pushed - popped : 0;
+}
+
+OP_CORE_NAMESPACE_END
@@ -9,12 +9,19 @@ OP_CORE_NAMESPACE_BEGIN
 
 class WStringView;
 
-class String {
+/**
+ * Owned, null terminated utf8 string.
+ *
+ * @tparam A The allocator the bytes are stored in.
+ */
+template <Allocator A = GlobalAllocator>
+class BasicString {
 public:
-	String() = default;
-	static String from(Vector<char>&& bytes);
-	static String from(const StringView& view);
-	static String from(const WStringView& view);
+	BasicString() = default;
+	explicit BasicString(A allocator) : m_bytes(allocator) {}
+	static BasicString from(Vector<char, A>&& bytes);
+	static BasicString from(const StringView& view, A allocator = A());
+	static BasicString from(const WStringView& view, A allocator = A());
 
 	operator Slice<char const>() const;
 	operator StringView() const;
@@ -35,15 +42,21 @@ public:
 	}
 
 	OP_ALWAYS_INLINE void reserve(usize amount) { m_bytes.reserve(amount + 1); }
-	String& push(Char c);
-	String& push(StringView string);
+	BasicString& push(Char c);
+	BasicString& push(StringView string);
 
 private:
-	Vector<char> m_bytes;
+	Vector<char, A> m_bytes;
 };
 
+using String = BasicString<>;
+
 OP_CORE_NAMESPACE_END
 
+// Include the implementation
+#include "core/containers/string.inl"
+
 OP_NAMESPACE_BEGIN
+using core::BasicString;
 using core::String;
 OP_NAMESPACE_END
\ No newline at end of file
@@ -1,13 +1,13 @@
 // Copyright Colby Hall. All Rights Reserved.
 
-#include "core/containers/string.h"
 #include "core/containers/wstring_view.h"
 
 OP_CORE_NAMESPACE_BEGIN
 
-String String::from(Vector<char>&& bytes) {
-	String string;
-	string.m_bytes = op::forward<Vector<char>>(bytes);
+template <Allocator A>
+BasicString<A> BasicString<A>::from(Vector<char, A>&& bytes) {
+	BasicString string(bytes.allocator());
+	string.m_bytes = op::forward<Vector<char, A>>(bytes);
 
 	// Add a null terminator if one is not found
 	if (!string.m_bytes.is_empty() && string.m_bytes[string.m_bytes.len() - 1] != 0) {
@@ -16,22 +16,25 @@ String String::from(Vector<char>&& bytes) {
 	return string;
 }
 
-String String::from(const StringView& view) {
-	String string;
+template <Allocator A>
+BasicString<A> BasicString<A>::from(const StringView& view, A allocator) {
+	BasicString string(allocator);
 	string.push(view);
 	return string;
 }
 
-String String::from(const WStringView& view) {
+template <Allocator A>
+BasicString<A> BasicString<A>::from(const WStringView& view, A allocator) {
 	// FIXME: Do proper utf16 decode
-	String ret;
+	BasicString ret(allocator);
 	ret.reserve(view.len());
 	for (auto c : view)
 		ret.push((Char)c);
 	return ret;
 }
 
-String::operator Slice<char const>() const {
+template <Allocator A>
+BasicString<A>::operator Slice<char const>() const {
 	Slice<char const> result = m_bytes;
 
 	// Exclude the null terminator
@@ -40,7 +43,8 @@ String::operator Slice<char const>() const {
 	return result;
 }
 
-String::operator StringView() const {
+template <Allocator A>
+BasicString<A>::operator StringView() const {
 	Slice<char const> bytes = m_bytes;
 
 	// Exclude the null terminator
@@ -49,7 +53,8 @@ String::operator StringView() const {
 	return { bytes };
 }
 
-String& String::push(Char c) {
+template <Allocator A>
+BasicString<A>& BasicString<A>::push(Char c) {
 	// Encode the utf32 character to an utf8 multi width character
 	u8 local[4] = {};
 	u32 error;
@@ -75,7 +80,8 @@ String& String::push(Char c) {
 	return *this;
 }
 
-String& String::push(StringView string) {
+template <Allocator A>
+BasicString<A>& BasicString<A>::push(StringView string) {
 	// Preallocate enough space for the entire string to reduce allocations
 	const usize slag = m_bytes.cap() - m_bytes.len();
 	if (slag < string.len()) {
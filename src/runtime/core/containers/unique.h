@@ -4,6 +4,7 @@
 
 #include "core/concepts.h"
 #include "core/os/memory.h"
+#include "core/slab.h"
 
 OP_CORE_NAMESPACE_BEGIN
 
@@ -21,7 +22,10 @@ public:
 	Unique& operator=(const Unique<Base>& copy) noexcept
 		requires std::is_copy_constructible_v<Base>;
 	template <typename Derived = Base>
-	Unique(Unique<Derived>&& move) noexcept : m_ptr(move.m_ptr) {
+	Unique(Unique<Derived>&& move) noexcept
+		: m_ptr(move.m_ptr)
+		, m_size(move.m_size)
+		, m_alignment(move.m_alignment) {
 		static_assert(std::is_base_of_v<Base, Derived>, "Base is not a base of Derived");
 
 		move.m_ptr = nullptr;
@@ -32,6 +36,8 @@ public:
 
 		Unique<Base> to_destroy = core::move(*this);
 		m_ptr = m.m_ptr;
+		m_size = m.m_size;
+		m_alignment = m.m_alignment;
 		m.m_ptr = nullptr;
 		return *this;
 	}
@@ -53,11 +59,14 @@ private:
 	friend class Unique;
 
 	OP_ALWAYS_INLINE explicit Unique(Base&& base) {
-		void* ptr = core::malloc(core::Layout::single<Base>);
+		void* ptr = SlabAllocator().malloc(core::Layout::single<Base>);
 		m_ptr = new (ptr) Base(op::forward<Base>(base));
 	}
 
 	Base* m_ptr;
+	// Layout of the type that was allocated, which may be derived from Base, so the block goes back to its size class.
+	u32 m_size = sizeof(Base);
+	u32 m_alignment = alignof(Base);
 };
 
 OP_CORE_NAMESPACE_END
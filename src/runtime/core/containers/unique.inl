@@ -7,7 +7,7 @@ Unique<Base>::Unique(const Unique<Base>& copy) noexcept
 	requires std::is_copy_constructible_v<Base>
 {
 	static_assert(!std::is_abstract_v<Base>, "Can ony perform copy with a concrete class");
-	void* ptr = core::malloc(core::Layout::single<Base>);
+	void* ptr = SlabAllocator().malloc(core::Layout::single<Base>);
 	m_ptr = new (ptr) Base(*copy);
 }
 
@@ -19,8 +19,10 @@ Unique<Base>& Unique<Base>::operator=(const Unique<Base>& copy) noexcept
 	Unique<Base> to_destroy = core::move(*this);
 	OP_UNUSED(to_destroy);
 
-	void* ptr = core::malloc(core::Layout::single<Base>);
+	void* ptr = SlabAllocator().malloc(core::Layout::single<Base>);
 	m_ptr = new (ptr) Base(*copy);
+	m_size = sizeof(Base);
+	m_alignment = alignof(Base);
 
 	return *this;
 }
@@ -34,7 +36,7 @@ template <typename Base>
 Unique<Base>::~Unique() {
 	if (m_ptr) {
 		m_ptr->~Base();
-		core::free(m_ptr);
+		SlabAllocator().free(m_ptr, core::Layout{ m_size, m_alignment });
 		m_ptr = nullptr;
 	}
 }
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "core/allocator.h"
 #include "core/concepts.h"
 #include "core/containers/option.h"
 #include "core/containers/slice.h"
@@ -11,19 +12,25 @@ OP_CORE_NAMESPACE_BEGIN
 /**
  * A dynamic array that can be resized at runtime.
  *
+ * Capacity grows geometrically so pushing is amortized O(1). Elements are relocated bitwise when the vector grows so
+ * they must not hold pointers into themselves.
+ *
  * @tparam Element The type of element to store in the vector.
+ * @tparam A The allocator the elements are stored in.
  */
-template <Movable Element>
+template <Movable Element, Allocator A = GlobalAllocator>
 class Vector {
 public:
 	Vector() = default;
+	explicit Vector(A allocator) : m_allocator(allocator) {}
 
 	/**
-	 * Constructs a vector with the specified capacity.
+	 * Constructs a vector holding a copy of every element in slice.
 	 *
-	 * @param capacity The capacity of the vector.
+	 * @param slice The elements to copy.
+	 * @param allocator The allocator the copies are stored in.
 	 */
-	static Vector from(Slice<const Element> slice);
+	static Vector from(Slice<const Element> slice, A allocator = A());
 
 	Vector(const Vector& copy) noexcept;
 	Vector& operator=(const Vector& copy) noexcept;
@@ -34,6 +41,7 @@ public:
 
 	OP_ALWAYS_INLINE usize len() const { return m_len; }
 	OP_ALWAYS_INLINE usize cap() const { return m_cap; }
+	OP_ALWAYS_INLINE const A& allocator() const { return m_allocator; }
 
 	OP_ALWAYS_INLINE bool is_empty() const { return len() == 0; }
 	OP_ALWAYS_INLINE operator bool() const { return !is_empty(); }
@@ -60,21 +68,41 @@ public:
 		return nullopt;
 	}
 
+	// Makes room for at least amount more elements without reallocating.
 	OP_ALWAYS_INLINE void reserve(usize amount);
+	// Reallocates so the capacity matches the length, freeing the memory entirely when empty.
+	void shrink_to_fit();
 
 	void insert(usize index, Element&& item);
 	OP_ALWAYS_INLINE void insert(usize index, const Element& item_to_copy);
 	OP_ALWAYS_INLINE usize push(Element&& item);
 	OP_ALWAYS_INLINE usize push(const Element& item);
+	template <typename... Args>
+		requires std::is_constructible_v<Element, Args&&...>
+	OP_ALWAYS_INLINE Element& emplace(Args&&... args);
+	// Appends a copy of every element in slice. slice must not point into this vector.
+	void extend(Slice<const Element> slice);
+
+	// Grows by default constructing or shrinks by dropping elements from the back until len() == new_len.
+	void resize(usize new_len)
+		requires std::is_default_constructible_v<Element>;
+	void resize(usize new_len, const Element& value);
+	// Drops every element past new_len. Does nothing if the vector is already shorter.
+	void truncate(usize new_len);
 
 	Element remove(usize index);
 	OP_ALWAYS_INLINE Option<Element> pop();
-	void reset();
+	// Drops every element but keeps the capacity.
+	OP_ALWAYS_INLINE void reset() { truncate(0); }
 
 private:
+	void grow(usize min_cap);
+	void set_cap(usize new_cap);
+
 	Element* m_ptr = nullptr;
 	usize m_len = 0;
 	usize m_cap = 0;
+	OP_NO_UNIQUE_ADDRESS A m_allocator;
 };
 
 OP_CORE_NAMESPACE_END
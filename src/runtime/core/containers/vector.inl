@@ -4,193 +4,252 @@
 
 OP_CORE_NAMESPACE_BEGIN
 
-template <Movable Element>
-Vector<Element> Vector<Element>::from(Slice<const Element> slice) {
-	Vector<Element> result;
-
-	result.m_len = slice.len();
-	result.reserve(result.len());
-
-	for (usize i = 0; i < slice.len(); ++i) {
-		new (result.begin() + i) Element(slice[i]);
-	}
-
+template <Movable Element, Allocator A>
+Vector<Element, A> Vector<Element, A>::from(Slice<const Element> slice, A allocator) {
+	Vector<Element, A> result(allocator);
+	result.extend(slice);
 	return result;
 }
 
-template <Movable Element>
-Vector<Element>::Vector(const Vector& copy) noexcept : m_len(copy.m_len) {
-	reserve(copy.m_cap);
-	for (usize i = 0; i < m_len; ++i) {
-		new (m_ptr + i) Element(copy[i]);
-	}
+template <Movable Element, Allocator A>
+Vector<Element, A>::Vector(const Vector& copy) noexcept : m_allocator(copy.m_allocator) {
+	extend(copy);
 }
 
-template <Movable Element>
-Vector<Element>& Vector<Element>::operator=(const Vector& copy) noexcept {
-	auto to_destroy = op::move(*this);
-	OP_UNUSED(to_destroy);
-
-	m_len = copy.m_len;
-	reserve(copy.m_cap);
-	for (usize i = 0; i < m_len; ++i) {
-		new (m_ptr + i) Element(copy[i]);
+template <Movable Element, Allocator A>
+Vector<Element, A>& Vector<Element, A>::operator=(const Vector& copy) noexcept {
+	if (this != &copy) {
+		Vector to_copy = copy;
+		*this = op::move(to_copy);
 	}
-
 	return *this;
 }
 
-template <Movable Element>
-Vector<Element>::Vector(Vector&& move) noexcept : m_ptr(move.m_ptr)
-												, m_len(move.m_len)
-												, m_cap(move.m_cap) {
+template <Movable Element, Allocator A>
+Vector<Element, A>::Vector(Vector&& move) noexcept : m_ptr(move.m_ptr)
+												   , m_len(move.m_len)
+												   , m_cap(move.m_cap)
+												   , m_allocator(move.m_allocator) {
 	move.m_ptr = nullptr;
 	move.m_len = 0;
 	move.m_cap = 0;
 }
 
-template <Movable Element>
-Vector<Element>& Vector<Element>::operator=(Vector&& move) noexcept {
-	auto to_destroy = op::move(*this);
-	OP_UNUSED(to_destroy);
+template <Movable Element, Allocator A>
+Vector<Element, A>& Vector<Element, A>::operator=(Vector&& move) noexcept {
+	if (this != &move) {
+		auto to_destroy = op::move(*this);
+		OP_UNUSED(to_destroy);
 
-	m_ptr = move.m_ptr;
-	m_len = move.m_len;
-	m_cap = move.m_cap;
+		m_ptr = move.m_ptr;
+		m_len = move.m_len;
+		m_cap = move.m_cap;
+		m_allocator = move.m_allocator;
 
-	move.m_ptr = 0;
-	move.m_len = 0;
-	move.m_cap = 0;
+		move.m_ptr = nullptr;
+		move.m_len = 0;
+		move.m_cap = 0;
+	}
 	return *this;
 }
 
-template <Movable Element>
-Vector<Element>::~Vector() {
-	for (usize i = 0; i < m_len; ++i) {
-		Element& item = m_ptr[i];
-		item.~Element();
-	}
+template <Movable Element, Allocator A>
+Vector<Element, A>::~Vector() {
+	truncate(0);
 
 	if (m_ptr) {
-		core::free(m_ptr);
+		m_allocator.free(m_ptr, core::Layout::array<Element>(m_cap));
 		m_ptr = nullptr;
+		m_cap = 0;
 	}
 }
 
-template <Movable Element>
-OP_ALWAYS_INLINE bool Vector<Element>::is_valid_index(usize index) const {
+template <Movable Element, Allocator A>
+OP_ALWAYS_INLINE bool Vector<Element, A>::is_valid_index(usize index) const {
 	return index < len();
 }
 
-template <Movable Element>
-OP_ALWAYS_INLINE Vector<Element>::operator Slice<Element>() {
+template <Movable Element, Allocator A>
+OP_ALWAYS_INLINE Vector<Element, A>::operator Slice<Element>() {
 	return { m_ptr, m_len };
 }
 
-template <Movable Element>
-OP_ALWAYS_INLINE Vector<Element>::operator Slice<Element const>() const {
+template <Movable Element, Allocator A>
+OP_ALWAYS_INLINE Vector<Element, A>::operator Slice<Element const>() const {
 	return { m_ptr, m_len };
 }
 
-template <Movable Element>
-OP_ALWAYS_INLINE Element* Vector<Element>::begin() {
+template <Movable Element, Allocator A>
+OP_ALWAYS_INLINE Element* Vector<Element, A>::begin() {
 	return m_ptr;
 }
 
-template <Movable Element>
-OP_ALWAYS_INLINE Element* Vector<Element>::end() {
+template <Movable Element, Allocator A>
+OP_ALWAYS_INLINE Element* Vector<Element, A>::end() {
 	return m_ptr + m_len;
 }
 
-template <Movable Element>
-OP_ALWAYS_INLINE const Element* Vector<Element>::begin() const {
+template <Movable Element, Allocator A>
+OP_ALWAYS_INLINE const Element* Vector<Element, A>::begin() const {
 	return m_ptr;
 }
 
-template <Movable Element>
-OP_ALWAYS_INLINE const Element* Vector<Element>::end() const {
+template <Movable Element, Allocator A>
+OP_ALWAYS_INLINE const Element* Vector<Element, A>::end() const {
 	return m_ptr + m_len;
 }
 
-template <Movable Element>
-OP_ALWAYS_INLINE Element& Vector<Element>::operator[](usize index) {
+template <Movable Element, Allocator A>
+OP_ALWAYS_INLINE Element& Vector<Element, A>::operator[](usize index) {
 	OP_ASSERT(is_valid_index(index), "Index out of bounds");
 	return m_ptr[index];
 }
 
-template <Movable Element>
-OP_ALWAYS_INLINE const Element& Vector<Element>::operator[](usize index) const {
+template <Movable Element, Allocator A>
+OP_ALWAYS_INLINE const Element& Vector<Element, A>::operator[](usize index) const {
 	OP_ASSERT(is_valid_index(index), "Index out of bounds");
 	return m_ptr[index];
 }
 
-template <Movable Element>
-OP_ALWAYS_INLINE void Vector<Element>::reserve(usize amount) {
-	const auto desired = m_cap + amount;
-	const auto old_cap = m_cap;
-	while (m_cap < desired) {
-		m_cap += desired >> 1;
-		m_cap += 1;
+template <Movable Element, Allocator A>
+OP_ALWAYS_INLINE void Vector<Element, A>::reserve(usize amount) {
+	const auto desired = m_len + amount;
+	if (desired > m_cap) {
+		grow(desired);
 	}
+}
 
-	if (m_ptr == nullptr) {
-		void* ptr = core::malloc(core::Layout::array<Element>(m_cap));
-		m_ptr = static_cast<Element*>(ptr);
-	} else {
-		void* ptr = core::realloc(m_ptr, core::Layout::array<Element>(old_cap), core::Layout::array<Element>(m_cap));
-		m_ptr = static_cast<Element*>(ptr);
+template <Movable Element, Allocator A>
+void Vector<Element, A>::shrink_to_fit() {
+	if (m_cap > m_len) {
+		set_cap(m_len);
 	}
 }
 
-template <Movable Element>
-void Vector<Element>::insert(usize index, Element&& item) {
+template <Movable Element, Allocator A>
+void Vector<Element, A>::insert(usize index, Element&& item) {
 	OP_ASSERT(index <= m_len);
-	if (len() == cap()) reserve(1);
+	if (m_len == m_cap) grow(m_len + 1);
 
 	auto* src = m_ptr + index;
-	if (index != len()) {
-		core::move(src + 1, src, (len() - index) * sizeof(Element));
-		core::set(src, 0, sizeof(Element));
+	if (index != m_len) {
+		core::move(src + 1, src, (m_len - index) * sizeof(Element));
 	}
 
 	new (src) Element(op::forward<Element>(item));
 	m_len += 1;
 }
 
-template <Movable Element>
-OP_ALWAYS_INLINE void Vector<Element>::insert(usize index, const Element& item) {
+template <Movable Element, Allocator A>
+OP_ALWAYS_INLINE void Vector<Element, A>::insert(usize index, const Element& item) {
 	Element copy = item;
 	insert(index, op::move(copy));
 }
 
-template <Movable Element>
-OP_ALWAYS_INLINE usize Vector<Element>::push(Element&& item) {
-	const auto index = len();
-	insert(index, op::move(item));
-	return index;
+template <Movable Element, Allocator A>
+OP_ALWAYS_INLINE usize Vector<Element, A>::push(Element&& item) {
+	if (m_len == m_cap) grow(m_len + 1);
+
+	new (m_ptr + m_len) Element(op::forward<Element>(item));
+	m_len += 1;
+	return m_len - 1;
 }
 
-template <Movable Element>
-OP_ALWAYS_INLINE usize Vector<Element>::push(const Element& item) {
+template <Movable Element, Allocator A>
+OP_ALWAYS_INLINE usize Vector<Element, A>::push(const Element& item) {
 	Element copy = item;
 	return push(op::move(copy));
 }
 
-template <Movable Element>
-Element Vector<Element>::remove(usize index) {
+template <Movable Element, Allocator A>
+template <typename... Args>
+	requires std::is_constructible_v<Element, Args&&...>
+OP_ALWAYS_INLINE Element& Vector<Element, A>::emplace(Args&&... args) {
+	if (m_len == m_cap) grow(m_len + 1);
+
+	auto* result = new (m_ptr + m_len) Element(op::forward<Args>(args)...);
+	m_len += 1;
+	return *result;
+}
+
+template <Movable Element, Allocator A>
+void Vector<Element, A>::extend(Slice<const Element> slice) {
+	if (slice.len() == 0) {
+		return;
+	}
+	OP_ASSERT(slice.begin() >= end() || slice.end() <= begin(), "Can not extend a vector with its own elements");
+
+	reserve(slice.len());
+	if constexpr (std::is_trivially_copyable_v<Element>) {
+		core::copy(m_ptr + m_len, slice.begin(), slice.len() * sizeof(Element));
+	} else {
+		for (usize i = 0; i < slice.len(); ++i) {
+			new (m_ptr + m_len + i) Element(slice[i]);
+		}
+	}
+	m_len += slice.len();
+}
+
+template <Movable Element, Allocator A>
+void Vector<Element, A>::resize(usize new_len)
+	requires std::is_default_constructible_v<Element>
+{
+	if (new_len <= m_len) {
+		truncate(new_len);
+		return;
+	}
+
+	reserve(new_len - m_len);
+	if constexpr (std::is_trivially_default_constructible_v<Element>) {
+		core::set(m_ptr + m_len, 0, (new_len - m_len) * sizeof(Element));
+	} else {
+		for (usize i = m_len; i < new_len; ++i) {
+			new (m_ptr + i) Element();
+		}
+	}
+	m_len = new_len;
+}
+
+template <Movable Element, Allocator A>
+void Vector<Element, A>::resize(usize new_len, const Element& value) {
+	if (new_len <= m_len) {
+		truncate(new_len);
+		return;
+	}
+
+	reserve(new_len - m_len);
+	for (usize i = m_len; i < new_len; ++i) {
+		new (m_ptr + i) Element(value);
+	}
+	m_len = new_len;
+}
+
+template <Movable Element, Allocator A>
+void Vector<Element, A>::truncate(usize new_len) {
+	if (new_len >= m_len) {
+		return;
+	}
+
+	if constexpr (!std::is_trivially_destructible_v<Element>) {
+		for (usize i = new_len; i < m_len; ++i) {
+			m_ptr[i].~Element();
+		}
+	}
+	m_len = new_len;
+}
+
+template <Movable Element, Allocator A>
+Element Vector<Element, A>::remove(usize index) {
 	OP_ASSERT(is_valid_index(index), "Index out of bounds");
 
 	// Move element out of vector to be returned
-	auto result = op::move(m_ptr[index]);
-
-	// Set memory that element used to occupy to 0
-	void* clear = &m_ptr[index];
-	core::set(clear, 0, sizeof(Element));
+	auto* src = m_ptr + index;
+	auto result = op::move(*src);
+	src->~Element();
 
-	// If not removed from the end of the vector copy entire array over
+	// If not removed from the end of the vector shift the elements after it down to close the gap
 	if (index < m_len - 1) {
-		auto* src = m_ptr + index;
-		op::core::move(src, src + 1, (len() - index) * sizeof(Element));
+		core::move(src, src + 1, (m_len - index - 1) * sizeof(Element));
 	}
 
 	// Decrement length
@@ -199,21 +258,44 @@ Element Vector<Element>::remove(usize index) {
 	return result;
 }
 
-template <Movable Element>
-OP_ALWAYS_INLINE Option<Element> Vector<Element>::pop() {
+template <Movable Element, Allocator A>
+OP_ALWAYS_INLINE Option<Element> Vector<Element, A>::pop() {
 	if (m_len > 0) {
 		m_len -= 1;
-		return op::move(m_ptr[m_len]);
+		Option<Element> result = op::move(m_ptr[m_len]);
+		m_ptr[m_len].~Element();
+		return result;
 	}
-	return nullptr;
+	return nullopt;
 }
 
-template <Movable Element>
-void Vector<Element>::reset() {
-	const i32 count = static_cast<i32>(len());
-	for (i32 i = count - 1; i >= 0; i -= 1) {
-		remove(static_cast<usize>(i));
+template <Movable Element, Allocator A>
+void Vector<Element, A>::grow(usize min_cap) {
+	// Small vectors start with a few elements of capacity rather than growing 1, 2, 4.
+	constexpr usize min_non_zero_cap = sizeof(Element) == 1 ? 8 : (sizeof(Element) <= 1024 ? 4 : 1);
+
+	auto new_cap = m_cap * 2;
+	if (new_cap < min_cap) new_cap = min_cap;
+	if (new_cap < min_non_zero_cap) new_cap = min_non_zero_cap;
+	set_cap(new_cap);
+}
+
+template <Movable Element, Allocator A>
+void Vector<Element, A>::set_cap(usize new_cap) {
+	OP_ASSERT(new_cap >= m_len);
+
+	if (new_cap == 0) {
+		if (m_ptr) m_allocator.free(m_ptr, core::Layout::array<Element>(m_cap));
+		m_ptr = nullptr;
+	} else if (m_ptr == nullptr) {
+		void* ptr = m_allocator.malloc(core::Layout::array<Element>(new_cap));
+		m_ptr = static_cast<Element*>(ptr);
+	} else {
+		void* ptr =
+			m_allocator.realloc(m_ptr, core::Layout::array<Element>(m_cap), core::Layout::array<Element>(new_cap));
+		m_ptr = static_cast<Element*>(ptr);
 	}
+	m_cap = new_cap;
 }
 
 OP_CORE_NAMESPACE_END
@@ -5,12 +5,22 @@ set(CORE_ROOT ${RUNTIME_ROOT}/core)
 set(CORE_SRC_FILES
         ${CORE_ROOT}/containers/array.h
         ${CORE_ROOT}/containers/array.inl
+        ${CORE_ROOT}/containers/bit_vector.h
+        ${CORE_ROOT}/containers/bit_vector.inl
+        ${CORE_ROOT}/containers/bit_vector.cpp
+        ${CORE_ROOT}/containers/bitset.h
+        ${CORE_ROOT}/containers/concurrent_slot_map.h
+        ${CORE_ROOT}/containers/concurrent_slot_map.inl
         ${CORE_ROOT}/containers/function.h
         ${CORE_ROOT}/containers/function.inl
         ${CORE_ROOT}/containers/map.h
         ${CORE_ROOT}/containers/map.inl
+        ${CORE_ROOT}/containers/mpmc_queue.h
+        ${CORE_ROOT}/containers/mpmc_queue.inl
         ${CORE_ROOT}/containers/non_null.h
         ${CORE_ROOT}/containers/option.h
+        ${CORE_ROOT}/containers/paged_vector.h
+        ${CORE_ROOT}/containers/paged_vector.inl
         ${CORE_ROOT}/containers/result.h
         ${CORE_ROOT}/containers/shared.h
         ${CORE_ROOT}/containers/shared.inl
@@ -18,10 +28,14 @@ set(CORE_SRC_FILES
         ${CORE_ROOT}/containers/slice.inl
         ${CORE_ROOT}/containers/slot_map.h
         ${CORE_ROOT}/containers/slot_map.inl
+        ${CORE_ROOT}/containers/small_vector.h
+        ${CORE_ROOT}/containers/small_vector.inl
+        ${CORE_ROOT}/containers/spsc_queue.h
+        ${CORE_ROOT}/containers/spsc_queue.inl
         ${CORE_ROOT}/containers/string_view.h
         ${CORE_ROOT}/containers/string_view.cpp
         ${CORE_ROOT}/containers/string.h
-        ${CORE_ROOT}/containers/string.cpp
+        ${CORE_ROOT}/containers/string.inl
         ${CORE_ROOT}/containers/tuple.h
         ${CORE_ROOT}/containers/unique.h
         ${CORE_ROOT}/containers/unique.inl
@@ -48,18 +62,27 @@ set(CORE_SRC_FILES
         ${CORE_ROOT}/math/vector4.h
         ${CORE_ROOT}/math/vector4.inl
 
+        ${CORE_ROOT}/os/cpu.h
+        ${CORE_ROOT}/os/cpu.cpp
+        ${CORE_ROOT}/os/fiber.h
+        ${CORE_ROOT}/os/fiber.cpp
         ${CORE_ROOT}/os/file_system.h
         ${CORE_ROOT}/os/file_system.cpp
         ${CORE_ROOT}/os/library.h
         ${CORE_ROOT}/os/library.cpp
         ${CORE_ROOT}/os/memory.h
         ${CORE_ROOT}/os/memory.cpp
+        ${CORE_ROOT}/os/memory_tracking.h
+        ${CORE_ROOT}/os/memory_tracking.cpp
 		${CORE_ROOT}/os/thread.h
         ${CORE_ROOT}/os/thread.cpp
         ${CORE_ROOT}/os/time.h
         ${CORE_ROOT}/os/time.cpp
         ${CORE_ROOT}/os/windows.h
 
+        ${CORE_ROOT}/allocator.h
+        ${CORE_ROOT}/arena.h
+        ${CORE_ROOT}/arena.cpp
         ${CORE_ROOT}/atomic.h
         ${CORE_ROOT}/atomic.inl
 		${CORE_ROOT}/concepts.h
@@ -68,10 +91,18 @@ set(CORE_SRC_FILES
         ${CORE_ROOT}/core.h
         ${CORE_ROOT}/core.natvis
         ${CORE_ROOT}/hash.h
-        ${CORE_ROOT}/hash.cpp
+        ${CORE_ROOT}/hash.inl
         ${CORE_ROOT}/initializer_list.h
         ${CORE_ROOT}/interface.h
+        ${CORE_ROOT}/job_system.h
+        ${CORE_ROOT}/job_system.inl
+        ${CORE_ROOT}/job_system.cpp
         ${CORE_ROOT}/non_copyable.h
+        ${CORE_ROOT}/slab.h
+        ${CORE_ROOT}/slab.cpp
+        ${CORE_ROOT}/task.h
+        ${CORE_ROOT}/task.inl
+        ${CORE_ROOT}/task.cpp
         ${CORE_ROOT}/type_traits.h
 )
 
@@ -87,3 +118,13 @@ source_group(TREE ${CORE_ROOT} FILES ${CORE_SRC_FILES})
 add_library(core STATIC ${CORE_SRC_FILES})
 target_include_directories(core PUBLIC ${RUNTIME_ROOT})
 set_target_properties(core PROPERTIES FOLDER "runtime")
+
+if (NOT "${CMAKE_SYSTEM_NAME}" STREQUAL "Windows")
+    # Library is built on dlopen and Thread on pthreads
+    find_package(Threads REQUIRED)
+    target_link_libraries(core PUBLIC ${CMAKE_DL_LIBS} Threads::Threads)
+endif ()
+
+if (ENABLE_MEMORY_TRACKING)
+    target_compile_definitions(core PUBLIC OP_ENABLE_MEMORY_TRACKING)
+endif ()
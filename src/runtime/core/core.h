@@ -3,7 +3,9 @@
 #pragma once
 
 // Determine platform
-#if defined(_WIN32) || defined(_WIN64)
+#if defined(__linux__)
+	#define OP_PLATFORM_LINUX 1
+#elif defined(_WIN32) || defined(_WIN64)
 	#include <winapifamily.h>
 	#if WINAPI_FAMILY == WINAPI_FAMILY_APP
 		#define OP_PLATFORM_WINDOWS_UWP
@@ -15,12 +17,17 @@
 #ifndef OP_PLATFORM_WINDOWS
 	#define OP_PLATFORM_WINDOWS 0
 #endif
+#ifndef OP_PLATFORM_LINUX
+	#define OP_PLATFORM_LINUX 0
+#endif
 
 // Determine compiler
 #if defined(__clang__)
 	#define OP_COMPILER_CLANG 1
 #elif defined(_MSC_VER)
 	#define OP_COMPILER_MSVC 1
+#elif defined(__GNUC__)
+	#define OP_COMPILER_GCC 1
 #else
 	#error Unsupported compiler
 #endif
@@ -61,6 +68,13 @@
 	#define OP_CLANG_SUPPRESS_WARNING(w)
 #endif
 
+// GCC rejects pragmas in the statement positions these are used in and no warnings are suppressed for it
+#if OP_COMPILER_GCC
+	#define OP_PRAGMA(x) _Pragma(#x)
+	#define OP_SUPPRESS_WARNING_PUSH
+	#define OP_SUPPRESS_WARNING_POP
+#endif
+
 #if OP_COMPILER_MSVC
 	#define OP_PRAGMA(x)				__pragma(x)
 	#define OP_SUPPRESS_WARNING_PUSH	OP_PRAGMA(warning(push))
@@ -71,7 +85,7 @@
 #endif
 
 // Define inline macro
-#if OP_COMPILER_CLANG
+#if OP_COMPILER_CLANG || OP_COMPILER_GCC
 	#define OP_ALWAYS_INLINE __inline__ __attribute__((always_inline))
 #elif OP_COMPILER_MSVC
 	#define OP_ALWAYS_INLINE __forceinline
@@ -79,8 +93,21 @@
 	#error Undefined inline
 #endif
 
+#if OP_COMPILER_CLANG || OP_COMPILER_GCC
+	#define OP_NO_INLINE __attribute__((noinline))
+#elif OP_COMPILER_MSVC
+	#define OP_NO_INLINE __declspec(noinline)
+#endif
+
 #define OP_NO_DISCARD [[nodiscard]]
 
+// Lets empty members such as stateless allocators take up no space
+#if OP_COMPILER_MSVC
+	#define OP_NO_UNIQUE_ADDRESS [[msvc::no_unique_address]]
+#else
+	#define OP_NO_UNIQUE_ADDRESS [[no_unique_address]]
+#endif
+
 // Cache line size (used for aligning to cache line)
 #ifndef OP_CACHE_LINE_SIZE
 	#define OP_CACHE_LINE_SIZE 64
@@ -98,6 +125,8 @@
 // OS-specific includes
 #if OP_PLATFORM_WINDOWS
 	#define OP_BREAKPOINT __debugbreak()
+#elif OP_PLATFORM_LINUX
+	#define OP_BREAKPOINT __builtin_trap()
 #else
 	#error Unknown platform
 #endif
@@ -108,7 +137,11 @@
 	#define OP_BUILD_DEBUG 0
 #endif
 
-#define OP_THREAD_LOCAL __declspec(thread)
+#if OP_PLATFORM_WINDOWS
+	#define OP_THREAD_LOCAL __declspec(thread)
+#else
+	#define OP_THREAD_LOCAL __thread
+#endif
 
 // Macro to indicate that a parameter / variable is unused
 #define OP_UNUSED(x) (void)x
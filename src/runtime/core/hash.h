@@ -2,42 +2,88 @@
 
 #pragma once
 
+#include "core/concepts.h"
 #include "core/containers/slice.h"
 #include "core/type_traits.h"
 
+OP_NAMESPACE_BEGIN
+
+/**
+ * Streaming 64 bit hash state. Hashers are used through their concrete type so write and finish inline into Hash and
+ * Map instead of going through a vtable.
+ */
+template <typename H>
+concept Hasher = std::default_initializable<H> && requires(H hasher, Slice<u8 const> bytes) {
+	hasher.write(bytes);
+	{ hasher.finish() } -> SameAs<u64>;
+};
+
+OP_NAMESPACE_END
+
 OP_CORE_NAMESPACE_BEGIN
 
-class Hasher {
+/**
+ * 64 bit FNV-1. Simple but processes a single byte per step, prefer WyHasher for anything performance sensitive.
+ */
+class FNV1Hasher {
 public:
-	virtual u64 finish() = 0;
-	virtual void write(Slice<u8 const> bytes) = 0;
-	virtual ~Hasher() = default;
+	constexpr FNV1Hasher() = default;
+
+	static constexpr u64 offset_basic = 0xcbf29ce484222325;
+	static constexpr u64 prime = 0x100000001b3;
+
+	// Hasher
+	OP_NO_DISCARD OP_ALWAYS_INLINE u64 finish() const { return m_result; }
+	void write(Slice<u8 const> bytes);
+	// ~Hasher
+
+private:
+	u64 m_result = offset_basic;
 };
 
-class FNV1Hasher final : public Hasher {
+/**
+ * 64 bit hasher built on wyhash's multiply-mix. Input is consumed 32 bytes per step and the tail up to 16 bytes at a
+ * time, so short keys finish in a couple of multiplies.
+ *
+ * Streaming state is kept between writes so the result only depends on the bytes written, not on how they were split
+ * across calls. finish does not modify the state and may be called more than once.
+ */
+class WyHasher {
 public:
-	constexpr FNV1Hasher() = default;
+	constexpr WyHasher() = default;
+	explicit constexpr WyHasher(u64 seed) : m_state(seed ^ secret[0]) {}
 
-	static const u64 offset_basic;
-	static const u64 prime;
+	static constexpr u64 secret[4] = { 0xa0761d6478bd642f, 0xe7037ed1a0b428db, 0x8ebc6af09c88c6e3, 0x589965cc75374cc3 };
+	static constexpr usize stripe_len = 32;
 
 	// Hasher
-	u64 finish() final;
-	void write(Slice<u8 const> bytes) final;
+	OP_NO_DISCARD u64 finish() const;
+	void write(Slice<u8 const> bytes);
 	// ~Hasher
 
 private:
-	u64 m_result = 0;
+	void consume(u8 const* stripe);
+
+	u64 m_state = secret[0];
+	u64 m_len = 0;
+	u8 m_buffer[stripe_len] = {};
+	usize m_buffer_len = 0;
 };
 
 OP_CORE_NAMESPACE_END
 
+// Include the implementation
+#include "core/hash.inl"
+
 // Implement hash for op primitives
 OP_NAMESPACE_BEGIN
 
+using core::FNV1Hasher;
+using core::WyHasher;
+
 template <typename H, typename T>
 struct Hash {
-	void operator()(H& hasher, const T& value) {
+	OP_ALWAYS_INLINE void operator()(H& hasher, const T& value) {
 		static_assert(
 			std::is_trivially_copyable_v<T>,
 			"Hashing requires trivially copyable types or custom hash specialization"
@@ -46,4 +92,15 @@ struct Hash {
 	}
 };
 
+/**
+ * Hashes a single value with a fresh H.
+ */
+template <Hasher H = WyHasher, typename T>
+OP_NO_DISCARD OP_ALWAYS_INLINE u64 hash(const T& value) {
+	H hasher;
+	Hash<H, T> hash;
+	hash(hasher, value);
+	return hasher.finish();
+}
+
 OP_NAMESPACE_END
\ No newline at end of file
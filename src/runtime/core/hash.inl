@@ -0,0 +1,115 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#include <cstring>
+
+#if OP_COMPILER_MSVC
+	#include <intrin.h>
+#endif
+
+OP_CORE_NAMESPACE_BEGIN
+
+OP_HIDDEN_NAMESPACE_BEGIN
+
+// Multiplies to 128 bits and folds the halves together.
+OP_ALWAYS_INLINE u64 wy_mix(u64 a, u64 b) {
+#if OP_COMPILER_MSVC
+	u64 high;
+	const u64 low = _umul128(a, b, &high);
+	return low ^ high;
+#else
+	const auto result = static_cast<unsigned __int128>(a) * b;
+	return static_cast<u64>(result) ^ static_cast<u64>(result >> 64);
+#endif
+}
+
+OP_ALWAYS_INLINE u64 wy_read_u64(u8 const* bytes) {
+	u64 result;
+	std::memcpy(&result, bytes, sizeof(result));
+	return result;
+}
+
+OP_ALWAYS_INLINE u64 wy_read_u32(u8 const* bytes) {
+	u32 result;
+	std::memcpy(&result, bytes, sizeof(result));
+	return result;
+}
+
+OP_HIDDEN_NAMESPACE_END
+
+inline void FNV1Hasher::write(Slice<u8 const> bytes) {
+	auto hash = m_result;
+	for (usize i = 0; i < bytes.len(); ++i) {
+		hash *= FNV1Hasher::prime;
+		hash = hash ^ bytes[i];
+	}
+	m_result = hash;
+}
+
+inline u64 WyHasher::finish() const {
+	auto state = m_state;
+	u8 const* tail = m_buffer;
+	auto len = m_buffer_len;
+
+	while (len > 16) {
+		state = hidden::wy_mix(hidden::wy_read_u64(tail) ^ secret[1], hidden::wy_read_u64(tail + 8) ^ state);
+		tail += 16;
+		len -= 16;
+	}
+
+	// Read the last 0 to 16 bytes as two possibly overlapping words.
+	u64 a = 0;
+	u64 b = 0;
+	if (len > 8) {
+		a = hidden::wy_read_u64(tail);
+		b = hidden::wy_read_u64(tail + len - 8);
+	} else if (len >= 4) {
+		a = hidden::wy_read_u32(tail);
+		b = hidden::wy_read_u32(tail + len - 4);
+	} else if (len > 0) {
+		a = (static_cast<u64>(tail[0]) << 16) | (static_cast<u64>(tail[len >> 1]) << 8) | tail[len - 1];
+	}
+
+	return hidden::wy_mix(secret[1] ^ m_len, hidden::wy_mix(a ^ secret[1], b ^ state));
+}
+
+inline void WyHasher::write(Slice<u8 const> bytes) {
+	auto* data = bytes.begin();
+	auto len = bytes.len();
+	if (len == 0) {
+		return;
+	}
+	m_len += len;
+
+	// Top up a partially filled stripe first.
+	if (m_buffer_len > 0) {
+		const auto needed = stripe_len - m_buffer_len;
+		const auto taken = len < needed ? len : needed;
+		std::memcpy(m_buffer + m_buffer_len, data, taken);
+		m_buffer_len += taken;
+		data += taken;
+		len -= taken;
+
+		// Keep the last stripe buffered so finish always has the tail available.
+		if (m_buffer_len < stripe_len || len == 0) {
+			return;
+		}
+		consume(m_buffer);
+		m_buffer_len = 0;
+	}
+
+	while (len > stripe_len) {
+		consume(data);
+		data += stripe_len;
+		len -= stripe_len;
+	}
+
+	std::memcpy(m_buffer, data, len);
+	m_buffer_len = len;
+}
+
+inline void WyHasher::consume(u8 const* stripe) {
+	m_state = hidden::wy_mix(hidden::wy_read_u64(stripe) ^ secret[1], hidden::wy_read_u64(stripe + 8) ^ m_state) ^
+			  hidden::wy_mix(hidden::wy_read_u64(stripe + 16) ^ secret[2], hidden::wy_read_u64(stripe + 24) ^ m_state);
+}
+
+OP_CORE_NAMESPACE_END
@@ -0,0 +1,622 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#include "core/job_system.h"
+#include "core/math/math.h"
+#include "core/os/fiber.h"
+#include "core/slab.h"
+
+OP_CORE_NAMESPACE_BEGIN
+
+// Jobs a worker's deque can hold. Jobs scheduled past that go through the shared queue.
+static constexpr isize deque_cap = 4096;
+static constexpr usize injected_cap = 4096;
+// Rounds of looking for work in vain before a thread blocks.
+static constexpr u32 spin_rounds = 64;
+
+OP_HIDDEN_NAMESPACE_BEGIN
+
+struct Job {
+	Function<void()> function;
+	// Null for jobs nobody waits on.
+	JobCounter* counter;
+};
+
+/**
+ * Chase-Lev work stealing deque with a fixed capacity.
+ *
+ * The owner pushes and pops at the bottom without any read-modify-write. Thieves take from the top with a CAS, so the
+ * owner only races them for the very last job. The bottom is published with sequentially consistent operations on both
+ * sides, which keeps a thief from reading it before the owner's claim on the same job.
+ */
+class WorkStealingDeque {
+public:
+	// Owner only. Returns false if the deque is full.
+	bool push(Job* job) {
+		const auto bottom = m_bottom.load(Order::Relaxed);
+		const auto top = m_top.load(Order::Acquire);
+		if (bottom - top >= deque_cap) {
+			return false;
+		}
+
+		m_jobs[bottom & (deque_cap - 1)].store(job, Order::Relaxed);
+		m_bottom.store(bottom + 1, Order::Release);
+		return true;
+	}
+
+	// Owner only. Takes the newest job.
+	Job* pop() {
+		const auto bottom = m_bottom.load(Order::Relaxed) - 1;
+		m_bottom.store(bottom, Order::SeqCst);
+		const auto top = m_top.load(Order::SeqCst);
+		if (top > bottom) {
+			m_bottom.store(bottom + 1, Order::Relaxed);
+			return nullptr;
+		}
+
+		Job* job = m_jobs[bottom & (deque_cap - 1)].load(Order::Relaxed);
+		if (top == bottom) {
+			// The last job, which a thief may be taking right now.
+			if (!m_top.compare_exchange_strong(top, top + 1, Order::SeqCst).is_set()) {
+				job = nullptr;
+			}
+			m_bottom.store(bottom + 1, Order::Relaxed);
+		}
+		return job;
+	}
+
+	// Any thread. Takes the oldest job, or returns null if the deque is empty or another thread won the race for it.
+	Job* steal() {
+		const auto top = m_top.load(Order::SeqCst);
+		const auto bottom = m_bottom.load(Order::SeqCst);
+		if (top >= bottom) {
+			return nullptr;
+		}
+
+		Job* job = m_jobs[top & (deque_cap - 1)].load(Order::Relaxed);
+		if (!m_top.compare_exchange_strong(top, top + 1, Order::SeqCst).is_set()) {
+			return nullptr;
+		}
+		return job;
+	}
+
+	bool is_empty() const { return m_top.load(Order::SeqCst) >= m_bottom.load(Order::SeqCst); }
+
+private:
+	alignas(OP_CACHE_LINE_SIZE) Atomic<isize> m_top = 0;
+	alignas(OP_CACHE_LINE_SIZE) Atomic<isize> m_bottom = 0;
+	Atomic<Job*> m_jobs[deque_cap] = {};
+};
+struct JobFiber {
+	Fiber fiber;
+	JobSystem* system;
+	u32 index;
+	// Index plus one of the next fiber suspended on the same counter, or zero.
+	u32 next_waiter;
+};
+
+// Work left for the fiber being switched to, done once the fiber that switched away is off its stack.
+struct AfterSwitch {
+	// Goes back to the free fibers.
+	JobFiber* release = nullptr;
+	// Suspends on counter.
+	JobFiber* park = nullptr;
+	const JobCounter* counter = nullptr;
+};
+
+struct JobWorker {
+	JobSystem* system;
+	WorkStealingDeque deque;
+	// The worker thread's own stack, which it returns to on shutdown.
+	Fiber* thread_fiber;
+	JobFiber* running;
+	AfterSwitch after_switch;
+	// Workers in the same group share a last level cache and steal from each other first.
+	u32 l3_group;
+};
+
+OP_HIDDEN_NAMESPACE_END
+
+// Fibers per worker. Each job suspended in wait holds on to one.
+static constexpr usize fibers_per_worker = 16;
+
+static OP_THREAD_LOCAL hidden::JobWorker* t_worker = nullptr;
+static OP_THREAD_LOCAL u64 t_random_state = 0;
+
+// xorshift64. Only picks steal victims, so it does not need to be good, just cheap and different per thread.
+static u64 next_random() {
+	auto x = t_random_state;
+	if (x == 0) {
+		x = reinterpret_cast<u64>(&t_random_state) | 1;
+	}
+	x ^= x << 13;
+	x ^= x >> 7;
+	x ^= x << 17;
+	t_random_state = x;
+	return x;
+}
+
+static OP_ALWAYS_INLINE u32 pending_jobs(u64 state) { return static_cast<u32>(state); }
+static OP_ALWAYS_INLINE u32 first_waiter(u64 state) { return static_cast<u32>(state >> 32); }
+static OP_ALWAYS_INLINE u64 counter_state(u32 pending, u32 waiter) { return (static_cast<u64>(waiter) << 32) | pending; }
+
+/**
+ * Logical cores to pin the workers to. Fills one L3 group with a worker per physical core, then their SMT siblings,
+ * before it moves on to the next group, and takes the groups in NUMA node order. Workers that steal from each other
+ * share caches that way and stay on one socket for as long as possible. The first core is left to the thread that
+ * created the system, which works in wait.
+ *
+ * Empty if there are not enough cores for every thread to get its own, as pinning would only stack them up then.
+ */
+static Vector<LogicalCore> worker_placement(usize worker_count) {
+	const auto& topology = cpu_topology();
+	const auto& cores = topology.logical_cores;
+	Vector<LogicalCore> result;
+	if (worker_count + 1 > cores.len()) {
+		return result;
+	}
+
+	// How many SMT siblings come before each logical core on its physical core.
+	Vector<u32> sibling_rank;
+	sibling_rank.resize(cores.len());
+	u32 max_rank = 0;
+	for (usize index = 0; index < cores.len(); ++index) {
+		for (usize before = 0; before < index; ++before) {
+			sibling_rank[index] += cores[before].core == cores[index].core ? 1 : 0;
+		}
+		max_rank = max(max_rank, sibling_rank[index]);
+	}
+
+	Vector<LogicalCore> order;
+	order.reserve(cores.len());
+	for (u32 node = 0; node < topology.numa_node_count; ++node) {
+		for (u32 group = 0; group < topology.l3_group_count; ++group) {
+			for (u32 rank = 0; rank <= max_rank; ++rank) {
+				for (usize index = 0; index < cores.len(); ++index) {
+					const auto& core = cores[index];
+					if (core.numa_node == node && core.l3_group == group && sibling_rank[index] == rank) {
+						order.push(core);
+					}
+				}
+			}
+		}
+	}
+
+	result.reserve(worker_count);
+	for (usize index = 0; index < worker_count; ++index) {
+		result.push(order[index + 1]);
+	}
+	return result;
+}
+
+static String worker_name(usize index) {
+	char digits[20];
+	usize len = 0;
+	do {
+		digits[len++] = static_cast<char>('0' + index % 10);
+		index /= 10;
+	} while (index != 0);
+
+	auto result = String::from("Job Worker ");
+	while (len > 0) {
+		result.push(static_cast<Char>(digits[--len]));
+	}
+	return result;
+}
+
+// MpmcQueue needs a power of two, and the fiber queues must never be full.
+static usize fiber_queue_cap(usize worker_count) {
+	usize cap = 1;
+	while (cap < worker_count * fibers_per_worker) {
+		cap <<= 1;
+	}
+	return cap;
+}
+
+JobSystem::JobSystem(usize worker_count)
+	: m_workers(nullptr)
+	, m_worker_count(worker_count)
+	, m_injected(injected_cap)
+	, m_fibers(nullptr)
+	, m_fiber_count(worker_count * fibers_per_worker)
+	, m_free_fibers(fiber_queue_cap(worker_count))
+	, m_ready_fibers(fiber_queue_cap(worker_count)) {
+	if (worker_count == 0) {
+		return;
+	}
+
+	void* ptr = core::malloc(core::Layout::array<hidden::JobFiber>(m_fiber_count));
+	m_fibers = static_cast<hidden::JobFiber*>(ptr);
+	for (usize index = 0; index < m_fiber_count; ++index) {
+		auto* fiber = &m_fibers[index];
+		new (fiber) hidden::JobFiber{ .fiber = Fiber(&fiber_main, fiber),
+									  .system = this,
+									  .index = static_cast<u32>(index),
+									  .next_waiter = 0 };
+		// The first fiber of each worker is handed to it directly, so starting a worker never waits for a free one.
+		if (index >= worker_count) {
+			const bool pushed = m_free_fibers.push(op::move(fiber));
+			OP_ASSERT(pushed);
+			OP_UNUSED(pushed);
+		}
+	}
+
+	const auto placement = worker_placement(worker_count);
+	m_pinned = placement.len() > 0;
+
+	ptr = core::malloc(core::Layout::array<hidden::JobWorker>(worker_count));
+	m_workers = static_cast<hidden::JobWorker*>(ptr);
+	// Every worker steals from every other, so all of them exist before the first thread starts.
+	for (usize index = 0; index < worker_count; ++index) {
+		new (&m_workers[index]) hidden::JobWorker{ .system = this,
+												   .deque = {},
+												   .thread_fiber = nullptr,
+												   .running = &m_fibers[index],
+												   .after_switch = {},
+												   .l3_group = m_pinned ? placement[index].l3_group : 0 };
+	}
+	for (usize index = 0; index < worker_count; ++index) {
+		auto* worker = &m_workers[index];
+		auto thread = Thread::spawn([worker]() { return worker_main(worker); });
+		thread.set_name(worker_name(index));
+		if (m_pinned) {
+			CpuSet cpus;
+			cpus.set(placement[index].index);
+			// Restricted cores or a container can still refuse, and an unpinned worker works just as well.
+			const bool pinned = thread.set_affinity(cpus);
+			OP_UNUSED(pinned);
+		}
+		m_threads.push(op::move(thread));
+	}
+}
+
+JobSystem::~JobSystem() {
+	m_running.store(false);
+	wake_all();
+
+	for (auto& thread : m_threads) {
+		thread.join();
+	}
+
+	// Workers leave as soon as they see the shutdown, possibly with jobs still queued.
+	while (auto* job = find_job(nullptr)) {
+		execute(job);
+	}
+
+	if (m_workers != nullptr) {
+		for (usize index = 0; index < m_worker_count; ++index) {
+			m_workers[index].~JobWorker();
+		}
+		core::free(m_workers);
+	}
+
+	// Every fiber is free again, suspended in worker_loop or never started. Neither holds anything to clean up.
+	if (m_fibers != nullptr) {
+		for (usize index = 0; index < m_fiber_count; ++index) {
+			m_fibers[index].~JobFiber();
+		}
+		core::free(m_fibers);
+	}
+}
+
+void JobSystem::run(Function<void()>&& job, JobCounter& counter) {
+	add_pending(counter);
+	schedule(op::move(job), &counter);
+}
+
+void JobSystem::run(Function<void()>&& job) { schedule(op::move(job), nullptr); }
+
+void JobSystem::add_pending(JobCounter& counter) {
+	const auto previous = counter.m_state.fetch_add(1, Order::Relaxed);
+	OP_UNUSED(previous);
+}
+
+void JobSystem::finish_pending(JobCounter& counter) {
+	// The last job takes the waiters in the same operation that finishes the counter. The waiter may destroy the
+	// counter right after, so it is not touched again.
+	auto state = counter.m_state.load(Order::Relaxed);
+	while (true) {
+		const auto pending = pending_jobs(state) - 1;
+		const auto desired = counter_state(pending, pending == 0 ? 0 : first_waiter(state));
+		const auto swapped = counter.m_state.compare_exchange_weak(state, desired, Order::AcqRel);
+		if (swapped.is_set()) {
+			break;
+		}
+		state = counter.m_state.load(Order::Relaxed);
+	}
+	if (pending_jobs(state) != 1) {
+		return;
+	}
+
+	auto waiter = first_waiter(state);
+	while (waiter != 0) {
+		auto* fiber = &m_fibers[waiter - 1];
+		// Read before the fiber is handed out and reused.
+		waiter = fiber->next_waiter;
+		make_ready(fiber);
+	}
+	wake();
+}
+
+void JobSystem::schedule(Function<void()>&& job, JobCounter* counter) {
+	void* ptr = SlabAllocator().malloc(core::Layout::single<hidden::Job>);
+	auto* node = new (ptr) hidden::Job{ .function = op::move(job), .counter = counter };
+
+	auto* worker = current_worker();
+	if (worker == nullptr || !worker->deque.push(node)) {
+		if (!m_injected.push(op::move(node))) {
+			// Both queues are full, so there is more than enough to keep the other threads busy.
+			execute(node);
+			return;
+		}
+	}
+	wake();
+}
+
+void JobSystem::wait(const JobCounter& counter) {
+	// Threads that are not workers can not suspend, and neither can a worker once every fiber is taken. They run jobs
+	// until the counter finishes instead.
+	u32 idle_rounds = 0;
+	while (!counter.is_done()) {
+		if (suspend(counter)) {
+			return;
+		}
+
+		if (auto* job = find_job(current_worker())) {
+			execute(job);
+			idle_rounds = 0;
+			continue;
+		}
+
+		if (idle_rounds < spin_rounds) {
+			idle_rounds += 1;
+			cpu_relax();
+			continue;
+		}
+
+		sleep(&counter);
+		idle_rounds = 0;
+	}
+}
+
+int JobSystem::worker_main(hidden::JobWorker* worker) {
+	t_worker = worker;
+
+	auto thread_fiber = Fiber::from_thread();
+	worker->thread_fiber = &thread_fiber;
+	auto* first = worker->running;
+	worker->running = nullptr;
+	worker->system->switch_fiber(first, hidden::AfterSwitch{});
+
+	// Back on the thread's own stack after the system shut down.
+	t_worker = nullptr;
+	return 0;
+}
+
+void JobSystem::fiber_main(void* user_data) {
+	auto* system = static_cast<hidden::JobFiber*>(user_data)->system;
+	system->finish_switch();
+	system->worker_loop();
+}
+
+hidden::JobWorker* JobSystem::current_worker() const {
+	auto* worker = t_worker;
+	return worker != nullptr && worker->system == this ? worker : nullptr;
+}
+
+hidden::Job* JobSystem::find_job(hidden::JobWorker* worker) {
+	if (worker != nullptr) {
+		if (auto* job = worker->deque.pop()) {
+			return job;
+		}
+	}
+
+	auto injected = m_injected.pop();
+	if (injected.is_set()) {
+		return injected.unwrap();
+	}
+
+	if (m_worker_count == 0) {
+		return nullptr;
+	}
+
+	// Start at a random victim so thieves spread over the workers instead of all draining the first one. Pinned workers
+	// first try the ones that share their L3 cache, where the data of their jobs probably still is.
+	const usize start = static_cast<usize>(next_random() % m_worker_count);
+	const bool by_group = m_pinned && worker != nullptr;
+	for (u32 pass = 0; pass < (by_group ? 2u : 1u); ++pass) {
+		for (usize offset = 0; offset < m_worker_count; ++offset) {
+			auto& victim = m_workers[(start + offset) % m_worker_count];
+			if (&victim == worker) {
+				continue;
+			}
+			if (by_group && (victim.l3_group == worker->l3_group) != (pass == 0)) {
+				continue;
+			}
+			if (auto* job = victim.deque.steal()) {
+				return job;
+			}
+		}
+	}
+	return nullptr;
+}
+
+bool JobSystem::has_work(bool include_fibers) const {
+	if (include_fibers && !m_ready_fibers.is_empty()) {
+		return true;
+	}
+	if (!m_injected.is_empty()) {
+		return true;
+	}
+	for (usize index = 0; index < m_worker_count; ++index) {
+		if (!m_workers[index].deque.is_empty()) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void JobSystem::execute(hidden::Job* job) {
+	job->function();
+
+	auto* counter = job->counter;
+	job->~Job();
+	SlabAllocator().free(job, core::Layout::single<hidden::Job>);
+
+	if (counter != nullptr) {
+		finish_pending(*counter);
+	}
+}
+
+void JobSystem::wake() {
+	// Paired with the sleeper registering itself before it reads the epoch. Either this sees the sleeper, or the sleeper
+	// reads the new epoch and finds the work.
+	const auto epoch = m_epoch.fetch_add(1);
+	OP_UNUSED(epoch);
+	if (m_sleeping.load() > 0) {
+		m_epoch.notify_all();
+	}
+}
+
+void JobSystem::wake_all() {
+	const auto epoch = m_epoch.fetch_add(1);
+	OP_UNUSED(epoch);
+	m_epoch.notify_all();
+}
+
+bool JobSystem::suspend(const JobCounter& counter) {
+	auto* worker = current_worker();
+	if (worker == nullptr) {
+		return false;
+	}
+
+	// A ready fiber takes over the worker without using up a free one, which keeps workers that ran out of fibers from
+	// all waiting on jobs that only need to be resumed.
+	auto next = m_ready_fibers.pop();
+	if (!next.is_set()) {
+		next = m_free_fibers.pop();
+		if (!next.is_set()) {
+			return false;
+		}
+	}
+
+	// Counted before switching so no worker shuts down while this fiber is on its way to the counter.
+	const auto parked = m_parked.fetch_add(1);
+	OP_UNUSED(parked);
+	switch_fiber(next.unwrap(), hidden::AfterSwitch{ .park = worker->running, .counter = &counter });
+
+	// Resumed by a worker after the counter finished, not necessarily the one that suspended the fiber.
+	const auto resumed = m_parked.fetch_sub(1);
+	OP_UNUSED(resumed);
+	return true;
+}
+
+void JobSystem::worker_loop() {
+	u32 idle_rounds = 0;
+	while (true) {
+		// Finishing suspended jobs first frees their fibers and whatever the jobs after them wait on.
+		auto ready = m_ready_fibers.pop();
+		if (ready.is_set()) {
+			// The fiber running this loop goes back to the pool and carries on with the loop when it is next used.
+			switch_fiber(ready.unwrap(), hidden::AfterSwitch{ .release = current_worker()->running });
+			idle_rounds = 0;
+			continue;
+		}
+
+		if (auto* job = find_job(current_worker())) {
+			execute(job);
+			idle_rounds = 0;
+			continue;
+		}
+
+		if (is_finished(nullptr)) {
+			// Other workers may be asleep waiting for the last suspended job to finish.
+			wake_all();
+			switch_fiber(nullptr, hidden::AfterSwitch{ .release = current_worker()->running });
+			idle_rounds = 0;
+			continue;
+		}
+
+		if (idle_rounds < spin_rounds) {
+			idle_rounds += 1;
+			cpu_relax();
+			continue;
+		}
+
+		sleep(nullptr);
+		idle_rounds = 0;
+	}
+}
+
+void JobSystem::sleep(const JobCounter* counter) {
+	// Look one last time after registering as a sleeper, so work published meanwhile is not slept through.
+	const auto sleeping = m_sleeping.fetch_add(1);
+	OP_UNUSED(sleeping);
+	const auto epoch = m_epoch.load();
+	if (!is_finished(counter) && !has_work(current_worker() != nullptr)) {
+		m_epoch.wait(epoch);
+	}
+	const auto awake = m_sleeping.fetch_sub(1);
+	OP_UNUSED(awake);
+}
+
+bool JobSystem::is_finished(const JobCounter* counter) const {
+	if (counter != nullptr) {
+		return counter->is_done();
+	}
+	return !m_running.load() && m_parked.load() == 0;
+}
+
+void JobSystem::switch_fiber(hidden::JobFiber* to, const hidden::AfterSwitch& after) {
+	auto* worker = current_worker();
+	Fiber& from_fiber = worker->running != nullptr ? worker->running->fiber : *worker->thread_fiber;
+	Fiber& to_fiber = to != nullptr ? to->fiber : *worker->thread_fiber;
+	worker->running = to;
+	worker->after_switch = after;
+	Fiber::switch_to(from_fiber, to_fiber);
+
+	// Possibly on another thread now, so the worker is looked up again.
+	finish_switch();
+}
+
+void JobSystem::finish_switch() {
+	auto* worker = current_worker();
+	const auto after = worker->after_switch;
+	worker->after_switch = hidden::AfterSwitch{};
+
+	if (after.release != nullptr) {
+		auto* fiber = after.release;
+		const bool pushed = m_free_fibers.push(op::move(fiber));
+		OP_ASSERT(pushed);
+		OP_UNUSED(pushed);
+	}
+	if (after.park != nullptr) {
+		park(after.park, *after.counter);
+	}
+}
+
+void JobSystem::park(hidden::JobFiber* fiber, const JobCounter& counter) {
+	auto state = counter.m_state.load(Order::Acquire);
+	while (true) {
+		if (pending_jobs(state) == 0) {
+			// Finished while the fiber was switching away.
+			make_ready(fiber);
+			return;
+		}
+
+		fiber->next_waiter = first_waiter(state);
+		const auto desired = counter_state(pending_jobs(state), fiber->index + 1);
+		const auto swapped = counter.m_state.compare_exchange_weak(state, desired, Order::AcqRel);
+		if (swapped.is_set()) {
+			return;
+		}
+		state = counter.m_state.load(Order::Acquire);
+	}
+}
+
+void JobSystem::make_ready(hidden::JobFiber* fiber) {
+	const bool pushed = m_ready_fibers.push(op::move(fiber));
+	OP_ASSERT(pushed);
+	OP_UNUSED(pushed);
+}
+
+OP_CORE_NAMESPACE_END
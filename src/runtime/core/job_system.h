@@ -0,0 +1,173 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#pragma once
+
+#include "core/atomic.h"
+#include "core/containers/function.h"
+#include "core/containers/mpmc_queue.h"
+#include "core/containers/vector.h"
+#include "core/os/cpu.h"
+#include "core/os/thread.h"
+
+OP_CORE_NAMESPACE_BEGIN
+
+OP_HIDDEN_NAMESPACE_BEGIN
+struct AfterSwitch;
+struct Job;
+struct JobFiber;
+struct JobWorker;
+OP_HIDDEN_NAMESPACE_END
+
+/**
+ * Counts jobs that were scheduled but have not finished yet.
+ *
+ * Counters are how jobs express dependencies: schedule the jobs that produce something against a counter, then wait on
+ * it before starting the jobs that consume it. A counter must outlive every job scheduled against it and only be used
+ * with one JobSystem.
+ */
+class JobCounter {
+public:
+	JobCounter() = default;
+
+	JobCounter(const JobCounter& copy) = delete;
+	JobCounter& operator=(const JobCounter& copy) = delete;
+
+	OP_NO_DISCARD OP_ALWAYS_INLINE bool is_done() const {
+		return static_cast<u32>(m_state.load(Order::Acquire)) == 0;
+	}
+
+private:
+	friend class JobSystem;
+
+	// Pending jobs in the low half and the first fiber suspended on the counter in the high half. Keeping both in one
+	// word lets the last job take the waiters in the same operation that finishes the counter, after which the counter
+	// is never touched again.
+	Atomic<u64> m_state = 0;
+};
+
+/**
+ * Runs small jobs on a fixed set of worker threads.
+ *
+ * Every worker owns a Chase-Lev deque. Jobs scheduled from a worker go to the bottom of its own deque and are popped
+ * from there again, so the worker keeps running the newest and most cache friendly job. Workers that run dry steal the
+ * oldest job from a randomly chosen victim instead. Jobs scheduled from any other thread go through a shared queue.
+ *
+ * Jobs run on pooled fibers with fixed size stacks. A job that waits on a counter suspends its fiber and the worker
+ * carries on with other jobs on a fresh fiber, so long dependency chains neither block workers nor need more threads.
+ * The suspended fiber resumes on whichever worker is free once the counter finishes. Threads that are not workers wait
+ * by running queued jobs themselves and only block once there is nothing left to help with. Idle workers spin briefly
+ * before they sleep.
+ *
+ * If there is a core for every thread, each worker is pinned to one, filling an L3 group before spilling into the next,
+ * and steals from workers of its own group first.
+ */
+class JobSystem {
+public:
+	// By default one worker per logical core besides the calling thread, which does its share of the work in wait.
+	explicit JobSystem(usize worker_count = logical_core_count() - 1);
+
+	JobSystem(const JobSystem& copy) = delete;
+	JobSystem& operator=(const JobSystem& copy) = delete;
+
+	// Runs the jobs that are still queued and joins the workers.
+	~JobSystem();
+
+	/**
+	 * Schedules job to run on any thread of the system. counter is incremented now and decremented once the job has
+	 * finished.
+	 */
+	void run(Function<void()>&& job, JobCounter& counter);
+
+	// Schedules job without a counter. Nothing waits for it, but it still runs before the system shuts down.
+	void run(Function<void()>&& job);
+
+	/**
+	 * Counts work against counter that finishes outside of a job, like a coroutine that suspends on I/O. Every call must
+	 * be matched by a call to finish_pending once the work is done.
+	 */
+	void add_pending(JobCounter& counter);
+	void finish_pending(JobCounter& counter);
+
+	/**
+	 * Returns once every job scheduled against counter has finished. Jobs suspend until then and may continue on
+	 * another thread. Other threads run queued jobs in the meantime.
+	 */
+	void wait(const JobCounter& counter);
+
+	/**
+	 * Calls body(start, end) for consecutive ranges that together cover [begin, end), in parallel, and returns once all
+	 * of them are done.
+	 *
+	 * Ranges are sized so every thread gets a few of them to balance uneven work, but never smaller than min_grain so
+	 * cheap bodies are not drowned in scheduling overhead.
+	 */
+	template <typename F>
+	void parallel_for(usize begin, usize end, F&& body, usize min_grain = 1);
+
+	OP_NO_DISCARD OP_ALWAYS_INLINE usize worker_count() const { return m_worker_count; }
+	// Threads that run jobs: the workers and the thread waiting on them.
+	OP_NO_DISCARD OP_ALWAYS_INLINE usize thread_count() const { return m_worker_count + 1; }
+
+private:
+	static int worker_main(hidden::JobWorker* worker);
+	static void fiber_main(void* user_data);
+
+	// Not inlined so the thread local is read again after a fiber moved to another thread.
+	OP_NO_INLINE hidden::JobWorker* current_worker() const;
+
+	void schedule(Function<void()>&& job, JobCounter* counter);
+	hidden::Job* find_job(hidden::JobWorker* worker);
+	bool has_work(bool include_fibers) const;
+	void execute(hidden::Job* job);
+	void wake();
+	void wake_all();
+
+	// Suspends the fiber running on the calling worker until counter is done. Returns false on threads that are not
+	// workers and when there is no fiber to continue with.
+	bool suspend(const JobCounter& counter);
+	// Scheduling loop of a worker fiber. Never returns.
+	void worker_loop();
+	// Blocks until the next wake unless the wait on counter, or the worker if counter is null, ends first.
+	void sleep(const JobCounter* counter);
+	bool is_finished(const JobCounter* counter) const;
+
+	// Suspends the fiber running on the calling worker and continues to, or to the thread's own stack if to is null.
+	void switch_fiber(hidden::JobFiber* to, const hidden::AfterSwitch& after);
+	void finish_switch();
+	void park(hidden::JobFiber* fiber, const JobCounter& counter);
+	void make_ready(hidden::JobFiber* fiber);
+
+	hidden::JobWorker* m_workers;
+	usize m_worker_count;
+	Vector<Thread> m_threads;
+
+	// Jobs scheduled from threads that are not workers.
+	MpmcQueue<hidden::Job*> m_injected;
+
+	hidden::JobFiber* m_fibers;
+	usize m_fiber_count;
+	MpmcQueue<hidden::JobFiber*> m_free_fibers;
+	// Fibers whose counter finished, waiting for a worker to resume them.
+	MpmcQueue<hidden::JobFiber*> m_ready_fibers;
+	// Fibers suspended on a counter or ready to resume. Workers only shut down once there are none.
+	Atomic<u32> m_parked = 0;
+
+	// Whether every worker runs on a core of its own, which makes stealing within L3 groups worthwhile.
+	bool m_pinned = false;
+
+	Atomic<bool> m_running = true;
+	// Bumped whenever there is new work or a counter finishes. Idle threads block on it.
+	Atomic<u32> m_epoch = 0;
+	Atomic<u32> m_sleeping = 0;
+};
+
+OP_CORE_NAMESPACE_END
+
+// Include the implementation
+#include "core/job_system.inl"
+
+// Export to op namespace
+OP_NAMESPACE_BEGIN
+using core::JobCounter;
+using core::JobSystem;
+OP_NAMESPACE_END
@@ -0,0 +1,30 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#include "core/math/math.h"
+
+OP_CORE_NAMESPACE_BEGIN
+
+template <typename F>
+void JobSystem::parallel_for(usize begin, usize end, F&& body, usize min_grain) {
+	if (begin >= end) {
+		return;
+	}
+
+	// Four ranges per thread leaves room to even out ranges that take longer than others.
+	const usize len = end - begin;
+	const usize range_count = thread_count() * 4;
+	const usize grain = core::max((len + range_count - 1) / range_count, core::max(min_grain, (usize)1));
+	if (grain >= len) {
+		body(begin, end);
+		return;
+	}
+
+	JobCounter counter;
+	for (usize start = begin; start < end; start += grain) {
+		const usize stop = core::min(start + grain, end);
+		run(Function<void()>([&body, start, stop]() { body(start, stop); }), counter);
+	}
+	wait(counter);
+}
+
+OP_CORE_NAMESPACE_END
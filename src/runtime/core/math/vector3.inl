@@ -70,12 +70,12 @@ OP_ALWAYS_INLINE bool Vector3<T>::is_near_zero() const {
 
 template <Number T>
 OP_ALWAYS_INLINE bool Vector3<T>::has_nan() const {
-	return x == op::nan || y == op::nan || z == op::nan;
+	return x == op::nan<T> || y == op::nan<T> || z == op::nan<T>;
 }
 
 template <Number T>
 OP_ALWAYS_INLINE bool Vector3<T>::has_infinite() const {
-	return x == op::infinity || y == op::infinity || z == op::infinity;
+	return x == op::infinity<T> || y == op::infinity<T> || z == op::infinity<T>;
 }
 
 OP_CORE_NAMESPACE_END
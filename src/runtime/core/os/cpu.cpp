@@ -0,0 +1,413 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#include "core/os/cpu.h"
+#include "core/math/math.h"
+
+#if OP_CPU_X86
+	#if OP_COMPILER_MSVC
+		#include <intrin.h>
+	#else
+		#include <cpuid.h>
+	#endif
+#endif
+
+#if OP_PLATFORM_WINDOWS
+	#include "core/os/windows.h"
+#elif OP_PLATFORM_LINUX
+	#include <fcntl.h>
+	#include <sched.h>
+	#include <stdio.h>
+	#include <stdlib.h>
+	#include <unistd.h>
+#endif
+
+OP_CORE_NAMESPACE_BEGIN
+
+#if OP_CPU_X86
+
+struct CpuidResult {
+	u32 eax, ebx, ecx, edx;
+};
+
+static CpuidResult cpuid(u32 leaf, u32 subleaf) {
+	CpuidResult result;
+	#if OP_COMPILER_MSVC
+	int registers[4];
+	__cpuidex(registers, static_cast<int>(leaf), static_cast<int>(subleaf));
+	result.eax = static_cast<u32>(registers[0]);
+	result.ebx = static_cast<u32>(registers[1]);
+	result.ecx = static_cast<u32>(registers[2]);
+	result.edx = static_cast<u32>(registers[3]);
+	#else
+	__cpuid_count(leaf, subleaf, result.eax, result.ebx, result.ecx, result.edx);
+	#endif
+	return result;
+}
+
+// Register state the OS saves on context switches.
+static u64 enabled_xsave_state() {
+	#if OP_COMPILER_MSVC
+	return _xgetbv(0);
+	#else
+	u32 eax, edx;
+	__asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+	return (static_cast<u64>(edx) << 32) | eax;
+	#endif
+}
+
+static OP_ALWAYS_INLINE bool has_bit(u32 reg, u32 bit) { return (reg & (1u << bit)) != 0; }
+
+static CpuFeatures detect() {
+	CpuFeatures result = {};
+
+	const auto max_leaf = cpuid(0, 0).eax;
+	const auto leaf1 = cpuid(1, 0);
+	result.sse42 = has_bit(leaf1.ecx, 20);
+	result.popcnt = has_bit(leaf1.ecx, 23);
+
+	// AVX state is only usable if the OS enabled saving of the XMM and YMM registers.
+	const bool os_saves_avx = has_bit(leaf1.ecx, 27) && has_bit(leaf1.ecx, 28) && (enabled_xsave_state() & 0x6) == 0x6;
+
+	if (max_leaf >= 7) {
+		const auto leaf7 = cpuid(7, 0);
+		result.bmi1 = has_bit(leaf7.ebx, 3);
+		result.avx2 = has_bit(leaf7.ebx, 5) && os_saves_avx;
+		result.bmi2 = has_bit(leaf7.ebx, 8);
+	}
+
+	const auto max_extended_leaf = cpuid(0x80000000, 0).eax;
+	if (max_extended_leaf >= 0x80000001) {
+		result.lzcnt = has_bit(cpuid(0x80000001, 0).ecx, 5);
+	}
+
+	return result;
+}
+
+#else
+
+static CpuFeatures detect() { return CpuFeatures{}; }
+
+#endif
+
+const CpuFeatures& cpu_features() {
+	static const CpuFeatures features = detect();
+	return features;
+}
+
+u32 logical_core_count() {
+#if OP_PLATFORM_WINDOWS
+	return static_cast<u32>(::GetActiveProcessorCount(ALL_PROCESSOR_GROUPS));
+#elif OP_PLATFORM_LINUX
+	const long count = ::sysconf(_SC_NPROCESSORS_ONLN);
+	return count > 0 ? static_cast<u32>(count) : 1;
+#else
+	return 1;
+#endif
+}
+
+// Index of key in keys, which is appended if it was not seen before. Turns the sparse ids of the OS into dense ones.
+static u32 dense_index(Vector<u64>& keys, u64 key) {
+	for (usize index = 0; index < keys.len(); ++index) {
+		if (keys[index] == key) {
+			return static_cast<u32>(index);
+		}
+	}
+	return static_cast<u32>(keys.push(key));
+}
+
+#if OP_PLATFORM_WINDOWS
+
+static void mark_group(const GROUP_AFFINITY& affinity, Vector<u32>& ids, u32 id) {
+	auto mask = static_cast<u64>(affinity.Mask);
+	while (mask != 0) {
+		const usize index = static_cast<usize>(affinity.Group) * 64 + count_trailing_zeros(mask);
+		if (index < max_logical_cores) {
+			ids[index] = id;
+		}
+		mask &= mask - 1;
+	}
+}
+
+// Only the cores the process may run on, like sched_getaffinity on Linux.
+static CpuSet process_cores() {
+	CpuSet result;
+	const HANDLE process = ::GetCurrentProcess();
+	USHORT groups[max_logical_cores / 64];
+	USHORT group_count = static_cast<USHORT>(max_logical_cores / 64);
+	if (!::GetProcessGroupAffinity(process, &group_count, groups)) {
+		result.set_all();
+		return result;
+	}
+
+	// The affinity mask only describes the process when it is confined to a single group.
+	DWORD_PTR process_mask = 0;
+	DWORD_PTR system_mask = 0;
+	const bool has_mask =
+		group_count == 1 && ::GetProcessAffinityMask(process, &process_mask, &system_mask) && process_mask != 0;
+	for (USHORT index = 0; index < group_count; ++index) {
+		auto mask = has_mask ? static_cast<u64>(process_mask) : ~u64(0);
+		while (mask != 0) {
+			const usize core = static_cast<usize>(groups[index]) * 64 + count_trailing_zeros(mask);
+			if (core < max_logical_cores) {
+				result.set(core);
+			}
+			mask &= mask - 1;
+		}
+	}
+	return result;
+}
+
+static CpuTopology detect_topology() {
+	DWORD size = 0;
+	::GetLogicalProcessorInformationEx(RelationAll, nullptr, &size);
+	void* ptr = core::malloc(Layout{ size, alignof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX) });
+	auto* buffer = static_cast<u8*>(ptr);
+	const bool ok = ::GetLogicalProcessorInformationEx(RelationAll,
+													   reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer),
+													   &size);
+	OP_ASSERT(ok, "Failed to query the processor topology");
+	OP_UNUSED(ok);
+
+	// Ids in the order Windows reports the relations. They are numbered densely again below, once the cores the
+	// process may not run on are gone.
+	constexpr u32 unknown = ~0u;
+	Vector<u32> cores, nodes, l3_groups, packages;
+	cores.resize(max_logical_cores, unknown);
+	nodes.resize(max_logical_cores, 0);
+	l3_groups.resize(max_logical_cores, unknown);
+	packages.resize(max_logical_cores, 0);
+
+	u32 core_count = 0;
+	u32 node_count = 0;
+	u32 l3_group_count = 0;
+	u32 package_count = 0;
+	for (DWORD offset = 0; offset < size;) {
+		const auto& info = *reinterpret_cast<const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer + offset);
+		switch (info.Relationship) {
+		case RelationProcessorCore:
+			for (WORD group = 0; group < info.Processor.GroupCount; ++group) {
+				mark_group(info.Processor.GroupMask[group], cores, core_count);
+			}
+			core_count += 1;
+			break;
+		case RelationProcessorPackage:
+			for (WORD group = 0; group < info.Processor.GroupCount; ++group) {
+				mark_group(info.Processor.GroupMask[group], packages, package_count);
+			}
+			package_count += 1;
+			break;
+		case RelationNumaNode:
+			mark_group(info.NumaNode.GroupMask, nodes, node_count);
+			node_count += 1;
+			break;
+		case RelationCache:
+			if (info.Cache.Level == 3) {
+				mark_group(info.Cache.GroupMask, l3_groups, l3_group_count);
+				l3_group_count += 1;
+			}
+			break;
+		default:
+			break;
+		}
+		offset += info.Size;
+	}
+	core::free(ptr);
+
+	const auto allowed = process_cores();
+	CpuTopology result = {};
+	Vector<u64> core_keys;
+	Vector<u64> node_keys;
+	Vector<u64> l3_keys;
+	for (u32 index = 0; index < max_logical_cores; ++index) {
+		if (cores[index] == unknown || !allowed.is_set(index)) {
+			continue;
+		}
+		// The top bit keeps package keys apart from cache ones on CPUs without an L3.
+		const u64 l3_key = l3_groups[index] != unknown ? l3_groups[index] : (u64(1) << 63) | packages[index];
+		result.logical_cores.push(LogicalCore{
+			.index = index,
+			.core = dense_index(core_keys, cores[index]),
+			.numa_node = dense_index(node_keys, nodes[index]),
+			.l3_group = dense_index(l3_keys, l3_key),
+		});
+	}
+
+	result.core_count = static_cast<u32>(core_keys.len());
+	result.numa_node_count = max(static_cast<u32>(node_keys.len()), 1u);
+	result.l3_group_count = static_cast<u32>(l3_keys.len());
+	return result;
+}
+
+#elif OP_PLATFORM_LINUX
+
+// Reads a small file from sysfs into buffer and null terminates it. Returns false if the file does not exist.
+static bool read_sys_file(const char* path, char* buffer, usize cap) {
+	const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+	if (fd < 0) {
+		return false;
+	}
+	const auto len = ::read(fd, buffer, cap - 1);
+	::close(fd);
+	buffer[len > 0 ? len : 0] = 0;
+	return len > 0;
+}
+
+static Option<u32> read_sys_u32(const char* path) {
+	char buffer[32];
+	if (!read_sys_file(path, buffer, sizeof(buffer))) {
+		return nullopt;
+	}
+	return static_cast<u32>(::strtoul(buffer, nullptr, 10));
+}
+
+// Parses the kernel's cpu list format, like "0-3,8,10-11".
+static CpuSet parse_cpu_list(const char* list) {
+	CpuSet result;
+	const char* cursor = list;
+	while (*cursor >= '0' && *cursor <= '9') {
+		char* end;
+		const auto first = ::strtoul(cursor, &end, 10);
+		auto last = first;
+		if (*end == '-') {
+			last = ::strtoul(end + 1, &end, 10);
+		}
+		for (auto index = first; index <= last && index < max_logical_cores; ++index) {
+			result.set(index);
+		}
+		cursor = *end == ',' ? end + 1 : end;
+	}
+	return result;
+}
+
+static Option<CpuSet> read_cpu_list(const char* path) {
+	char buffer[4096];
+	if (!read_sys_file(path, buffer, sizeof(buffer))) {
+		return nullopt;
+	}
+	return parse_cpu_list(buffer);
+}
+
+static CpuTopology detect_topology() {
+	// Only the cores the process may run on, which excludes the ones taken away by taskset or cgroups.
+	cpu_set_t allowed;
+	CPU_ZERO(&allowed);
+	if (::sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+		for (usize index = 0; index < logical_core_count(); ++index) {
+			CPU_SET(index, &allowed);
+		}
+	}
+
+	// Kernels without NUMA support have no node directory, which makes the whole machine a single node.
+	Vector<u32> nodes;
+	nodes.resize(max_logical_cores, 0);
+	char path[128];
+	auto online_nodes = read_cpu_list("/sys/devices/system/node/online");
+	if (online_nodes.is_set()) {
+		online_nodes.as_ref().unwrap().for_each_set([&](usize node) {
+			::snprintf(path, sizeof(path), "/sys/devices/system/node/node%u/cpulist", static_cast<u32>(node));
+			auto cpus = read_cpu_list(path);
+			if (!cpus.is_set()) {
+				return;
+			}
+			cpus.as_ref().unwrap().for_each_set([&](usize index) { nodes[index] = static_cast<u32>(node); });
+		});
+	}
+
+	// Nodes are numbered densely over the allowed cores only, like cores and L3 groups.
+	CpuTopology result = {};
+	Vector<u64> core_keys;
+	Vector<u64> node_keys;
+	Vector<u64> l3_keys;
+	for (u32 index = 0; index < max_logical_cores; ++index) {
+		if (!CPU_ISSET(index, &allowed)) {
+			continue;
+		}
+
+		::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/topology/physical_package_id", index);
+		const auto package_id = read_sys_u32(path);
+		const u64 package = package_id.is_set() ? package_id.as_ref().unwrap() : 0;
+		::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/topology/core_id", index);
+		const auto core_id = read_sys_u32(path);
+		const u64 core = core_id.is_set() ? core_id.as_ref().unwrap() : index;
+
+		// Groups are keyed by the lowest logical core sharing the cache. The top bit keeps package keys apart from
+		// them on CPUs without an L3.
+		u64 l3_key = (u64(1) << 63) | package;
+		for (u32 cache = 0;; ++cache) {
+			::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/cache/index%u/level", index, cache);
+			const auto level = read_sys_u32(path);
+			if (!level.is_set()) {
+				break;
+			}
+			if (level.as_ref().unwrap() != 3) {
+				continue;
+			}
+			::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/cache/index%u/shared_cpu_list", index, cache);
+			auto shared = read_cpu_list(path);
+			const auto first = shared.is_set() ? shared.as_ref().unwrap().first_set() : nullopt;
+			if (first.is_set()) {
+				l3_key = first.as_ref().unwrap();
+			}
+			break;
+		}
+
+		result.logical_cores.push(LogicalCore{
+			.index = index,
+			.core = dense_index(core_keys, (package << 32) | core),
+			.numa_node = dense_index(node_keys, nodes[index]),
+			.l3_group = dense_index(l3_keys, l3_key),
+		});
+	}
+
+	result.core_count = static_cast<u32>(core_keys.len());
+	result.numa_node_count = max(static_cast<u32>(node_keys.len()), 1u);
+	result.l3_group_count = static_cast<u32>(l3_keys.len());
+	return result;
+}
+
+#else
+
+static CpuTopology detect_topology() {
+	CpuTopology result = { .logical_cores = {}, .core_count = 1, .numa_node_count = 1, .l3_group_count = 1 };
+	result.logical_cores.push(LogicalCore{ .index = 0, .core = 0, .numa_node = 0, .l3_group = 0 });
+	return result;
+}
+
+#endif
+
+CpuSet CpuTopology::smt_siblings(u32 core) const {
+	CpuSet result;
+	for (const auto& logical_core : logical_cores) {
+		if (logical_core.core == core) {
+			result.set(logical_core.index);
+		}
+	}
+	return result;
+}
+
+CpuSet CpuTopology::numa_node(u32 node) const {
+	CpuSet result;
+	for (const auto& logical_core : logical_cores) {
+		if (logical_core.numa_node == node) {
+			result.set(logical_core.index);
+		}
+	}
+	return result;
+}
+
+CpuSet CpuTopology::l3_group(u32 group) const {
+	CpuSet result;
+	for (const auto& logical_core : logical_cores) {
+		if (logical_core.l3_group == group) {
+			result.set(logical_core.index);
+		}
+	}
+	return result;
+}
+
+const CpuTopology& cpu_topology() {
+	static const CpuTopology topology = detect_topology();
+	return topology;
+}
+
+OP_CORE_NAMESPACE_END
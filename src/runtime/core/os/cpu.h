@@ -0,0 +1,102 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#pragma once
+
+#include "core/containers/bitset.h"
+#include "core/containers/vector.h"
+
+#if OP_CPU_X86
+OP_SUPPRESS_WARNINGS_STD_BEGIN
+	#include <immintrin.h>
+OP_SUPPRESS_WARNINGS_STD_END
+#endif
+
+// Compiles a single function for an instruction set the rest of the build does not target. Callers must check
+// cpu_features first. MSVC emits any intrinsic without being asked.
+#if OP_COMPILER_CLANG || OP_COMPILER_GCC
+	#define OP_TARGET(isa) __attribute__((target(isa)))
+#else
+	#define OP_TARGET(isa)
+#endif
+
+OP_CORE_NAMESPACE_BEGIN
+
+/**
+ * Instruction set extensions of the CPU the program is running on, beyond the SSE2 baseline every x86-64 CPU has.
+ */
+struct CpuFeatures {
+	bool sse42;
+	bool popcnt;
+	bool lzcnt;
+	bool bmi1;
+	bool bmi2;
+	// Also requires the OS to save the upper halves of the AVX registers.
+	bool avx2;
+};
+
+// Detected once on first use.
+const CpuFeatures& cpu_features();
+
+// Number of hardware threads the OS can schedule this process on.
+u32 logical_core_count();
+
+// Most logical cores a CpuSet can name. Matches CPU_SETSIZE on Linux.
+inline constexpr usize max_logical_cores = 1024;
+
+// Logical cores by the index the OS gives them. On Windows the index is the processor group times 64 plus the number
+// within the group.
+using CpuSet = Bitset<max_logical_cores>;
+
+// Where a hardware thread sits in the machine. Cores, nodes and groups are numbered densely from 0.
+struct LogicalCore {
+	u32 index;
+	// Physical core. Logical cores on the same one are SMT siblings and share its execution units.
+	u32 core;
+	u32 numa_node;
+	// Logical cores that share a last level cache. Falls back to the package on CPUs without an L3.
+	u32 l3_group;
+};
+
+/**
+ * Layout of the hardware threads the process may run on, ordered by index.
+ *
+ * Threads that share data should stay on one L3 group, and ideally one NUMA node, so the data does not travel between
+ * caches or sockets.
+ */
+struct CpuTopology {
+	Vector<LogicalCore> logical_cores;
+	u32 core_count;
+	u32 numa_node_count;
+	u32 l3_group_count;
+
+	OP_NO_DISCARD CpuSet smt_siblings(u32 core) const;
+	OP_NO_DISCARD CpuSet numa_node(u32 node) const;
+	OP_NO_DISCARD CpuSet l3_group(u32 group) const;
+};
+
+// Detected once on first use.
+const CpuTopology& cpu_topology();
+
+/**
+ * Tells the CPU the caller is spinning on a value another thread will change. Saves power and frees the core for its
+ * hyperthread sibling without giving up the time slice.
+ */
+OP_ALWAYS_INLINE void cpu_relax() {
+#if OP_CPU_X86
+	_mm_pause();
+#endif
+}
+
+OP_CORE_NAMESPACE_END
+
+// Export to op namespace
+OP_NAMESPACE_BEGIN
+using core::cpu_features;
+using core::cpu_relax;
+using core::cpu_topology;
+using core::CpuFeatures;
+using core::CpuSet;
+using core::CpuTopology;
+using core::logical_core_count;
+using core::LogicalCore;
+OP_NAMESPACE_END
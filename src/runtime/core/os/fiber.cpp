@@ -0,0 +1,177 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#include "core/os/fiber.h"
+#include "core/os/memory.h"
+
+// Section for platform independent code
+OP_CORE_NAMESPACE_BEGIN
+
+Fiber& Fiber::operator=(Fiber&& move) noexcept {
+	auto to_destroy = op::move(*this);
+	OP_UNUSED(to_destroy);
+
+	new (this) Fiber(op::move(move));
+	return *this;
+}
+
+OP_CORE_NAMESPACE_END
+
+// Section for windows code
+#if OP_PLATFORM_WINDOWS
+
+	#include "core/os/windows.h"
+
+OP_CORE_NAMESPACE_BEGIN
+
+Fiber Fiber::from_thread() {
+	Fiber result;
+	result.m_handle = ::ConvertThreadToFiberEx(nullptr, FIBER_FLAG_FLOAT_SWITCH);
+	OP_ASSERT(result.m_handle != nullptr, "Thread is already a fiber");
+	result.m_is_thread = true;
+	return result;
+}
+
+Fiber::Fiber(Entry entry, void* user_data, usize stack_size) {
+	// The cast is safe as LPFIBER_START_ROUTINE and Entry share the calling convention on x64.
+	m_handle = ::CreateFiberEx(0,
+							   static_cast<SIZE_T>(stack_size),
+							   FIBER_FLAG_FLOAT_SWITCH,
+							   reinterpret_cast<LPFIBER_START_ROUTINE>(entry),
+							   user_data);
+	OP_ASSERT(m_handle != nullptr, "Failed to create fiber");
+}
+
+Fiber::Fiber(Fiber&& move) noexcept : m_handle(move.m_handle), m_is_thread(move.m_is_thread) {
+	move.m_handle = nullptr;
+	move.m_is_thread = false;
+}
+
+Fiber::~Fiber() {
+	if (m_handle == nullptr) {
+		return;
+	}
+
+	if (m_is_thread) {
+		::ConvertFiberToThread();
+	} else {
+		::DeleteFiber(m_handle);
+	}
+}
+
+void Fiber::switch_to(Fiber& from, Fiber& to) {
+	OP_ASSERT(::GetCurrentFiber() == from.m_handle, "Can only switch away from the running fiber");
+	::SwitchToFiber(to.m_handle);
+}
+
+OP_CORE_NAMESPACE_END
+
+// Section for linux code
+#elif OP_PLATFORM_LINUX
+
+	#include <sys/mman.h>
+	#include <unistd.h>
+
+	#if !OP_CPU_X86 || OP_CPU_ADDRESS_BITS != 64
+		#error "Fibers on linux only have a context switch for x86-64"
+	#endif
+
+// Saves the callee saved registers of the System V ABI along with the SSE and x87 control words on the running stack,
+// stores the stack pointer in *from and restores the registers pushed on to the same way.
+//
+// void op_fiber_switch(void** from, void* to)
+asm(R"(
+	.text
+	.globl op_fiber_switch
+	.type op_fiber_switch, @function
+op_fiber_switch:
+	pushq %rbp
+	pushq %rbx
+	pushq %r12
+	pushq %r13
+	pushq %r14
+	pushq %r15
+	subq $8, %rsp
+	stmxcsr (%rsp)
+	fnstcw 4(%rsp)
+	movq %rsp, (%rdi)
+	movq %rsi, %rsp
+	ldmxcsr (%rsp)
+	fldcw 4(%rsp)
+	addq $8, %rsp
+	popq %r15
+	popq %r14
+	popq %r13
+	popq %r12
+	popq %rbx
+	popq %rbp
+	ret
+	.size op_fiber_switch, .-op_fiber_switch
+
+	.globl op_fiber_start
+	.type op_fiber_start, @function
+op_fiber_start:
+	movq %r13, %rdi
+	callq *%r12
+	ud2
+	.size op_fiber_start, .-op_fiber_start
+)");
+
+extern "C" void op_fiber_switch(void** from, void* to);
+extern "C" void op_fiber_start();
+
+OP_CORE_NAMESPACE_BEGIN
+
+// Default MXCSR with all exceptions masked, and the default x87 control word.
+static constexpr u32 default_mxcsr = 0x1F80;
+static constexpr u32 default_fpu_control = 0x037F;
+
+Fiber Fiber::from_thread() {
+	// The thread's registers are saved the first time it switches away.
+	return Fiber{};
+}
+
+Fiber::Fiber(Entry entry, void* user_data, usize stack_size) {
+	const auto page_size = static_cast<usize>(::sysconf(_SC_PAGESIZE));
+	m_stack_size = (stack_size + page_size - 1) / page_size * page_size + page_size;
+
+	m_stack = ::mmap(nullptr, m_stack_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+	OP_ASSERT(m_stack != MAP_FAILED, "Failed to map fiber stack");
+	// Overflowing the stack faults on the guard page instead of corrupting whatever is mapped below.
+	const int protected_guard = ::mprotect(m_stack, page_size, PROT_NONE);
+	OP_ASSERT(protected_guard == 0);
+	OP_UNUSED(protected_guard);
+
+	// Lay out the stack as if op_fiber_switch had suspended a call into op_fiber_start, which finds the entry in r12
+	// and its argument in r13. The return address sits so the stack is 16 byte aligned at the call into entry.
+	auto* top = reinterpret_cast<u64*>(static_cast<u8*>(m_stack) + m_stack_size - 16);
+	top[-1] = reinterpret_cast<u64>(&op_fiber_start);
+	top[-2] = 0; // rbp
+	top[-3] = 0; // rbx
+	top[-4] = reinterpret_cast<u64>(entry);
+	top[-5] = reinterpret_cast<u64>(user_data);
+	top[-6] = 0; // r14
+	top[-7] = 0; // r15
+	top[-8] = (static_cast<u64>(default_fpu_control) << 32) | default_mxcsr;
+	m_stack_pointer = &top[-8];
+}
+
+Fiber::Fiber(Fiber&& move) noexcept
+	: m_stack_pointer(move.m_stack_pointer)
+	, m_stack(move.m_stack)
+	, m_stack_size(move.m_stack_size) {
+	move.m_stack_pointer = nullptr;
+	move.m_stack = nullptr;
+	move.m_stack_size = 0;
+}
+
+Fiber::~Fiber() {
+	if (m_stack != nullptr) {
+		::munmap(m_stack, m_stack_size);
+	}
+}
+
+void Fiber::switch_to(Fiber& from, Fiber& to) { op_fiber_switch(&from.m_stack_pointer, to.m_stack_pointer); }
+
+OP_CORE_NAMESPACE_END
+
+#endif
@@ -0,0 +1,67 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#pragma once
+
+#include "core/non_copyable.h"
+
+OP_CORE_NAMESPACE_BEGIN
+
+/**
+ * A stack plus the registers needed to resume execution on it.
+ *
+ * Switching between fibers is a plain function call that saves the callee saved registers of one fiber and restores
+ * those of the other, so it costs a few nanoseconds and never enters the kernel. Fibers are scheduled by hand: they
+ * only run when another fiber on the same thread switches to them.
+ *
+ * A suspended fiber may be resumed on a different thread than the one it was suspended on. Code running on fibers must
+ * not keep pointers to thread locals across a switch.
+ */
+class Fiber : NonCopyable {
+public:
+	using Entry = void (*)(void* user_data);
+
+	static constexpr usize default_stack_size = 256 * KB;
+
+	/**
+	 * Wraps the calling thread's own stack so it can be switched away from and back to. A thread has to do this once
+	 * before it switches to any other fiber, and has to be running on this fiber again when it is destroyed.
+	 */
+	static Fiber from_thread();
+
+	/**
+	 * Creates a fiber with a fixed size stack that calls entry(user_data) the first time it is switched to. entry must
+	 * never return. Switch to another fiber instead.
+	 */
+	Fiber(Entry entry, void* user_data, usize stack_size = default_stack_size);
+
+	Fiber(Fiber&& move) noexcept;
+	Fiber& operator=(Fiber&& move) noexcept;
+	~Fiber();
+
+	/**
+	 * Suspends from, which must be the fiber running on the calling thread, and continues to. Returns once another
+	 * fiber switches back to from.
+	 */
+	static void switch_to(Fiber& from, Fiber& to);
+
+private:
+	Fiber() = default;
+
+#if OP_PLATFORM_WINDOWS
+	void* m_handle = nullptr;
+	bool m_is_thread = false;
+#else
+	// Top of the saved registers while suspended.
+	void* m_stack_pointer = nullptr;
+	// Mapped stack including the guard page, or null for a thread's own stack.
+	void* m_stack = nullptr;
+	usize m_stack_size = 0;
+#endif
+};
+
+OP_CORE_NAMESPACE_END
+
+// Export to op namespace
+OP_NAMESPACE_BEGIN
+using core::Fiber;
+OP_NAMESPACE_END
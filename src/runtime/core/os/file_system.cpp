@@ -1,17 +1,27 @@
 // Copyright Colby Hall. All Rights Reserved.
 
 #include "core/os/file_system.h"
+#include "core/task.h"
 
-#ifdef OP_PLATFORM_WINDOWS
+#if OP_PLATFORM_WINDOWS
 	#include "core/os/windows.h"
 	#include "core/containers/wstring.h"
+#elif OP_PLATFORM_LINUX
+	#include "core/os/time.h"
+
+	#include <dirent.h>
+	#include <fcntl.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+
+	#include <cerrno>
 #else
 	#error "core/os/file_system not implemented for current platform"
 #endif
 
 OP_CORE_NAMESPACE_BEGIN
 
-#ifdef OP_PLATFORM_WINDOWS
+#if OP_PLATFORM_WINDOWS
 
 Result<File, File::Error> File::open(const StringView& path, Flags flags) {
 	const bool read = (flags & Flags::Read) == Flags::Read;
@@ -197,9 +207,9 @@ static void read_directory_impl(const StringView& path, bool recursive, ReadDirF
 	FindClose(find_handle);
 }
 
-void read_dir(const StringView& path, ReadDirFunction function) { read_directory_impl(path, false, function); }
+void read_dir(StringView path, ReadDirFunction function) { read_directory_impl(path, false, function); }
 
-void read_dir_recursive(const StringView& path, ReadDirFunction function) { read_directory_impl(path, true, function); }
+void read_dir_recursive(StringView path, ReadDirFunction function) { read_directory_impl(path, true, function); }
 
 String cwd() {
 	// Query the length of the path
@@ -218,6 +228,190 @@ String cwd() {
 	return String::from(buffer);
 }
 
+#elif OP_PLATFORM_LINUX
+
+// The descriptor is stored one past its value so a descriptor of 0 is not mistaken for a closed file.
+static OP_ALWAYS_INLINE int to_fd(void* handle) { return static_cast<int>(reinterpret_cast<isize>(handle) - 1); }
+static OP_ALWAYS_INLINE void* from_fd(int fd) { return reinterpret_cast<void*>(static_cast<isize>(fd) + 1); }
+
+Result<File, File::Error> File::open(const StringView& path, Flags flags) {
+	const bool read = (flags & Flags::Read) == Flags::Read;
+	const bool write = (flags & Flags::Write) == Flags::Write;
+	const bool create = (flags & Flags::Create) == Flags::Create;
+	OP_ASSERT(read || write);
+
+	int access = O_RDONLY;
+	if (read && write) {
+		access = O_RDWR;
+	} else if (write) {
+		access = O_WRONLY;
+	}
+	if (create) {
+		access |= O_CREAT;
+	}
+
+	// open needs a null terminated path
+	const auto cpath = String::from(path);
+	const int fd = ::open(*cpath, access | O_CLOEXEC, 0644);
+
+	// If the descriptor is invalid then an error occurred
+	if (fd < 0) {
+		switch (errno) {
+		case EBUSY:
+		case ETXTBSY:
+			return Error::InUse;
+		case ENOENT:
+			return Error::NotFound;
+		default:
+			return Error::NotFound;
+		}
+	}
+
+	return File{ from_fd(fd), flags };
+}
+
+usize File::size() const {
+	struct stat status;
+	const bool ok = ::fstat(to_fd(m_handle), &status) == 0;
+	OP_ASSERT(ok);
+	OP_UNUSED(ok);
+	return static_cast<usize>(status.st_size);
+}
+
+usize File::seek(Seek method, isize distance) {
+	// Seek matches SEEK_SET, SEEK_CUR and SEEK_END
+	const auto new_cursor = ::lseek(to_fd(m_handle), static_cast<off_t>(distance), static_cast<int>(method));
+	OP_ASSERT(new_cursor >= 0);
+
+	m_cursor = static_cast<usize>(new_cursor);
+	return m_cursor;
+}
+
+void File::set_eof() {
+	OP_ASSERT(
+		(m_flags & Flags::Write) == Flags::Write,
+		"Can only write to file that has been open with File::Flags::Read"
+	);
+	const bool ok = ::ftruncate(to_fd(m_handle), static_cast<off_t>(m_cursor)) == 0;
+	OP_ASSERT(ok);
+	OP_UNUSED(ok);
+}
+
+usize File::read(Slice<u8> buffer) {
+	OP_ASSERT((m_flags & Flags::Read) == Flags::Read, "Can only read a file that has been open with File::Flags::Read");
+
+	// read may return less than asked for so keep going until the buffer is full or the file ends
+	usize amount_read = 0;
+	while (amount_read < buffer.len()) {
+		const auto result = ::read(to_fd(m_handle), buffer.begin() + amount_read, buffer.len() - amount_read);
+		if (result < 0 && errno == EINTR) continue;
+		OP_ASSERT(result >= 0);
+		if (result <= 0) break;
+		amount_read += static_cast<usize>(result);
+	}
+
+	m_cursor += amount_read;
+
+	return amount_read;
+}
+
+void File::write(Slice<const u8> buffer) {
+	OP_ASSERT(
+		(m_flags & Flags::Write) == Flags::Write,
+		"Can only write to file that has been open with File::Flags::Read"
+	);
+
+	usize amount_written = 0;
+	while (amount_written < buffer.len()) {
+		const auto result =
+			::write(to_fd(m_handle), buffer.cbegin() + amount_written, buffer.len() - amount_written);
+		if (result < 0 && errno == EINTR) continue;
+		OP_ASSERT(result > 0);
+		if (result <= 0) break;
+		amount_written += static_cast<usize>(result);
+	}
+
+	m_cursor += amount_written;
+}
+
+File::~File() {
+	if (m_handle) {
+		const bool ok = ::close(to_fd(m_handle)) == 0;
+		OP_ASSERT(ok);
+		OP_UNUSED(ok);
+		m_handle = nullptr;
+	}
+}
+
+static u64 to_nanos(const timespec& time) {
+	return static_cast<u64>(time.tv_sec) * nanos_per_sec + static_cast<u64>(time.tv_nsec);
+}
+
+static bool read_directory_impl(const StringView& path, bool recursive, ReadDirFunction& function) {
+	const auto cpath = String::from(path);
+	DIR* dir = ::opendir(*cpath);
+	if (dir == nullptr) return true;
+
+	bool keep_going = true;
+	while (keep_going) {
+		const dirent* entry = ::readdir(dir);
+		if (entry == nullptr) break;
+
+		// Check to see if d_name is "." or ".."
+		bool invalid = entry->d_name[0] == '.' && entry->d_name[1] == 0;
+		invalid |= entry->d_name[0] == '.' && entry->d_name[1] == '.' && entry->d_name[2] == 0;
+		if (invalid) continue;
+
+		// Add a slash if one is not at the end and then the new filename
+		auto new_path = String::from(path);
+		if (path.len() > 0 && (*path)[path.len() - 1] != '/') new_path.push('/');
+		new_path.push(StringView(entry->d_name));
+
+		struct stat status;
+		if (::stat(*new_path, &status) != 0) continue;
+
+		// Linux does not keep a creation time so the last status change stands in for it. Times are in nanoseconds
+		// since the unix epoch.
+		DirectoryItem item;
+		item.meta.creation_time = to_nanos(status.st_ctim);
+		item.meta.last_access_time = to_nanos(status.st_atim);
+		item.meta.last_write_time = to_nanos(status.st_mtim);
+		item.meta.read_only = ::access(*new_path, W_OK) != 0;
+		item.meta.size = 0;
+
+		if (S_ISDIR(status.st_mode)) {
+			item.type = DirectoryItem::Type::Directory;
+
+			if (recursive) keep_going = read_directory_impl(new_path, recursive, function);
+		} else {
+			item.type = S_ISREG(status.st_mode) ? DirectoryItem::Type::File : DirectoryItem::Type::Unknown;
+			item.meta.size = static_cast<usize>(status.st_size);
+		}
+		item.path = new_path;
+
+		if (keep_going) keep_going = function(item);
+	}
+
+	::closedir(dir);
+	return keep_going;
+}
+
+void read_dir(StringView path, ReadDirFunction function) { read_directory_impl(path, false, function); }
+
+void read_dir_recursive(StringView path, ReadDirFunction function) { read_directory_impl(path, true, function); }
+
+String cwd() {
+	// Grow the buffer until the path fits
+	Vector<char> buffer;
+	buffer.resize(256);
+	while (::getcwd(buffer.begin(), buffer.len()) == nullptr) {
+		OP_ASSERT(errno == ERANGE);
+		buffer.resize(buffer.len() * 2);
+	}
+
+	return String::from(StringView(buffer.begin()));
+}
+
 #endif
 
 Result<Vector<u8>, File::Error> read_to_bytes(const StringView& path) {
@@ -271,4 +465,14 @@ Result<String, File::Error> read_to_string(const StringView& path) {
 	return String::from(op::move(bytes));
 }
 
+Task<Result<Vector<u8>, File::Error>> read_to_bytes_async(JobSystem& jobs, String path) {
+	co_await schedule(jobs);
+	co_return read_to_bytes(path);
+}
+
+Task<Result<String, File::Error>> read_to_string_async(JobSystem& jobs, String path) {
+	co_await schedule(jobs);
+	co_return read_to_string(path);
+}
+
 OP_CORE_NAMESPACE_END
\ No newline at end of file
@@ -8,6 +8,10 @@
 
 OP_CORE_NAMESPACE_BEGIN
 
+class JobSystem;
+template <typename T>
+class Task;
+
 class File final : NonCopyable {
 public:
 	enum class Flags : u32 { Read, Write, Create };
@@ -51,6 +55,11 @@ OP_ENUM_CLASS_BITFIELD(File::Flags)
 Result<Vector<u8>, File::Error> read_to_bytes(const StringView& path);
 Result<String, File::Error> read_to_string(const StringView& path);
 
+// Reads the file on one of jobs' workers so the awaiting coroutine only continues once the data is there. Include
+// core/task.h to await the result.
+Task<Result<Vector<u8>, File::Error>> read_to_bytes_async(JobSystem& jobs, String path);
+Task<Result<String, File::Error>> read_to_string_async(JobSystem& jobs, String path);
+
 struct DirectoryItem {
 	enum class Type : u32 { File, Directory, Unknown };
 	struct Meta {
@@ -80,6 +89,7 @@ OP_CORE_NAMESPACE_END
 OP_NAMESPACE_BEGIN
 using core::File;
 using core::read_to_string;
+using core::read_to_string_async;
 
 using core::cwd;
 using core::DirectoryItem;
@@ -2,15 +2,21 @@
 
 #include "core/os/library.h"
 
-#ifdef OP_PLATFORM_WINDOWS
+#if OP_PLATFORM_WINDOWS
 	#include "core/containers/wstring.h"
 	#include "core/os/windows.h"
+#elif OP_PLATFORM_LINUX
+	#include "core/containers/string.h"
+
+	#include <dlfcn.h>
 #else
 	#error "op::core::Library unimplemented on this platform"
 #endif
 
 OP_CORE_NAMESPACE_BEGIN
 
+#if OP_PLATFORM_WINDOWS
+
 Option<Library> Library::open(const StringView& path) {
 	WString wpath;
 	wpath.reserve(path.len());
@@ -30,4 +36,29 @@ Library::~Library() {
 
 void* Library::find_internal(const StringView& name) { return (void*)GetProcAddress((HMODULE)m_handle, *name); }
 
+#elif OP_PLATFORM_LINUX
+
+Option<Library> Library::open(const StringView& path) {
+	// dlopen needs a null terminated path
+	const auto cpath = String::from(path);
+
+	void* handle = dlopen(*cpath, RTLD_NOW | RTLD_LOCAL);
+	if (handle != nullptr) return Library{ handle };
+	return nullptr;
+}
+
+Library::~Library() {
+	if (m_handle) {
+		dlclose(m_handle);
+		m_handle = nullptr;
+	}
+}
+
+void* Library::find_internal(const StringView& name) {
+	const auto cname = String::from(name);
+	return dlsym(m_handle, *cname);
+}
+
+#endif
+
 OP_CORE_NAMESPACE_END
\ No newline at end of file
@@ -1,30 +1,312 @@
 // Copyright Colby Hall. All Rights Reserved.
 
 #include "memory.h"
+#include "core/atomic.h"
+#include "core/os/cpu.h"
+#include "core/os/memory_tracking.h"
 
 OP_SUPPRESS_WARNINGS_STD_BEGIN
 
+#include <cstddef>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 
 OP_SUPPRESS_WARNINGS_STD_END
 
+#if OP_CPU_X86
+	#include <immintrin.h>
+#endif
+
+#if OP_PLATFORM_WINDOWS
+	#include "core/os/windows.h"
+	#include <malloc.h>
+#elif OP_PLATFORM_LINUX
+	#include <sys/mman.h>
+#else
+	#error "core/os/memory not implemented for current platform"
+#endif
+
 OP_CORE_NAMESPACE_BEGIN
 
+static Atomic<u64> g_allocation_count = 0;
+
+// Alignment every block from the C allocator already has.
+static constexpr usize default_alignment = alignof(std::max_align_t);
+
+static OP_ALWAYS_INLINE usize align_up(usize value, usize alignment) {
+	OP_ASSERT(alignment > 0 && (alignment & (alignment - 1)) == 0, "Alignment must be a power of two");
+	return (value + alignment - 1) & ~(alignment - 1);
+}
+
+#if OP_PLATFORM_WINDOWS
+
+// Blocks from _aligned_malloc can only be released by _aligned_free so every block takes the aligned path.
+static void* aligned_malloc(const Layout& layout) {
+	const auto alignment = layout.alignment > default_alignment ? layout.alignment : default_alignment;
+	return ::_aligned_malloc(static_cast<std::size_t>(layout.size), static_cast<std::size_t>(alignment));
+}
+
+static void* aligned_realloc(void* old_ptr, const Layout& old_layout, const Layout& new_layout) {
+	const auto old_alignment = old_layout.alignment > default_alignment ? old_layout.alignment : default_alignment;
+	const auto new_alignment = new_layout.alignment > default_alignment ? new_layout.alignment : default_alignment;
+	if (old_alignment == new_alignment) {
+		return ::_aligned_realloc(
+			old_ptr,
+			static_cast<std::size_t>(new_layout.size),
+			static_cast<std::size_t>(new_alignment)
+		);
+	}
+
+	// _aligned_realloc can not change the alignment of a block.
+	void* result = aligned_malloc(new_layout);
+	if (result != nullptr) {
+		std::memcpy(result, old_ptr, old_layout.size < new_layout.size ? old_layout.size : new_layout.size);
+		::_aligned_free(old_ptr);
+	}
+	return result;
+}
+
+static void aligned_free(void* ptr) { ::_aligned_free(ptr); }
+
+#elif OP_PLATFORM_LINUX
+
+static void* aligned_malloc(const Layout& layout) {
+	if (layout.alignment <= default_alignment) {
+		return std::malloc(static_cast<std::size_t>(layout.size));
+	}
+
+	void* result = nullptr;
+	if (::posix_memalign(&result, static_cast<std::size_t>(layout.alignment), static_cast<std::size_t>(layout.size)) !=
+		0) {
+		return nullptr;
+	}
+	return result;
+}
+
+static void* aligned_realloc(void* old_ptr, const Layout& old_layout, const Layout& new_layout) {
+	// There is no aligned realloc. Try the regular one first as it often keeps the block where it was.
+	void* result = std::realloc(old_ptr, static_cast<std::size_t>(new_layout.size));
+	if (result == nullptr || reinterpret_cast<usize>(result) % new_layout.alignment == 0) {
+		return result;
+	}
+
+	void* aligned = aligned_malloc(new_layout);
+	if (aligned != nullptr) {
+		std::memcpy(aligned, result, old_layout.size < new_layout.size ? old_layout.size : new_layout.size);
+	}
+	std::free(result);
+	return aligned;
+}
+
+static void aligned_free(void* ptr) { std::free(ptr); }
+
+#endif
+
+#if OP_PLATFORM_WINDOWS
+
+usize large_page_size() {
+	const auto size = static_cast<usize>(::GetLargePageMinimum());
+	return size != 0 ? size : 2 * MB;
+}
+
+// size is a multiple of large_page_size.
+static void* map_pages(usize size) {
+	// Large pages need the lock memory privilege which most processes do not hold.
+	void* result = ::VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+	if (result == nullptr) {
+		result = ::VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+	}
+	return result;
+}
+
+static void unmap_pages(void* ptr, usize size) {
+	OP_UNUSED(size);
+	::VirtualFree(ptr, 0, MEM_RELEASE);
+}
+
+#elif OP_PLATFORM_LINUX
+
+usize large_page_size() {
+	// Transparent huge pages are 2 MiB on x86-64.
+	return 2 * MB;
+}
+
+// size is a multiple of large_page_size.
+static void* map_pages(usize size) {
+	const auto page_size = large_page_size();
+
+	// Map an extra page so the block can start on a huge page boundary, then unmap the slack on either side.
+	const auto mapped_size = size + page_size;
+	void* mapped = ::mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (mapped == MAP_FAILED) {
+		return nullptr;
+	}
+
+	const auto start = reinterpret_cast<usize>(mapped);
+	const auto aligned = align_up(start, page_size);
+	if (aligned > start) {
+		::munmap(mapped, aligned - start);
+	}
+	const auto tail = start + mapped_size - (aligned + size);
+	if (tail > 0) {
+		::munmap(reinterpret_cast<void*>(aligned + size), tail);
+	}
+
+	void* result = reinterpret_cast<void*>(aligned);
+	::madvise(result, size, MADV_HUGEPAGE);
+	return result;
+}
+
+static void unmap_pages(void* ptr, usize size) { ::munmap(ptr, size); }
+
+#endif
+
+#ifdef OP_ENABLE_MEMORY_TRACKING
+
+// Tracked blocks carry their requested size and category in a header just before the pointer handed out.
+struct AllocationHeader {
+	usize size;
+	// Distance from the start of the underlying block to the pointer handed out.
+	u32 offset;
+	MemoryCategory category;
+};
+// Keeps the pointer handed out aligned while leaving room for the header in front of it. The header is 16 bytes while
+// MSVC only guarantees 8 byte alignment by default, so the offset can not be tied to the default alignment.
+static OP_ALWAYS_INLINE usize header_offset(usize alignment) {
+	const auto header_size = align_up(sizeof(AllocationHeader), alignof(AllocationHeader));
+	return alignment > header_size ? alignment : header_size;
+}
+
+static OP_ALWAYS_INLINE AllocationHeader& header_of(void* ptr) {
+	return *(reinterpret_cast<AllocationHeader*>(ptr) - 1);
+}
+
+static void* tracked_malloc(const Layout& layout) {
+	const auto offset = header_offset(layout.alignment);
+	auto* block = static_cast<u8*>(aligned_malloc(Layout{ layout.size + offset, layout.alignment }));
+	if (block == nullptr) {
+		return nullptr;
+	}
+
+	void* result = block + offset;
+	const auto category = current_memory_category();
+	header_of(result) = AllocationHeader{ layout.size, static_cast<u32>(offset), category };
+	hidden::track_allocation(result, layout.size, category);
+	return result;
+}
+
+static void* tracked_realloc(void* old_ptr, const Layout& old_layout, const Layout& new_layout) {
+	// The block keeps the category it was first allocated with.
+	const auto header = header_of(old_ptr);
+	auto* old_block = static_cast<u8*>(old_ptr) - header.offset;
+	const auto new_offset = header_offset(new_layout.alignment);
+
+	u8* block = nullptr;
+	if (new_offset == header.offset) {
+		block = static_cast<u8*>(aligned_realloc(
+			old_block,
+			Layout{ header.size + header.offset, old_layout.alignment },
+			Layout{ new_layout.size + new_offset, new_layout.alignment }
+		));
+	} else {
+		block = static_cast<u8*>(aligned_malloc(Layout{ new_layout.size + new_offset, new_layout.alignment }));
+		if (block != nullptr) {
+			std::memcpy(block + new_offset, old_ptr, header.size < new_layout.size ? header.size : new_layout.size);
+			aligned_free(old_block);
+		}
+	}
+	if (block == nullptr) {
+		return nullptr;
+	}
+
+	void* result = block + new_offset;
+	header_of(result) = AllocationHeader{ new_layout.size, static_cast<u32>(new_offset), header.category };
+	hidden::track_reallocation(old_ptr, result, header.size, new_layout.size, header.category);
+	return result;
+}
+
+static void tracked_free(void* ptr) {
+	const auto header = header_of(ptr);
+	hidden::track_free(ptr, header.size, header.category);
+	aligned_free(static_cast<u8*>(ptr) - header.offset);
+}
+
+// Large blocks keep their header after the requested bytes so the block itself stays page aligned.
+static OP_ALWAYS_INLINE usize trailer_offset(usize size) { return align_up(size, alignof(AllocationHeader)); }
+
+static OP_ALWAYS_INLINE usize mapped_size(usize size) {
+	return align_up(trailer_offset(size) + sizeof(AllocationHeader), large_page_size());
+}
+
+#else
+
+static OP_ALWAYS_INLINE usize mapped_size(usize size) { return align_up(size, large_page_size()); }
+
+#endif // OP_ENABLE_MEMORY_TRACKING
+
 NonNull<void> malloc(const Layout& layout) {
-	void* result = std::malloc(static_cast<std::size_t>(layout.size));
+	auto count = g_allocation_count.fetch_add(1, Order::Relaxed);
+	OP_UNUSED(count);
+
+#ifdef OP_ENABLE_MEMORY_TRACKING
+	void* result = tracked_malloc(layout);
+#else
+	void* result = aligned_malloc(layout);
+#endif
 	return result; // Nullptr check happens inside NonNull
 }
 
 NonNull<void> realloc(NonNull<void> old_ptr, const Layout& old_layout, const Layout& new_layout) {
-	OP_UNUSED(old_layout);
+	auto count = g_allocation_count.fetch_add(1, Order::Relaxed);
+	OP_UNUSED(count);
+
+#ifdef OP_ENABLE_MEMORY_TRACKING
+	void* result = tracked_realloc(old_ptr, old_layout, new_layout);
+#else
+	void* result = aligned_realloc(old_ptr, old_layout, new_layout);
+#endif
+	return result; // Nullptr check happens inside NonNull
+}
+
+void free(NonNull<void> ptr) {
+#ifdef OP_ENABLE_MEMORY_TRACKING
+	tracked_free(ptr);
+#else
+	aligned_free(ptr);
+#endif
+}
+
+NonNull<void> malloc_large(const Layout& layout) {
+	auto count = g_allocation_count.fetch_add(1, Order::Relaxed);
+	OP_UNUSED(count);
+
+	OP_ASSERT(layout.alignment <= large_page_size(), "Large allocations are only aligned to the large page size");
+	void* result = map_pages(mapped_size(layout.size));
+
+#ifdef OP_ENABLE_MEMORY_TRACKING
+	if (result != nullptr) {
+		const auto category = current_memory_category();
+		auto* header = reinterpret_cast<AllocationHeader*>(static_cast<u8*>(result) + trailer_offset(layout.size));
+		*header = AllocationHeader{ layout.size, 0, category };
+		hidden::track_allocation(result, layout.size, category);
+	}
+#endif
 
-	void* result = std::realloc(old_ptr, static_cast<std::size_t>(new_layout.size));
 	return result; // Nullptr check happens inside NonNull
 }
 
-void free(NonNull<void> ptr) { std::free(ptr); }
+void free_large(NonNull<void> ptr, const Layout& layout) {
+#ifdef OP_ENABLE_MEMORY_TRACKING
+	auto* bytes = static_cast<u8*>(static_cast<void*>(ptr));
+	auto* header = reinterpret_cast<AllocationHeader*>(bytes + trailer_offset(layout.size));
+	hidden::track_free(ptr, header->size, header->category);
+#endif
+
+	unmap_pages(ptr, mapped_size(layout.size));
+}
+
+u64 allocation_count() { return g_allocation_count.load(Order::Relaxed); }
 
 NonNull<void> copy(NonNull<void> dst, NonNull<void const> src, usize count) {
 	return std::memcpy(dst, src, static_cast<std::size_t>(count));
@@ -38,18 +320,119 @@ NonNull<void> set(NonNull<void> ptr, u8 value, usize count) {
 	return std::memset(ptr, value, static_cast<std::size_t>(count));
 }
 
-#define B2(n)	   n, n + 1, n + 1, n + 2
-#define B4(n)	   B2(n), B2(n + 1), B2(n + 1), B2(n + 2)
-#define B6(n)	   B4(n), B4(n + 1), B4(n + 1), B4(n + 2)
-#define COUNT_BITS B6(0), B6(1), B6(1), B6(2)
+i32 compare(NonNull<void const> a, NonNull<void const> b, usize count) {
+	// The C runtime already picks a vectorized memcmp for the running CPU.
+	return std::memcmp(a, b, static_cast<std::size_t>(count));
+}
+
+static usize find_byte_portable(u8 const* bytes, u8 value, usize count) {
+	const void* found = std::memchr(bytes, value, static_cast<std::size_t>(count));
+	return found != nullptr ? static_cast<usize>(static_cast<u8 const*>(found) - bytes) : count;
+}
+
+static usize find_first_set_portable(u64 const* words, usize count) {
+	for (usize index = 0; index < count; ++index) {
+		if (words[index] != 0) {
+			return index * 64 + count_trailing_zeros(words[index]);
+		}
+	}
+	return count * 64;
+}
 
-static u8 count_set_bits_table[256] = { COUNT_BITS };
+static usize count_ones_portable(u8 const* bytes, usize count) {
+	usize result = 0;
+	usize index = 0;
+	for (; index + sizeof(u64) <= count; index += sizeof(u64)) {
+		u64 word;
+		std::memcpy(&word, bytes + index, sizeof(u64));
+		result += core::count_ones(word);
+	}
+	for (; index < count; ++index) {
+		result += core::count_ones(bytes[index]);
+	}
+	return result;
+}
+
+#if OP_CPU_X86
 
-u8 count_ones(u8 byte) { return count_set_bits_table[byte]; }
+OP_TARGET("avx2") static usize find_byte_avx2(u8 const* bytes, u8 value, usize count) {
+	const auto needle = _mm256_set1_epi8(static_cast<char>(value));
 
-#undef B2
-#undef B4
-#undef B6
-#undef COUNT_BITS
+	usize index = 0;
+	for (; index + 32 <= count; index += 32) {
+		const auto chunk = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(bytes + index));
+		const auto matches = static_cast<u32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle)));
+		if (matches != 0) {
+			return index + count_trailing_zeros(matches);
+		}
+	}
+	for (; index < count; ++index) {
+		if (bytes[index] == value) {
+			return index;
+		}
+	}
+	return count;
+}
+
+OP_TARGET("avx2") static usize find_first_set_avx2(u64 const* words, usize count) {
+	usize index = 0;
+	for (; index + 4 <= count; index += 4) {
+		const auto chunk = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(words + index));
+		if (!_mm256_testz_si256(chunk, chunk)) {
+			break;
+		}
+	}
+	const auto result = find_first_set_portable(words + index, count - index);
+	return index * 64 + result;
+}
+
+OP_TARGET("popcnt") static usize count_ones_popcnt(u8 const* bytes, usize count) {
+	usize result = 0;
+	usize index = 0;
+	for (; index + sizeof(u64) <= count; index += sizeof(u64)) {
+		u64 word;
+		std::memcpy(&word, bytes + index, sizeof(u64));
+		// Two 32 bit counts so 32 bit builds do not need _mm_popcnt_u64.
+		result += static_cast<usize>(_mm_popcnt_u32(static_cast<u32>(word)));
+		result += static_cast<usize>(_mm_popcnt_u32(static_cast<u32>(word >> 32)));
+	}
+	for (; index < count; ++index) {
+		result += static_cast<usize>(_mm_popcnt_u32(bytes[index]));
+	}
+	return result;
+}
+
+#endif
+
+// Each primitive picks its implementation the first time it is called.
+usize find_byte(NonNull<void const> ptr, u8 value, usize count) {
+	using Fn = usize (*)(u8 const*, u8, usize);
+#if OP_CPU_X86
+	static const Fn implementation = cpu_features().avx2 ? &find_byte_avx2 : &find_byte_portable;
+#else
+	static const Fn implementation = &find_byte_portable;
+#endif
+	return implementation(static_cast<u8 const*>(static_cast<void const*>(ptr)), value, count);
+}
+
+usize find_first_set(NonNull<u64 const> words, usize count) {
+	using Fn = usize (*)(u64 const*, usize);
+#if OP_CPU_X86
+	static const Fn implementation = cpu_features().avx2 ? &find_first_set_avx2 : &find_first_set_portable;
+#else
+	static const Fn implementation = &find_first_set_portable;
+#endif
+	return implementation(words, count);
+}
+
+usize count_ones(NonNull<void const> ptr, usize count) {
+	using Fn = usize (*)(u8 const*, usize);
+#if OP_CPU_X86
+	static const Fn implementation = cpu_features().popcnt ? &count_ones_popcnt : &count_ones_portable;
+#else
+	static const Fn implementation = &count_ones_portable;
+#endif
+	return implementation(static_cast<u8 const*>(static_cast<void const*>(ptr)), count);
+}
 
 OP_CORE_NAMESPACE_END
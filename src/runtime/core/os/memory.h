@@ -4,6 +4,12 @@
 
 #include "core/containers/non_null.h"
 
+OP_SUPPRESS_WARNINGS_STD_BEGIN
+#include <bit>
+#include <new>
+#include <type_traits>
+OP_SUPPRESS_WARNINGS_STD_END
+
 OP_CORE_NAMESPACE_BEGIN
 OP_MSVC_SUPPRESS_WARNING(4268)
 
@@ -23,6 +29,7 @@ struct Layout {
 template <typename T>
 const Layout Layout::single = Layout{ sizeof(T), alignof(T) };
 
+// Allocates a block aligned to at least layout.alignment. Over aligned blocks are still released with core::free.
 NonNull<void> malloc(const Layout& layout);
 
 template <typename T>
@@ -31,27 +38,71 @@ OP_ALWAYS_INLINE NonNull<T> malloc(usize len = 1) {
 	return op::core::malloc(Layout::array<T>(len)).template as<T>();
 }
 
+// Resizes a block from malloc keeping new_layout.alignment. The first bytes of old_layout.size are preserved.
 NonNull<void> realloc(NonNull<void> old_ptr, const Layout& old_layout, const Layout& new_layout);
 void free(NonNull<void> ptr);
 
+// Granularity of malloc_large. Matches the huge page size of the platform.
+usize large_page_size();
+
+/**
+ * Maps memory straight from the OS for multi-megabyte buffers, asking for huge pages so walking the buffer takes fewer
+ * TLB misses. Sizes are rounded up to large_page_size so small requests waste most of a page.
+ *
+ * Huge pages are a hint. When the OS can not provide them the memory is backed by regular pages.
+ * Blocks must be released with free_large and the layout they were allocated with.
+ */
+NonNull<void> malloc_large(const Layout& layout);
+void free_large(NonNull<void> ptr, const Layout& layout);
+
+// Number of calls to malloc and realloc since startup. Used by tests and benchmarks to count allocations.
+u64 allocation_count();
+
 NonNull<void> copy(NonNull<void> dst, NonNull<void const> src, usize count);
 NonNull<void> move(NonNull<void> dst, NonNull<void const> src, usize count);
 NonNull<void> set(NonNull<void> ptr, u8 value, usize count);
 
-u8 count_ones(u8 byte);
+// Compares count bytes the way memcmp does. Returns a negative, zero or positive value.
+i32 compare(NonNull<void const> a, NonNull<void const> b, usize count);
+
+// Index of the first of count bytes equal to value, or count if there is none. Scans 32 bytes at a time with AVX2.
+usize find_byte(NonNull<void const> ptr, u8 value, usize count);
+
+/**
+ * Index of the lowest set bit across count words, where bit i of words[0] is index i and bit 0 of words[1] is index 64.
+ * Returns count * 64 when no bit is set. Skips runs of empty words four at a time with AVX2.
+ */
+usize find_first_set(NonNull<u64 const> words, usize count);
+
+// Number of set bits in count bytes. Uses the POPCNT instruction when the CPU has it.
+usize count_ones(NonNull<void const> ptr, usize count);
 
 template <typename T>
-OP_ALWAYS_INLINE u32 count_ones(T t) {
-	const usize size = sizeof(T);
-	void* ptr = &t;
-	u8 const* u8_casted = (u8 const*)ptr;
-
-	u32 result = 0;
-	for (usize i = 0; i < size; ++i) {
-		result += count_ones(u8_casted[i]);
-	}
+concept BitWord = std::is_unsigned_v<T> && !std::is_same_v<T, bool>;
+
+// Number of set bits in value. Compiles to POPCNT when the build targets it.
+template <BitWord T>
+OP_ALWAYS_INLINE u32 count_ones(T value) {
+	return static_cast<u32>(std::popcount(value));
+}
+
+// Number of set bits in the bytes of value, for masks that are not a single integer.
+template <typename T>
+	requires(!BitWord<T> && std::is_trivially_copyable_v<T>)
+OP_ALWAYS_INLINE u32 count_ones(const T& value) {
+	return static_cast<u32>(count_ones(NonNull<void const>(&value), sizeof(T)));
+}
+
+// Number of zero bits below the lowest set bit. The bit width of T when value is zero.
+template <BitWord T>
+OP_ALWAYS_INLINE u32 count_trailing_zeros(T value) {
+	return static_cast<u32>(std::countr_zero(value));
+}
 
-	return result;
+// Number of zero bits above the highest set bit. The bit width of T when value is zero.
+template <BitWord T>
+OP_ALWAYS_INLINE u32 count_leading_zeros(T value) {
+	return static_cast<u32>(std::countl_zero(value));
 }
 
 OP_CORE_NAMESPACE_END
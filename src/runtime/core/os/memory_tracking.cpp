@@ -0,0 +1,219 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#include "core/os/memory_tracking.h"
+#include "core/atomic.h"
+
+OP_SUPPRESS_WARNINGS_STD_BEGIN
+
+#include <cstdio>
+
+OP_SUPPRESS_WARNINGS_STD_END
+
+OP_CORE_NAMESPACE_BEGIN
+
+static constexpr usize category_count = static_cast<usize>(MemoryCategory::Count);
+
+const char* memory_category_name(MemoryCategory category) {
+	static const char* names[] = { "General", "Map", "ECS", "Canvas", "Font" };
+	static_assert(sizeof(names) / sizeof(names[0]) == category_count, "Every category needs a name");
+
+	OP_ASSERT(category < MemoryCategory::Count, "Invalid memory category");
+	return names[static_cast<usize>(category)];
+}
+
+#ifdef OP_ENABLE_MEMORY_TRACKING
+
+struct CategoryCounters {
+	Atomic<usize> live_bytes = 0;
+	Atomic<usize> peak_bytes = 0;
+	Atomic<usize> live_allocations = 0;
+	Atomic<u64> total_allocations = 0;
+};
+
+static CategoryCounters g_counters[category_count];
+
+static OP_THREAD_LOCAL MemoryCategory t_category = MemoryCategory::General;
+
+// Only one thread writes to the stream at a time so lines are never interleaved.
+static Atomic<bool> g_stream_locked = false;
+static Atomic<bool> g_streaming = false;
+static std::FILE* g_stream = nullptr;
+
+static void lock_stream() {
+	while (g_stream_locked.exchange(true, Order::Acquire)) {
+	}
+}
+
+static void unlock_stream() { g_stream_locked.store(false, Order::Release); }
+
+static void add_live_bytes(CategoryCounters& counters, usize size) {
+	const auto live = counters.live_bytes.fetch_add(size, Order::Relaxed) + size;
+
+	auto peak = counters.peak_bytes.load(Order::Relaxed);
+	while (live > peak) {
+		if (counters.peak_bytes.compare_exchange_weak(peak, live, Order::Relaxed)) {
+			break;
+		}
+		peak = counters.peak_bytes.load(Order::Relaxed);
+	}
+}
+
+static void write_event(char op, void* ptr, usize old_size, usize new_size, MemoryCategory category) {
+	// Streams write through the C runtime which never allocates with core::malloc, so this can not recurse.
+	if (!g_streaming.load(Order::Relaxed)) {
+		return;
+	}
+
+	lock_stream();
+	if (g_stream != nullptr) {
+		std::fprintf(
+			g_stream,
+			"%c %p %llu %llu %s\n",
+			op,
+			ptr,
+			static_cast<unsigned long long>(old_size),
+			static_cast<unsigned long long>(new_size),
+			memory_category_name(category)
+		);
+	}
+	unlock_stream();
+}
+
+MemoryScope::MemoryScope(MemoryCategory category) : m_previous(t_category) { t_category = category; }
+
+MemoryScope::~MemoryScope() { t_category = m_previous; }
+
+MemoryCategory current_memory_category() { return t_category; }
+
+MemoryStats memory_stats(MemoryCategory category) {
+	OP_ASSERT(category < MemoryCategory::Count, "Invalid memory category");
+	const auto& counters = g_counters[static_cast<usize>(category)];
+	return MemoryStats{
+		counters.live_bytes.load(Order::Relaxed),
+		counters.peak_bytes.load(Order::Relaxed),
+		counters.live_allocations.load(Order::Relaxed),
+		counters.total_allocations.load(Order::Relaxed),
+	};
+}
+
+void print_memory_report(usize top_n) {
+	MemoryStats stats[category_count];
+	MemoryCategory order[category_count];
+	for (usize index = 0; index < category_count; ++index) {
+		order[index] = static_cast<MemoryCategory>(index);
+		stats[index] = memory_stats(order[index]);
+	}
+
+	// Insertion sort by live bytes. There are only a handful of categories.
+	for (usize index = 1; index < category_count; ++index) {
+		const auto category = order[index];
+		usize slot = index;
+		while (slot > 0 && stats[static_cast<usize>(order[slot - 1])].live_bytes <
+							   stats[static_cast<usize>(category)].live_bytes) {
+			order[slot] = order[slot - 1];
+			slot -= 1;
+		}
+		order[slot] = category;
+	}
+
+	std::printf("%-12s %14s %14s %12s %14s\n", "Category", "Live bytes", "Peak bytes", "Live allocs", "Total allocs");
+	for (usize index = 0; index < top_n && index < category_count; ++index) {
+		const auto& stat = stats[static_cast<usize>(order[index])];
+		std::printf(
+			"%-12s %14llu %14llu %12llu %14llu\n",
+			memory_category_name(order[index]),
+			static_cast<unsigned long long>(stat.live_bytes),
+			static_cast<unsigned long long>(stat.peak_bytes),
+			static_cast<unsigned long long>(stat.live_allocations),
+			static_cast<unsigned long long>(stat.total_allocations)
+		);
+	}
+}
+
+bool begin_memory_event_stream(const char* path) {
+	std::FILE* file = std::fopen(path, "w");
+	if (file == nullptr) {
+		return false;
+	}
+
+	lock_stream();
+	if (g_stream != nullptr) {
+		std::fclose(g_stream);
+	}
+	g_stream = file;
+	g_streaming.store(true, Order::Relaxed);
+	unlock_stream();
+	return true;
+}
+
+void end_memory_event_stream() {
+	lock_stream();
+	g_streaming.store(false, Order::Relaxed);
+	if (g_stream != nullptr) {
+		std::fclose(g_stream);
+		g_stream = nullptr;
+	}
+	unlock_stream();
+}
+
+OP_HIDDEN_NAMESPACE_BEGIN
+
+void track_allocation(void* ptr, usize size, MemoryCategory category) {
+	auto& counters = g_counters[static_cast<usize>(category)];
+	add_live_bytes(counters, size);
+	auto live = counters.live_allocations.fetch_add(1, Order::Relaxed);
+	auto total = counters.total_allocations.fetch_add(1, Order::Relaxed);
+	OP_UNUSED(live);
+	OP_UNUSED(total);
+
+	write_event('a', ptr, 0, size, category);
+}
+
+void track_reallocation(void* old_ptr, void* new_ptr, usize old_size, usize new_size, MemoryCategory category) {
+	auto& counters = g_counters[static_cast<usize>(category)];
+	auto live = counters.live_bytes.fetch_sub(old_size, Order::Relaxed);
+	auto total = counters.total_allocations.fetch_add(1, Order::Relaxed);
+	OP_UNUSED(live);
+	OP_UNUSED(total);
+	add_live_bytes(counters, new_size);
+
+	OP_UNUSED(old_ptr);
+	write_event('r', new_ptr, old_size, new_size, category);
+}
+
+void track_free(void* ptr, usize size, MemoryCategory category) {
+	auto& counters = g_counters[static_cast<usize>(category)];
+	auto live = counters.live_bytes.fetch_sub(size, Order::Relaxed);
+	auto count = counters.live_allocations.fetch_sub(1, Order::Relaxed);
+	OP_UNUSED(live);
+	OP_UNUSED(count);
+
+	write_event('f', ptr, size, 0, category);
+}
+
+OP_HIDDEN_NAMESPACE_END
+
+#else
+
+MemoryCategory current_memory_category() { return MemoryCategory::General; }
+
+MemoryStats memory_stats(MemoryCategory category) {
+	OP_UNUSED(category);
+	return MemoryStats{ 0, 0, 0, 0 };
+}
+
+void print_memory_report(usize top_n) {
+	OP_UNUSED(top_n);
+	std::printf("Memory tracking is disabled. Build with OP_ENABLE_MEMORY_TRACKING to enable it.\n");
+}
+
+bool begin_memory_event_stream(const char* path) {
+	OP_UNUSED(path);
+	return false;
+}
+
+void end_memory_event_stream() {}
+
+#endif // OP_ENABLE_MEMORY_TRACKING
+
+OP_CORE_NAMESPACE_END
@@ -0,0 +1,99 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#pragma once
+
+#include "core/core.h"
+
+OP_CORE_NAMESPACE_BEGIN
+
+/**
+ * Subsystem an allocation is charged to. Set for the calling thread with a MemoryScope.
+ *
+ * Memory handed out by SlabAllocator and Arena is charged when their backing blocks are allocated, to whichever category
+ * was current at the time.
+ */
+enum class MemoryCategory : u8 {
+	General,
+	// Storage of Map rebuilt when it grows, wherever the map lives.
+	Map,
+	Ecs,
+	Canvas,
+	Font,
+	Count,
+};
+
+const char* memory_category_name(MemoryCategory category);
+
+struct MemoryStats {
+	// Bytes currently allocated, not counting tracking overhead.
+	usize live_bytes;
+	// Highest live_bytes seen since startup.
+	usize peak_bytes;
+	usize live_allocations;
+	// Calls to malloc and realloc since startup.
+	u64 total_allocations;
+};
+
+/**
+ * Charges every allocation made by the calling thread to category until the scope ends. Scopes nest, the innermost
+ * one wins. Blocks keep the category they were allocated with when they are reallocated or freed later.
+ *
+ * Does nothing unless the library is built with OP_ENABLE_MEMORY_TRACKING.
+ */
+class MemoryScope {
+public:
+#ifdef OP_ENABLE_MEMORY_TRACKING
+	explicit MemoryScope(MemoryCategory category);
+	~MemoryScope();
+#else
+	// Scopes sit on hot paths, so without tracking they inline away entirely.
+	OP_ALWAYS_INLINE explicit MemoryScope(MemoryCategory category) { OP_UNUSED(category); }
+	OP_ALWAYS_INLINE ~MemoryScope() {}
+#endif
+
+	MemoryScope(const MemoryScope&) = delete;
+	MemoryScope& operator=(const MemoryScope&) = delete;
+
+#ifdef OP_ENABLE_MEMORY_TRACKING
+private:
+	MemoryCategory m_previous;
+#endif
+};
+
+// Category allocations on the calling thread are currently charged to.
+MemoryCategory current_memory_category();
+
+// Counters of a category. All zero when tracking is disabled.
+MemoryStats memory_stats(MemoryCategory category);
+
+/**
+ * Prints the top_n categories by live bytes with their peaks and allocation counts to stdout.
+ */
+void print_memory_report(usize top_n = static_cast<usize>(MemoryCategory::Count));
+
+/**
+ * Appends a line to the file at path for every malloc, realloc and free until end_memory_event_stream is called.
+ *
+ * Lines are `<op> <address> <old size> <new size> <category>` where op is a, r or f, so the allocation rate and
+ * footprint of a subsystem can be replayed offline. Returns false if the file could not be opened or tracking is
+ * disabled.
+ */
+bool begin_memory_event_stream(const char* path);
+void end_memory_event_stream();
+
+OP_HIDDEN_NAMESPACE_BEGIN
+
+// Called by core::malloc and friends. sizes are the ones requested by the caller.
+void track_allocation(void* ptr, usize size, MemoryCategory category);
+void track_reallocation(void* old_ptr, void* new_ptr, usize old_size, usize new_size, MemoryCategory category);
+void track_free(void* ptr, usize size, MemoryCategory category);
+
+OP_HIDDEN_NAMESPACE_END
+
+OP_CORE_NAMESPACE_END
+
+// Export to op namespace
+OP_NAMESPACE_BEGIN
+using core::MemoryCategory;
+using core::MemoryScope;
+OP_NAMESPACE_END
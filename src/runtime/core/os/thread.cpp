@@ -91,8 +91,127 @@ void Thread::set_name(String&& name) {
 	SetThreadName(static_cast<DWORD>(id()), *m_inner->name.as_ref().unwrap());
 }
 
+bool Thread::set_affinity(const CpuSet& cpus) {
+	const auto first = cpus.first_set();
+	if (!first.is_set()) {
+		return false;
+	}
+
+	GROUP_AFFINITY affinity = {};
+	affinity.Group = static_cast<WORD>(first.as_ref().unwrap() / 64);
+	affinity.Mask = static_cast<KAFFINITY>(cpus.words()[affinity.Group]);
+	return ::SetThreadGroupAffinity(m_inner->handle, &affinity, nullptr) != 0;
+}
+
+bool Thread::set_priority(Priority priority) {
+	static constexpr int priorities[] = { THREAD_PRIORITY_LOWEST,
+										  THREAD_PRIORITY_BELOW_NORMAL,
+										  THREAD_PRIORITY_NORMAL,
+										  THREAD_PRIORITY_ABOVE_NORMAL,
+										  THREAD_PRIORITY_HIGHEST };
+	return ::SetThreadPriority(m_inner->handle, priorities[static_cast<usize>(priority)]) != 0;
+}
+
 void Thread::join() { ::WaitForSingleObject(m_inner->handle, INFINITE); }
 
 OP_CORE_NAMESPACE_END
 
+// Section for linux code
+#elif OP_PLATFORM_LINUX
+
+	#include "core/atomic.h"
+	#include "core/math/math.h"
+
+	#include <pthread.h>
+	#include <sched.h>
+	#include <sys/resource.h>
+	#include <unistd.h>
+
+OP_CORE_NAMESPACE_BEGIN
+
+// Shared by spawn and the new thread. Whichever of the two lets go of it last frees it, so neither touches it after the
+// other may have returned.
+struct ThreadStart {
+	Function<int()> function;
+	Option<Thread> thread;
+	Atomic<u32> started;
+	Atomic<u32> references;
+};
+
+// The handle of a thread is its pthread_t, which glibc defines as an integer.
+static OP_ALWAYS_INLINE pthread_t native_handle(void* handle) { return reinterpret_cast<pthread_t>(handle); }
+
+static void release(ThreadStart* start) {
+	if (start->references.fetch_sub(1, Order::AcqRel) == 1) {
+		start->~ThreadStart();
+		core::free(start);
+	}
+}
+
+static void* thread_function(void* user_data) noexcept {
+	auto* const start = static_cast<ThreadStart*>(user_data);
+	auto function = op::move(start->function);
+	// Filling in this_thread here gives the new thread and the spawner the same instance.
+	start->thread = Thread::current();
+	start->started.store(1, Order::Release);
+	start->started.notify_one();
+	release(start);
+
+	const int result = function();
+	return reinterpret_cast<void*>(static_cast<isize>(result));
+}
+
+Thread Thread::spawn(Function<int()> f) {
+	void* ptr = core::malloc(core::Layout::single<ThreadStart>);
+	auto* start = new (ptr) ThreadStart{ .function = op::move(f), .thread = nullopt, .started = 0, .references = 2 };
+
+	pthread_t handle;
+	const int error = ::pthread_create(&handle, nullptr, &thread_function, start);
+	OP_ASSERT(error == 0, "Failed to create thread");
+	OP_UNUSED(error);
+
+	while (start->started.load(Order::Acquire) == 0) {
+		start->started.wait(0, Order::Acquire);
+	}
+	auto result = start->thread.as_ref().unwrap();
+	release(start);
+	return result;
+}
+
+Thread Thread::current() {
+	// Lazily cache the current thread in a thread local global. The id is the kernel's thread id, which is what
+	// setpriority and tools like top and perf know the thread by.
+	if (!this_thread.is_set()) {
+		this_thread = Thread{ static_cast<Id>(::gettid()), reinterpret_cast<void*>(::pthread_self()) };
+	}
+	return this_thread.as_ref().unwrap();
+}
+
+void Thread::set_name(String&& name) {
+	m_inner->name = op::move(name);
+
+	// The kernel keeps at most 15 bytes of a name and rejects longer ones.
+	char truncated[16] = {};
+	const auto& stored = m_inner->name.as_ref().unwrap();
+	core::copy(truncated, *stored, min(stored.len(), static_cast<usize>(sizeof(truncated) - 1)));
+	::pthread_setname_np(native_handle(m_inner->handle), truncated);
+}
+
+bool Thread::set_affinity(const CpuSet& cpus) {
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	cpus.for_each_set([&set](usize index) { CPU_SET(index, &set); });
+	return ::pthread_setaffinity_np(native_handle(m_inner->handle), sizeof(set), &set) == 0;
+}
+
+bool Thread::set_priority(Priority priority) {
+	// Nice values. Lower ones get more of the CPU.
+	static constexpr int nice_values[] = { 19, 10, 0, -5, -10 };
+	return ::setpriority(PRIO_PROCESS, static_cast<id_t>(id()), nice_values[static_cast<usize>(priority)]) == 0;
+}
+
+void Thread::join() { ::pthread_join(native_handle(m_inner->handle), nullptr); }
+
+OP_CORE_NAMESPACE_END
+
 #endif
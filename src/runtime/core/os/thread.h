@@ -5,6 +5,7 @@
 #include "core/containers/function.h"
 #include "core/containers/shared.h"
 #include "core/containers/string.h"
+#include "core/os/cpu.h"
 
 OP_CORE_NAMESPACE_BEGIN
 
@@ -17,6 +18,8 @@ class Thread {
 public:
 	using Id = u64;
 
+	enum class Priority : u8 { Lowest, Low, Normal, High, Highest };
+
 	/**
 	 * Spawns a new thread with the specified function.
 	 *
@@ -30,9 +33,13 @@ public:
 
 	/**
 	 * Retrieves the current thread.
+	 *
+	 * Never inlined, so code running on a fiber that moved to another thread gets the thread it runs on now instead of
+	 * one cached before the switch.
+	 *
 	 * @return The Thread object representing the current thread.
 	 */
-	static Thread current();
+	OP_NO_INLINE static Thread current();
 
 	/**
 	 * Sets the name of the thread.
@@ -43,6 +50,24 @@ public:
 	 */
 	void set_name(String&& name);
 
+	/**
+	 * Restricts the thread to the logical cores in cpus.
+	 *
+	 * On Windows a thread runs in a single processor group, so only the cores of the first group in cpus are used.
+	 *
+	 * @return False if the OS rejected the set, for example because none of its cores are available to the process.
+	 */
+	bool set_affinity(const CpuSet& cpus);
+
+	/**
+	 * Changes how the OS scheduler favors the thread over the others of the process.
+	 *
+	 * On Linux priorities map to nice values of the thread. Raising it above Normal needs CAP_SYS_NICE.
+	 *
+	 * @return False if the OS refused the change.
+	 */
+	bool set_priority(Priority priority);
+
 	/**
 	 * Blocks the current thread until this thread has completed.
 	 */
@@ -70,3 +95,8 @@ private:
 };
 
 OP_CORE_NAMESPACE_END
+
+// Export to op namespace
+OP_NAMESPACE_BEGIN
+using core::Thread;
+OP_NAMESPACE_END
@@ -5,6 +5,10 @@
 
 #if OP_PLATFORM_WINDOWS
 	#include "core/os/windows.h"
+#elif OP_PLATFORM_LINUX
+	#include <time.h>
+#else
+	#error "core/os/time not implemented for current platform"
 #endif
 
 OP_CORE_NAMESPACE_BEGIN
@@ -38,6 +42,22 @@ Duration Instant::duration_since(Instant earlier) const {
 	return Duration(secs, nanos);
 }
 
+#elif OP_PLATFORM_LINUX
+
+// Ticks are nanoseconds read from the monotonic clock
+Instant Instant::now() {
+	timespec time;
+	const auto result = clock_gettime(CLOCK_MONOTONIC, &time);
+	OP_ASSERT(result == 0);
+	OP_UNUSED(result);
+	return { static_cast<u64>(time.tv_sec) * nanos_per_sec + static_cast<u64>(time.tv_nsec) };
+}
+
+Duration Instant::duration_since(Instant earlier) const {
+	const auto duration = m_tick - earlier.m_tick;
+	return Duration(duration / nanos_per_sec, static_cast<u32>(duration % nanos_per_sec));
+}
+
 #endif
 
 OP_CORE_NAMESPACE_END
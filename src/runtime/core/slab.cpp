@@ -0,0 +1,210 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#include "core/slab.h"
+#include "core/atomic.h"
+
+OP_CORE_NAMESPACE_BEGIN
+
+// Classes are 16 bytes apart up to 128, 32 apart up to 256 and 64 apart up to max_size.
+static constexpr usize class_count = 16;
+static constexpr usize slab_size = 64 * 1024;
+// Number of blocks moved between a thread and the central pool at a time.
+static constexpr u32 batch_len = 32;
+
+static_assert(SlabAllocator::max_size == 512, "Size classes must be updated with max_size");
+
+static OP_ALWAYS_INLINE usize class_index(usize size) {
+	if (size <= 128) return size == 0 ? 0 : (size - 1) / 16;
+	if (size <= 256) return 8 + (size - 129) / 32;
+	return 12 + (size - 257) / 64;
+}
+
+static OP_ALWAYS_INLINE usize class_size(usize index) {
+	if (index < 8) return (index + 1) * 16;
+	if (index < 12) return 128 + (index - 7) * 32;
+	return 256 + (index - 11) * 64;
+}
+
+struct FreeBlock {
+	FreeBlock* next;
+};
+
+struct Slab {
+	Slab* next;
+};
+
+// Blocks shared between threads. Guarded by a spin lock as it is only touched once per batch.
+struct CentralClass {
+	Atomic<bool> locked = false;
+	FreeBlock* free = nullptr;
+	u8* bump = nullptr;
+	u8* bump_end = nullptr;
+
+	void lock() {
+		while (locked.exchange(true, Order::Acquire)) {
+		}
+	}
+	void unlock() { locked.store(false, Order::Release); }
+};
+
+static CentralClass g_central[class_count];
+
+// Every slab ever allocated so the memory stays reachable until the process exits.
+static Atomic<Slab*> g_slabs = nullptr;
+
+static u32 take_from_central(usize index, FreeBlock*& head, u32 max_count = batch_len) {
+	auto& central = g_central[index];
+	const auto size = class_size(index);
+
+	central.lock();
+	u32 count = 0;
+	while (count < max_count && central.free != nullptr) {
+		auto* block = central.free;
+		central.free = block->next;
+		block->next = head;
+		head = block;
+		count += 1;
+	}
+	while (count < max_count) {
+		if (central.bump + size > central.bump_end) {
+			void* memory = core::malloc(Layout{ slab_size, SlabAllocator::max_alignment });
+			auto* slab = static_cast<Slab*>(memory);
+			slab->next = g_slabs.load(Order::Relaxed);
+			g_slabs.store(slab, Order::Relaxed);
+
+			// Keep blocks aligned to max_alignment after the slab header.
+			central.bump = static_cast<u8*>(memory) + SlabAllocator::max_alignment;
+			central.bump_end = static_cast<u8*>(memory) + slab_size;
+		}
+
+		auto* block = reinterpret_cast<FreeBlock*>(central.bump);
+		central.bump += size;
+		block->next = head;
+		head = block;
+		count += 1;
+	}
+	central.unlock();
+
+	return count;
+}
+
+static void give_to_central(usize index, FreeBlock* first, FreeBlock* last) {
+	auto& central = g_central[index];
+	central.lock();
+	last->next = central.free;
+	central.free = first;
+	central.unlock();
+}
+
+// Set once the thread's cache has been destroyed. Plain thread locals are never destroyed so this outlives the cache.
+static OP_THREAD_LOCAL bool t_cache_destroyed = false;
+
+struct ThreadCache {
+	FreeBlock* heads[class_count] = {};
+	u32 counts[class_count] = {};
+
+	ThreadCache() = default;
+	ThreadCache(const ThreadCache&) = delete;
+	ThreadCache& operator=(const ThreadCache&) = delete;
+
+	~ThreadCache() {
+		// Hand every cached block back so other threads can use it once this one exits.
+		for (usize index = 0; index < class_count; ++index) {
+			auto* first = heads[index];
+			if (first == nullptr) continue;
+
+			auto* last = first;
+			while (last->next != nullptr) {
+				last = last->next;
+			}
+			give_to_central(index, first, last);
+
+			heads[index] = nullptr;
+			counts[index] = 0;
+		}
+		t_cache_destroyed = true;
+	}
+};
+
+// Returns null once the cache is gone, which happens when a destructor that runs after it frees or allocates.
+static ThreadCache* thread_cache() {
+	if (t_cache_destroyed) {
+		return nullptr;
+	}
+
+	// OP_THREAD_LOCAL can not run destructors so cached blocks would be lost when the thread exits.
+	static thread_local ThreadCache cache;
+	return &cache;
+}
+
+NonNull<void> SlabAllocator::malloc(const Layout& layout) const {
+	if (!is_small(layout)) {
+		return core::malloc(layout);
+	}
+
+	const auto index = class_index(layout.size);
+	auto* const cache = thread_cache();
+	if (cache == nullptr) {
+		FreeBlock* block = nullptr;
+		take_from_central(index, block, 1);
+		return block;
+	}
+
+	if (cache->heads[index] == nullptr) {
+		cache->counts[index] = take_from_central(index, cache->heads[index]);
+	}
+
+	auto* block = cache->heads[index];
+	cache->heads[index] = block->next;
+	cache->counts[index] -= 1;
+	return block;
+}
+
+NonNull<void> SlabAllocator::realloc(NonNull<void> old_ptr, const Layout& old_layout, const Layout& new_layout) const {
+	if (!is_small(old_layout) && !is_small(new_layout)) {
+		return core::realloc(old_ptr, old_layout, new_layout);
+	}
+
+	// Blocks in the same class already have room for the new size.
+	if (is_small(old_layout) && is_small(new_layout) && class_index(old_layout.size) == class_index(new_layout.size)) {
+		return old_ptr;
+	}
+
+	auto result = malloc(new_layout);
+	core::copy(result, static_cast<void*>(old_ptr), old_layout.size < new_layout.size ? old_layout.size : new_layout.size);
+	free(old_ptr, old_layout);
+	return result;
+}
+
+void SlabAllocator::free(NonNull<void> ptr, const Layout& layout) const {
+	if (!is_small(layout)) {
+		core::free(ptr);
+		return;
+	}
+
+	const auto index = class_index(layout.size);
+	auto* block = static_cast<FreeBlock*>(static_cast<void*>(ptr));
+	auto* const cache = thread_cache();
+	if (cache == nullptr) {
+		give_to_central(index, block, block);
+		return;
+	}
+
+	block->next = cache->heads[index];
+	cache->heads[index] = block;
+	cache->counts[index] += 1;
+
+	// Spill a batch once a thread frees far more than it allocates so the blocks can be reused elsewhere.
+	if (cache->counts[index] >= batch_len * 2) {
+		auto* first = cache->heads[index];
+		auto* last = first;
+		for (u32 i = 1; i < batch_len; ++i) {
+			last = last->next;
+		}
+		cache->heads[index] = last->next;
+		cache->counts[index] -= batch_len;
+		give_to_central(index, first, last);
+	}
+}
+
+OP_CORE_NAMESPACE_END
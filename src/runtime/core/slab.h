@@ -0,0 +1,41 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#pragma once
+
+#include "core/allocator.h"
+
+OP_CORE_NAMESPACE_BEGIN
+
+/**
+ * Allocator for small objects that are created and destroyed constantly, such as Shared control blocks, Unique
+ * storage and Function captures.
+ *
+ * Sizes are rounded up to a fixed set of size classes. Each thread keeps a free list per class so most allocations and
+ * frees never leave the thread. Lists are refilled from, and spilled back to, a central pool in batches. Memory is
+ * carved from large slabs that are kept for the life of the process and never returned to core::malloc.
+ *
+ * Requests larger than max_size or aligned to more than max_alignment go straight to core::malloc. A block may be freed
+ * on any thread, it joins that thread's free list.
+ */
+class SlabAllocator {
+public:
+	static constexpr usize max_size = 512;
+	static constexpr usize max_alignment = 16;
+
+	// Allocator
+	NonNull<void> malloc(const Layout& layout) const;
+	NonNull<void> realloc(NonNull<void> old_ptr, const Layout& old_layout, const Layout& new_layout) const;
+	void free(NonNull<void> ptr, const Layout& layout) const;
+	// ~Allocator
+
+	OP_ALWAYS_INLINE static constexpr bool is_small(const Layout& layout) {
+		return layout.size <= max_size && layout.alignment <= max_alignment;
+	}
+};
+
+OP_CORE_NAMESPACE_END
+
+// Export to op namespace
+OP_NAMESPACE_BEGIN
+using core::SlabAllocator;
+OP_NAMESPACE_END
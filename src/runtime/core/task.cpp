@@ -0,0 +1,34 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#include "core/task.h"
+#include "core/slab.h"
+
+OP_CORE_NAMESPACE_BEGIN
+
+OP_HIDDEN_NAMESPACE_BEGIN
+
+// Frames hold the promise and locals of any type, so they get the alignment of operator new.
+static constexpr usize frame_alignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+void* FrameAllocation::operator new(std::size_t size) {
+	void* ptr = SlabAllocator().malloc(Layout{ size, frame_alignment });
+	return ptr;
+}
+
+void FrameAllocation::operator delete(void* ptr, std::size_t size) {
+	SlabAllocator().free(ptr, Layout{ size, frame_alignment });
+}
+
+OP_HIDDEN_NAMESPACE_END
+
+void ScheduleAwaiter::await_suspend(std::coroutine_handle<> handle) const {
+	m_jobs.run(Function<void()>([handle]() { handle.resume(); }));
+}
+
+Task<void> when_all(JobSystem& jobs, Vector<Task<void>> tasks) {
+	hidden::AllState<void> state{ .remaining = tasks.len() + 1, .results = {}, .continuation = {} };
+	state.results.resize(tasks.len());
+	co_await hidden::AllAwaiter<void>(jobs, tasks, state);
+}
+
+OP_CORE_NAMESPACE_END
@@ -0,0 +1,189 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#pragma once
+
+#include "core/containers/option.h"
+#include "core/containers/shared.h"
+#include "core/containers/vector.h"
+#include "core/job_system.h"
+
+OP_SUPPRESS_WARNINGS_STD_BEGIN
+#include <coroutine>
+#include <cstddef>
+OP_SUPPRESS_WARNINGS_STD_END
+
+OP_CORE_NAMESPACE_BEGIN
+
+template <typename T = void>
+class Task;
+
+OP_HIDDEN_NAMESPACE_BEGIN
+
+// Coroutine frames come from the slab allocator, so most of them are recycled through its thread caches instead of
+// going to the general heap.
+struct FrameAllocation {
+	static void* operator new(std::size_t size);
+	static void operator delete(void* ptr, std::size_t size);
+};
+
+// Continues whoever awaited the task. Returning the handle instead of resuming it keeps long chains of co_await from
+// growing the stack.
+struct FinalAwaiter {
+	OP_ALWAYS_INLINE bool await_ready() const noexcept { return false; }
+	template <typename Promise>
+	std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept;
+	OP_ALWAYS_INLINE void await_resume() const noexcept {}
+};
+
+struct PromiseBase : FrameAllocation {
+	OP_ALWAYS_INLINE std::suspend_always initial_suspend() const noexcept { return {}; }
+	OP_ALWAYS_INLINE FinalAwaiter final_suspend() const noexcept { return {}; }
+	void unhandled_exception() const { OP_PANIC("Exceptions are not supported in tasks"); }
+
+	std::coroutine_handle<> continuation;
+};
+
+template <typename T>
+struct Promise : PromiseBase {
+	Task<T> get_return_object();
+	template <typename U>
+	void return_value(U&& value) {
+		result = T(op::forward<U>(value));
+	}
+
+	Option<T> result;
+};
+
+template <>
+struct Promise<void> : PromiseBase {
+	Task<void> get_return_object();
+	OP_ALWAYS_INLINE void return_void() const {}
+};
+
+// Coroutine that starts right away, is never awaited and frees itself when it finishes.
+struct Detached {
+	struct promise_type : FrameAllocation {
+		OP_ALWAYS_INLINE Detached get_return_object() const { return {}; }
+		OP_ALWAYS_INLINE std::suspend_never initial_suspend() const noexcept { return {}; }
+		OP_ALWAYS_INLINE std::suspend_never final_suspend() const noexcept { return {}; }
+		OP_ALWAYS_INLINE void return_void() const {}
+		void unhandled_exception() const { OP_PANIC("Exceptions are not supported in tasks"); }
+	};
+};
+
+OP_HIDDEN_NAMESPACE_END
+
+/**
+ * A coroutine that produces a T.
+ *
+ * Tasks are lazy: nothing runs until the task is awaited, and the awaiting coroutine continues right where the task
+ * finishes, on whichever thread that is. Awaiting schedule moves a coroutine onto a JobSystem's workers. Code that is not
+ * a coroutine gets at the result with block_on.
+ *
+ * @tparam T The type of the value the coroutine returns.
+ */
+template <typename T>
+class Task {
+public:
+	using promise_type = hidden::Promise<T>;
+
+	OP_ALWAYS_INLINE Task(Task&& move) noexcept : m_handle(move.m_handle) { move.m_handle = nullptr; }
+	OP_ALWAYS_INLINE Task& operator=(Task&& move) noexcept {
+		auto to_destroy = op::move(*this);
+		OP_UNUSED(to_destroy);
+
+		m_handle = move.m_handle;
+		move.m_handle = nullptr;
+		return *this;
+	}
+
+	Task(const Task& copy) = delete;
+	Task& operator=(const Task& copy) = delete;
+
+	~Task() {
+		if (m_handle) {
+			m_handle.destroy();
+		}
+	}
+
+	// Awaiter
+	OP_ALWAYS_INLINE bool await_ready() const noexcept { return m_handle.done(); }
+	OP_ALWAYS_INLINE std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+		m_handle.promise().continuation = awaiting;
+		return m_handle;
+	}
+	T await_resume();
+	// ~Awaiter
+
+private:
+	friend promise_type;
+
+	OP_ALWAYS_INLINE explicit Task(std::coroutine_handle<promise_type> handle) : m_handle(handle) {}
+
+	std::coroutine_handle<promise_type> m_handle;
+};
+
+// Awaiting the result continues the coroutine as a job on jobs.
+class ScheduleAwaiter {
+public:
+	OP_ALWAYS_INLINE explicit ScheduleAwaiter(JobSystem& jobs) : m_jobs(jobs) {}
+
+	OP_ALWAYS_INLINE bool await_ready() const noexcept { return false; }
+	void await_suspend(std::coroutine_handle<> handle) const;
+	OP_ALWAYS_INLINE void await_resume() const noexcept {}
+
+private:
+	JobSystem& m_jobs;
+};
+
+OP_NO_DISCARD OP_ALWAYS_INLINE ScheduleAwaiter schedule(JobSystem& jobs) { return ScheduleAwaiter(jobs); }
+
+/**
+ * Runs task on the calling thread until it first suspends, then waits for it the way JobSystem::wait does and returns
+ * its result.
+ */
+template <typename T>
+T block_on(JobSystem& jobs, Task<T>&& task);
+
+/**
+ * Starts task on jobs right away instead of when it is awaited. The returned task finishes with the same result once the
+ * started one has, so work can overlap with whatever the caller does before it awaits.
+ */
+template <typename T>
+OP_NO_DISCARD Task<T> spawn(JobSystem& jobs, Task<T>&& task);
+
+/**
+ * Runs every task on jobs in parallel and finishes once all of them have, with their results in the order of tasks.
+ */
+template <typename T>
+OP_NO_DISCARD Task<Vector<T>> when_all(JobSystem& jobs, Vector<Task<T>> tasks);
+OP_NO_DISCARD Task<void> when_all(JobSystem& jobs, Vector<Task<void>> tasks);
+
+template <typename T>
+struct WhenAny {
+	usize index;
+	T value;
+};
+
+/**
+ * Runs every task on jobs in parallel and finishes as soon as the first of them does, with its index and result. The
+ * other tasks still run to completion in the background and their results are dropped.
+ */
+template <typename T>
+OP_NO_DISCARD Task<WhenAny<T>> when_any(JobSystem& jobs, Vector<Task<T>> tasks);
+
+OP_CORE_NAMESPACE_END
+
+// Include the implementation
+#include "core/task.inl"
+
+// Export to op namespace
+OP_NAMESPACE_BEGIN
+using core::block_on;
+using core::schedule;
+using core::spawn;
+using core::Task;
+using core::when_all;
+using core::when_any;
+using core::WhenAny;
+OP_NAMESPACE_END
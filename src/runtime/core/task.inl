@@ -0,0 +1,219 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+OP_CORE_NAMESPACE_BEGIN
+
+OP_HIDDEN_NAMESPACE_BEGIN
+
+template <typename Promise>
+std::coroutine_handle<> FinalAwaiter::await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+	auto continuation = handle.promise().continuation;
+	if (continuation) {
+		return continuation;
+	}
+	return std::noop_coroutine();
+}
+
+template <typename T>
+Task<T> Promise<T>::get_return_object() {
+	return Task<T>(std::coroutine_handle<Promise<T>>::from_promise(*this));
+}
+
+inline Task<void> Promise<void>::get_return_object() {
+	return Task<void>(std::coroutine_handle<Promise<void>>::from_promise(*this));
+}
+
+// Where a task's value waits for the coroutine that awaits it. Empty for tasks without one.
+template <typename T>
+struct TaskResult {
+	Option<T> value;
+};
+
+template <>
+struct TaskResult<void> {};
+
+// Awaits task and stores its value in result.
+template <typename T>
+Task<void> store_result(Task<T>&& task, TaskResult<T>& result) {
+	if constexpr (std::is_void_v<T>) {
+		co_await task;
+		OP_UNUSED(result);
+	} else {
+		result.value = co_await task;
+	}
+}
+
+template <typename T>
+T take_result(TaskResult<T>& result) {
+	if constexpr (!std::is_void_v<T>) {
+		return op::move(result.value.as_mut().unwrap());
+	}
+}
+
+template <typename T>
+Detached run_blocking(JobSystem& jobs, Task<T> task, TaskResult<T>& result, JobCounter& counter) {
+	co_await store_result(op::move(task), result);
+	jobs.finish_pending(counter);
+}
+
+/**
+ * Hands a result between a task that runs on its own and the coroutine that awaits it. Whichever of the two arrives
+ * second continues the awaiting coroutine, so it never resumes before it has finished suspending.
+ */
+template <typename T>
+struct Handoff {
+	Atomic<u32> arrivals = 0;
+	TaskResult<T> result;
+	std::coroutine_handle<> continuation;
+
+	OP_ALWAYS_INLINE bool arrive() { return arrivals.fetch_add(1, Order::AcqRel) == 1; }
+};
+
+template <typename T>
+class HandoffAwaiter {
+public:
+	OP_ALWAYS_INLINE explicit HandoffAwaiter(Handoff<T>& handoff) : m_handoff(handoff) {}
+
+	OP_ALWAYS_INLINE bool await_ready() const noexcept { return false; }
+	OP_ALWAYS_INLINE bool await_suspend(std::coroutine_handle<> handle) noexcept {
+		m_handoff.continuation = handle;
+		return !m_handoff.arrive();
+	}
+	OP_ALWAYS_INLINE void await_resume() const noexcept {}
+
+private:
+	Handoff<T>& m_handoff;
+};
+
+template <typename T>
+Detached run_spawned(JobSystem& jobs, Task<T> task, Shared<Handoff<T>, SMode::Atomic> handoff) {
+	co_await schedule(jobs);
+	co_await store_result(op::move(task), handoff->result);
+	if (handoff->arrive()) {
+		handoff->continuation.resume();
+	}
+}
+
+template <typename T>
+Task<T> join_spawned(Shared<Handoff<T>, SMode::Atomic> handoff) {
+	co_await HandoffAwaiter<T>(*handoff);
+	co_return take_result(handoff->result);
+}
+
+// Results of when_all. Lives in the when_all coroutine, which only continues once every task is done with it.
+template <typename T>
+struct AllState {
+	// One per task plus one for the awaiter, which keeps the last task from continuing before it finished suspending.
+	Atomic<usize> remaining;
+	Vector<TaskResult<T>> results;
+	std::coroutine_handle<> continuation;
+};
+
+template <typename T>
+Detached run_all_part(JobSystem& jobs, Task<T> task, AllState<T>& state, usize index) {
+	co_await schedule(jobs);
+	co_await store_result(op::move(task), state.results[index]);
+	if (state.remaining.fetch_sub(1, Order::AcqRel) == 1) {
+		state.continuation.resume();
+	}
+}
+
+template <typename T>
+class AllAwaiter {
+public:
+	OP_ALWAYS_INLINE AllAwaiter(JobSystem& jobs, Vector<Task<T>>& tasks, AllState<T>& state)
+		: m_jobs(jobs)
+		, m_tasks(tasks)
+		, m_state(state) {}
+
+	OP_ALWAYS_INLINE bool await_ready() const noexcept { return false; }
+	bool await_suspend(std::coroutine_handle<> handle) {
+		m_state.continuation = handle;
+		for (usize index = 0; index < m_tasks.len(); ++index) {
+			run_all_part(m_jobs, op::move(m_tasks[index]), m_state, index);
+		}
+		return m_state.remaining.fetch_sub(1, Order::AcqRel) != 1;
+	}
+	OP_ALWAYS_INLINE void await_resume() const noexcept {}
+
+private:
+	JobSystem& m_jobs;
+	Vector<Task<T>>& m_tasks;
+	AllState<T>& m_state;
+};
+
+template <typename T>
+struct AnyState {
+	Atomic<bool> won = false;
+	usize index = 0;
+	Handoff<T> handoff;
+};
+
+template <typename T>
+Detached run_any_part(JobSystem& jobs, Task<T> task, Shared<AnyState<T>, SMode::Atomic> state, usize index) {
+	co_await schedule(jobs);
+	TaskResult<T> result;
+	co_await store_result(op::move(task), result);
+	if (state->won.exchange(true, Order::AcqRel)) {
+		co_return;
+	}
+
+	state->index = index;
+	state->handoff.result = op::move(result);
+	if (state->handoff.arrive()) {
+		state->handoff.continuation.resume();
+	}
+}
+
+OP_HIDDEN_NAMESPACE_END
+
+template <typename T>
+T Task<T>::await_resume() {
+	if constexpr (!std::is_void_v<T>) {
+		return op::move(m_handle.promise().result.as_mut().unwrap());
+	}
+}
+
+template <typename T>
+T block_on(JobSystem& jobs, Task<T>&& task) {
+	JobCounter counter;
+	hidden::TaskResult<T> result;
+	jobs.add_pending(counter);
+	hidden::run_blocking(jobs, op::move(task), result, counter);
+	jobs.wait(counter);
+	return hidden::take_result(result);
+}
+
+template <typename T>
+Task<T> spawn(JobSystem& jobs, Task<T>&& task) {
+	auto handoff = Shared<hidden::Handoff<T>, SMode::Atomic>::make();
+	hidden::run_spawned(jobs, op::move(task), handoff);
+	return hidden::join_spawned(op::move(handoff));
+}
+
+template <typename T>
+Task<Vector<T>> when_all(JobSystem& jobs, Vector<Task<T>> tasks) {
+	hidden::AllState<T> state{ .remaining = tasks.len() + 1, .results = {}, .continuation = {} };
+	state.results.resize(tasks.len());
+	co_await hidden::AllAwaiter<T>(jobs, tasks, state);
+
+	Vector<T> results;
+	results.reserve(tasks.len());
+	for (auto& result : state.results) {
+		results.push(hidden::take_result(result));
+	}
+	co_return results;
+}
+
+template <typename T>
+Task<WhenAny<T>> when_any(JobSystem& jobs, Vector<Task<T>> tasks) {
+	OP_ASSERT(tasks.len() > 0, "when_any needs a task to finish");
+
+	auto state = Shared<hidden::AnyState<T>, SMode::Atomic>::make();
+	for (usize index = 0; index < tasks.len(); ++index) {
+		hidden::run_any_part(jobs, op::move(tasks[index]), state, index);
+	}
+	co_await hidden::HandoffAwaiter<T>(state->handoff);
+	co_return WhenAny<T>{ .index = state->index, .value = hidden::take_result(state->handoff.result) };
+}
+
+OP_CORE_NAMESPACE_END
@@ -31,13 +31,18 @@ Storage const& Archetype::find_storage(ComponentType component) const {
 	return const_cast<Archetype*>(this)->find_storage(component);
 }
 
-u32 Archetype::next_slot_index() {
+u32 Archetype::next_slot_index(EntityId owner) {
 	// If there are no free slots, return the number of slots in the archetype
 	if (m_free_slot_indices.is_empty()) {
-		return m_storages[0]->total_slots();
+		const auto index = m_storages[0]->total_slots();
+		OP_ASSERT(index == m_entities.len());
+		m_entities.push(owner);
+		return index;
 	}
 
-	return m_free_slot_indices.pop().unwrap();
+	const auto index = m_free_slot_indices.pop().unwrap();
+	m_entities[index] = owner;
+	return index;
 }
 
 void Archetype::transfer_to(Archetype& other, u32 from, u32 to) {
@@ -57,4 +62,95 @@ void Archetype::transfer_to(Archetype& other, u32 from, u32 to) {
 	}
 }
 
+void Archetype::discard(u32 index) {
+	m_free_slot_indices.push(index);
+
+	for (auto& storage : m_storages) {
+		storage->discard(index);
+	}
+}
+
+u32 Archetype::append(Archetype& other, u32 tick) {
+	OP_ASSERT(m_signature == other.m_signature, "Only archetypes with the same components can be appended.");
+
+	const auto base = total_slots();
+	for (auto& storage : m_storages) {
+		storage->append_from(other.find_storage(storage->type()), tick);
+	}
+
+	m_entities.reserve(other.m_entities.len());
+	for (auto owner : other.m_entities) {
+		m_entities.push(owner);
+	}
+	for (auto index : other.m_free_slot_indices) {
+		m_free_slot_indices.push(base + index);
+	}
+	other.m_entities = {};
+	other.m_free_slot_indices = {};
+
+	return base;
+}
+
+u32 Archetype::compact(FunctionRef<void(EntityId, u32)> on_moved) {
+	// Fill holes at the front with used slots taken from the back until the used slots are contiguous.
+	auto len = total_slots();
+	u32 hole = 0;
+	u32 moved = 0;
+	while (true) {
+		while (len > 0 && !is_slot_used(len - 1)) {
+			len -= 1;
+		}
+		while (hole < len && is_slot_used(hole)) {
+			hole += 1;
+		}
+		if (hole >= len) {
+			break;
+		}
+
+		const auto from = len - 1;
+		for (auto& storage : m_storages) {
+			storage->move_slot(from, hole);
+		}
+		m_entities[hole] = m_entities[from];
+		on_moved(m_entities[hole], hole);
+
+		len -= 1;
+		moved += 1;
+	}
+
+	for (auto& storage : m_storages) {
+		storage->truncate(len);
+	}
+
+	Vector<EntityId> entities;
+	entities.reserve(len);
+	for (u32 index = 0; index < len; ++index) {
+		entities.push(m_entities[index]);
+	}
+	m_entities = op::move(entities);
+	m_free_slot_indices = {};
+
+	return moved;
+}
+
+usize Archetype::allocated_bytes() const {
+	usize result = m_entities.cap() * sizeof(EntityId) + m_free_slot_indices.cap() * sizeof(u32);
+	if (!m_storages.is_inline()) {
+		result += m_storages.cap() * sizeof(Unique<Storage>);
+	}
+	for (auto& storage : m_storages) {
+		result += storage->allocated_bytes();
+	}
+	return result;
+}
+
+Vector<ComponentType> Archetype::component_types() const {
+	Vector<ComponentType> result;
+	result.reserve(m_storages.len());
+	for (auto& storage : m_storages) {
+		result.push(storage->type());
+	}
+	return result;
+}
+
 OP_GAME_NAMESPACE_END
\ No newline at end of file
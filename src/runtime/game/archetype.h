@@ -2,15 +2,19 @@
 
 #pragma once
 
+#include "core/containers/function.h"
+#include "game/entity.h"
+#include "game/signature.h"
 #include "game/storage.h"
 
 OP_GAME_NAMESPACE_BEGIN
 
 class Archetype {
 public:
-	explicit Archetype() = default;
+	explicit Archetype(ComponentSignature signature) : m_signature(op::move(signature)) {}
 
 	bool supports(ComponentType type) const;
+	OP_ALWAYS_INLINE ComponentSignature const& signature() const { return m_signature; }
 	OP_ALWAYS_INLINE u32 available_slots() const { return static_cast<u32>(m_free_slot_indices.len()); }
 	OP_ALWAYS_INLINE u32 total_slots() const { return static_cast<u32>(m_storages[0]->total_slots()); }
 	OP_ALWAYS_INLINE u32 count() const { return total_slots() - available_slots(); }
@@ -40,12 +44,45 @@ public:
 		typed_storage.store(op::forward<T>(component), index);
 	}
 	void transfer_to(Archetype& other, u32 from, u32 to);
+	void discard(u32 index);
+
+	/**
+	 * Appends every column of other, which must have the same signature, to this archetype and leaves other empty.
+	 * Slot indices of other are offset by the returned base. Entity ids are copied as is and must be remapped by the
+	 * caller with set_entity.
+	 */
+	OP_NO_DISCARD u32 append(Archetype& other, u32 tick);
+
+	/**
+	 * Moves used slots from the back into free slots at the front and then releases the unused tail. on_moved is called
+	 * with the owner and new index of every slot that moved. Returns the number of moved slots.
+	 */
+	u32 compact(FunctionRef<void(EntityId, u32)> on_moved);
+
+	// Bytes allocated by the archetype's storages and bookkeeping including unused capacity.
+	OP_NO_DISCARD usize allocated_bytes() const;
+
+	// Component types stored by this archetype in storage order.
+	OP_NO_DISCARD Vector<ComponentType> component_types() const;
+
+	OP_ALWAYS_INLINE void mark_changed(ComponentType component, u32 index, u32 tick) {
+		find_storage(component).set_changed_tick(index, tick);
+	}
+	OP_NO_DISCARD OP_ALWAYS_INLINE u32 changed_tick(ComponentType component, u32 index) const {
+		return find_storage(component).changed_tick(index);
+	}
+
+	// Entity that owns the slot. Only meaningful while the slot is used.
+	OP_NO_DISCARD OP_ALWAYS_INLINE EntityId entity(u32 index) const { return m_entities[index]; }
+	OP_ALWAYS_INLINE void set_entity(u32 index, EntityId owner) { m_entities[index] = owner; }
 
 	OP_ALWAYS_INLINE void push_storage(Unique<Storage>&& storage) { m_storages.push(op::move(storage)); }
-	OP_NO_DISCARD u32 next_slot_index();
+	OP_NO_DISCARD u32 next_slot_index(EntityId owner);
 
 private:
-	Vector<Unique<Storage>> m_storages;
+	ComponentSignature m_signature;
+	SmallVector<Unique<Storage>, 4> m_storages;
+	Vector<EntityId> m_entities;
 	Vector<u32> m_free_slot_indices;
 };
 
@@ -13,9 +13,9 @@ void ComponentTypeInfo::add_property(StringView name, usize offset, usize size,
 	m_properties.push(op::move(property));
 }
 
-Shared<ComponentRegistry> ComponentRegistry::make() {
+AtomicShared<ComponentRegistry> ComponentRegistry::make() {
 	ComponentRegistry result;
-	return Shared<ComponentRegistry>::make(op::move(result));
+	return AtomicShared<ComponentRegistry>::make(op::move(result));
 }
 
 ComponentTypeInfo const& ComponentRegistry::find(ComponentType type) const {
@@ -24,6 +24,45 @@ ComponentTypeInfo const& ComponentRegistry::find(ComponentType type) const {
 	return result.unwrap();
 }
 
+ComponentSignature ComponentRegistry::signature(Slice<ComponentType const> types) const {
+	ComponentSignature result;
+	for (auto type : types) {
+		result.set(find(type).index());
+	}
+	return result;
+}
+
+ComponentRegistry& ComponentRegistry::observe(ComponentType type, ComponentEvent event, ComponentObserver&& observer) {
+	m_observers.push(Observer{ type, event, op::move(observer) });
+	return *this;
+}
+
+bool ComponentRegistry::is_observed(ComponentType type, ComponentEvent event) const {
+	for (auto& observer : m_observers) {
+		if (observer.type == type && observer.event == event) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void ComponentRegistry::notify(
+	World& world,
+	ComponentType type,
+	ComponentEvent event,
+	Slice<EntityId const> entities
+) const {
+	if (entities.is_empty()) {
+		return;
+	}
+
+	for (auto& observer : m_observers) {
+		if (observer.type == type && observer.event == event) {
+			observer.callback(world, entities);
+		}
+	}
+}
+
 OP_GAME_IMPLEMENT_COMPONENT(Transform) {
 	OP_GAME_REGISTER_PROPERTY(Transform, position);
 	OP_GAME_REGISTER_PROPERTY(Transform, rotation);
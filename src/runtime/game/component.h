@@ -2,11 +2,13 @@
 
 #pragma once
 
+#include "core/containers/function.h"
 #include "core/containers/map.h"
 #include "core/containers/shared.h"
 #include "core/containers/string.h"
 #include "core/containers/unique.h"
 #include "game/entity.h"
+#include "game/signature.h"
 #include "game/storage.h"
 
 OP_GAME_NAMESPACE_BEGIN
@@ -20,9 +22,10 @@ class ComponentTypeInfo {
 public:
 	using CreateStorageFn = Unique<Storage> (*)(void);
 
-	explicit ComponentTypeInfo(StringView name, usize size, CreateStorageFn create_storage_fn)
+	explicit ComponentTypeInfo(StringView name, usize size, u32 index, CreateStorageFn create_storage_fn)
 		: m_name(name)
 		, m_size(size)
+		, m_index(index)
 		, m_create_storage_fn(create_storage_fn) {}
 
 	struct Property {
@@ -37,12 +40,15 @@ public:
 
 	OP_ALWAYS_INLINE StringView name() const { return m_name; }
 	OP_ALWAYS_INLINE usize size() const { return m_size; }
+	// Dense index assigned at registration. Used as the bit for this type in a ComponentSignature.
+	OP_ALWAYS_INLINE u32 index() const { return m_index; }
 	OP_ALWAYS_INLINE Slice<Property const> properties() const { return m_properties; }
 	OP_ALWAYS_INLINE Unique<Storage> create_storage() const { return m_create_storage_fn(); }
 
 private:
 	StringView m_name;
 	usize m_size;
+	u32 m_index;
 
 	Vector<Property> m_properties;
 	CreateStorageFn m_create_storage_fn;
@@ -50,28 +56,56 @@ private:
 
 #define OP_GAME_REGISTER_COMPONENT(registry, component) (registry).register_component<component>(#component)
 
+class World;
+
+enum class ComponentEvent : u8 { Added, Removed };
+
+/**
+ * Called with every entity that had a component added or removed since the world last flushed its events.
+ *
+ * Observers are dispatched in batches by World::flush_events, one call per component type and event, so they never
+ * run in the middle of a structural change.
+ */
+using ComponentObserver = Function<void(World&, Slice<EntityId const>)>;
+
 /**
  * Registers component types and their properties.
+ *
+ * Reference counted atomically so worlds on different threads can share one registry. Registration and observers are
+ * not synchronised and must be set up before worlds are built concurrently.
  */
-class ComponentRegistry : public SharedFromThis<ComponentRegistry> {
+class ComponentRegistry : public AtomicSharedFromThis<ComponentRegistry> {
 public:
-	static Shared<ComponentRegistry> make();
+	static AtomicShared<ComponentRegistry> make();
 
 	template <typename Component>
 	ComponentRegistry& register_component(StringView name) {
 		auto create_storage_fn = []() -> Unique<Storage> { return Unique<VectorStorage<Component>>::make(); };
-		auto info = ComponentTypeInfo(name, sizeof(Component), create_storage_fn);
+		const auto index = static_cast<u32>(m_types.len());
+		auto info = ComponentTypeInfo(name, sizeof(Component), index, create_storage_fn);
 		Component::fill_type_info(info);
 		m_types.insert(Component::type(), op::move(info));
 		return *this;
 	}
 
 	ComponentTypeInfo const& find(ComponentType type) const;
+	ComponentSignature signature(Slice<ComponentType const> types) const;
+
+	ComponentRegistry& observe(ComponentType type, ComponentEvent event, ComponentObserver&& observer);
+	OP_NO_DISCARD bool is_observed(ComponentType type, ComponentEvent event) const;
+	void notify(World& world, ComponentType type, ComponentEvent event, Slice<EntityId const> entities) const;
 
 private:
 	explicit ComponentRegistry() = default;
 
 	Map<ComponentType, ComponentTypeInfo> m_types;
+
+	struct Observer {
+		ComponentType type;
+		ComponentEvent event;
+		ComponentObserver callback;
+	};
+	Vector<Observer> m_observers;
 };
 
 #define OP_GAME_COMPONENT(component)                                                                                   \
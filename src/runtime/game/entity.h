@@ -2,9 +2,15 @@
 
 #pragma once
 
-#include "core/containers/slot_map.h"
+#include "core/containers/concurrent_slot_map.h"
+#include "core/containers/small_vector.h"
 #include "game/game.h"
 
+// The number of entities a World can hold. The default keeps the page table at 8 KiB. Must stay below 2^32.
+#ifndef OP_MAX_ENTITIES
+	#define OP_MAX_ENTITIES (1024 * 1024)
+#endif
+
 OP_GAME_NAMESPACE_BEGIN
 
 class Entity {
@@ -40,11 +46,22 @@ public:
 	}
 
 	OP_ALWAYS_INLINE Slice<ComponentType const> components() const { return m_components; }
+	// Bytes allocated for the component list including unused capacity. Zero while the list fits inline.
+	OP_ALWAYS_INLINE usize allocated_bytes() const {
+		return m_components.is_inline() ? 0 : m_components.cap() * sizeof(ComponentType);
+	}
 
 private:
 	Option<ComponentStorage> m_component_storage;
-	Vector<ComponentType> m_components;
+	// Most entities only have a handful of components so the list is kept inline until it grows past them.
+	SmallVector<ComponentType, 4> m_components;
 };
-using EntityId = SlotMap<Entity>::Key;
+// Entity slots are allocated in pages of this many entities.
+inline constexpr usize entity_page_len = 1024;
+
+// Entities can be spawned, despawned and resolved from several job threads at once. The page table is stored inline
+// so a World can hold at most OP_MAX_ENTITIES entities, rounded up to a whole page, and spawning past that asserts.
+using EntityMap = ConcurrentSlotMap<Entity, entity_page_len, (OP_MAX_ENTITIES + entity_page_len - 1) / entity_page_len>;
+using EntityId = EntityMap::Key;
 
 OP_GAME_NAMESPACE_END
@@ -13,6 +13,9 @@ set(GAME_SRC_FILES
         ${GAME_ROOT}/game.cpp
         ${GAME_ROOT}/query.h
         ${GAME_ROOT}/query.cpp
+        ${GAME_ROOT}/signature.h
+        ${GAME_ROOT}/spatial.h
+        ${GAME_ROOT}/spatial.cpp
         ${GAME_ROOT}/storage.h
         ${GAME_ROOT}/world.h
         ${GAME_ROOT}/world.cpp
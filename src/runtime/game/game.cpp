@@ -6,7 +6,7 @@
 OP_GAME_NAMESPACE_BEGIN
 
 ComponentType::ComponentType(StringView name) {
-	core::FNV1Hasher hasher;
+	core::WyHasher hasher;
 	hasher.write(Slice<u8 const>(reinterpret_cast<const u8*>(*name), name.len()));
 	m_value = hasher.finish();
 }
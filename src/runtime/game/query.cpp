@@ -1,6 +1,7 @@
 // Copyright Colby Hall. All Rights Reserved.
 
 #include "game/query.h"
+#include "core/arena.h"
 #include "game/world.h"
 
 OP_GAME_NAMESPACE_BEGIN
@@ -15,42 +16,100 @@ Query& Query::write(ComponentType component) {
 	return *this;
 }
 
+Query& Query::with(ComponentType component) {
+	m_with.push(component);
+	return *this;
+}
+
+Query& Query::without(ComponentType component) {
+	m_without.push(component);
+	return *this;
+}
+
+Query& Query::optional_read(ComponentType component) {
+	m_optional_reads.push(component);
+	return *this;
+}
+
+Query& Query::optional_write(ComponentType component) {
+	m_optional_writes.push(component);
+	return *this;
+}
+
+Query& Query::any_of(Slice<ComponentType const> components) {
+	m_any.push(Vector<ComponentType>::from(components));
+	return *this;
+}
+
+Query& Query::changed_since(ComponentType component, u32 tick) {
+	m_with.push(component);
+	m_changed.push(ChangeFilter{ component, tick });
+	return *this;
+}
+
+bool Query::Filter::matches(ComponentSignature const& signature) const {
+	if (!signature.contains_all(required)) return false;
+	if (signature.intersects(excluded)) return false;
+
+	for (auto& group : any) {
+		if (!signature.intersects(group)) return false;
+	}
+
+	return true;
+}
+
+Query::Filter Query::compile(ComponentRegistry const& registry) const {
+	Filter result;
+	for (auto component : m_reads) {
+		result.required.set(registry.find(component).index());
+	}
+	for (auto component : m_writes) {
+		result.required.set(registry.find(component).index());
+	}
+	for (auto component : m_with) {
+		result.required.set(registry.find(component).index());
+	}
+	for (auto component : m_without) {
+		result.excluded.set(registry.find(component).index());
+	}
+	for (auto& group : m_any) {
+		result.any.push(registry.signature(group));
+	}
+	return result;
+}
+
 void Query::execute(World& world, FunctionRef<void(Query::View&)> callback) {
-	// Gather all archetypes that match the query
-	Vector<u32> archetypes;
+	const auto filter = compile(*world.m_component_registry);
+
+	// Gather all archetypes that match the query. The list only lives for this call so it goes in the scratch arena.
+	ArenaScope scope(scratch_arena());
+	Vector<u32, ArenaAllocator> archetypes{ ArenaAllocator(scratch_arena()) };
 	archetypes.reserve(world.m_archetypes.len());
 	for (u32 index = 0; index < world.m_archetypes.len(); ++index) {
-		bool has_read = true;
-		for (auto read : m_reads) {
-			if (!world.m_archetypes[index].supports(read)) {
-				has_read = false;
-				break;
-			}
-		}
-		if (!has_read) continue;
-
-		bool has_write = true;
-		for (auto write : m_writes) {
-			if (!world.m_archetypes[index].supports(write)) {
-				has_write = false;
-				break;
-			}
-		}
-
-		if (has_write) {
+		if (filter.matches(world.m_archetypes[index].signature())) {
 			archetypes.push(index);
 		}
 	}
 
+	const auto change_tick = world.change_tick();
 	for (auto archetype_index : archetypes) {
 		auto& archetype = world.m_archetypes[archetype_index];
 		for (u32 index = 0; index < archetype.total_slots(); ++index) {
-			if (archetype.is_slot_used(index)) {
-				auto view = View(m_reads, m_writes, archetype, index);
-				callback(view);
+			if (!archetype.is_slot_used(index)) continue;
+
+			bool changed = true;
+			for (auto& changed_filter : m_changed) {
+				if (archetype.changed_tick(changed_filter.component, index) <= changed_filter.tick) {
+					changed = false;
+					break;
+				}
 			}
+			if (!changed) continue;
+
+			auto view = View(*this, archetype, index, change_tick);
+			callback(view);
 		}
 	}
 }
 
-OP_GAME_NAMESPACE_END
\ No newline at end of file
+OP_GAME_NAMESPACE_END
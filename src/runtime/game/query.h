@@ -1,13 +1,28 @@
 // Copyright Colby Hall. All Rights Reserved.
 
+#pragma once
+
 #include "core/containers/function.h"
+#include "core/containers/small_vector.h"
 #include "core/containers/vector.h"
 #include "game/archetype.h"
 
 OP_GAME_NAMESPACE_BEGIN
 
 class World;
+class ComponentRegistry;
 
+/**
+ * Iterates all entities whose archetype matches a set of terms.
+ *
+ * Terms are compiled into component signatures so matching an archetype is a handful of bitwise tests:
+ * - read, write and with components must all be present.
+ * - without components must all be absent.
+ * - optional reads and writes never affect matching, they only grant access when the archetype has the component.
+ * - each any_of group must have at least one of its components present.
+ *
+ * changed_since is the only term tested per entity as change ticks are tracked per slot.
+ */
 class Query {
 public:
 	explicit Query() = default;
@@ -15,23 +30,35 @@ public:
 	Query& read(ComponentType component);
 	Query& write(ComponentType component);
 
+	// Requires the component to be present without granting access to its data.
+	Query& with(ComponentType component);
+	// Excludes archetypes that have the component.
+	Query& without(ComponentType component);
+
+	// Grants access to the component when present without requiring it.
+	Query& optional_read(ComponentType component);
+	Query& optional_write(ComponentType component);
+
+	// Requires at least one of the components to be present.
+	Query& any_of(Slice<ComponentType const> components);
+
+	// Requires the component and only visits entities where it was written after tick.
+	Query& changed_since(ComponentType component, u32 tick);
+
 	class View {
 	public:
-		explicit View(
-			Slice<const ComponentType> reads,
-			Slice<const ComponentType> writes,
-			Archetype& archetype,
-			u32 slot
-		)
-			: m_reads(reads)
-			, m_writes(writes)
+		explicit View(Query const& query, Archetype& archetype, u32 slot, u32 change_tick)
+			: m_query(query)
 			, m_archetype(archetype)
-			, slot(slot) {}
+			, slot(slot)
+			, m_change_tick(change_tick) {}
+
+		OP_NO_DISCARD OP_ALWAYS_INLINE EntityId entity() const { return m_archetype.entity(slot); }
 
 		template <typename T>
 		T const& read() const {
 			Option<T const&> result = nullopt;
-			for (auto& component : m_reads) {
+			for (auto& component : m_query.m_reads) {
 				if (component == T::type()) {
 					result = m_archetype.read<T>(slot);
 					break;
@@ -43,27 +70,89 @@ public:
 		template <typename T>
 		T& write() {
 			Option<T&> result = nullopt;
-			for (auto& component : m_writes) {
+			for (auto& component : m_query.m_writes) {
 				if (component == T::type()) {
 					result = m_archetype.write<T>(slot);
+					m_archetype.mark_changed(component, slot, m_change_tick);
 					break;
 				}
 			}
 			return result.unwrap();
 		}
 
+		// Returns nullopt when the archetype lacks the component or the query was not given read access to it.
+		template <typename T>
+		Option<T const&> try_read() const {
+			if (!m_archetype.supports(T::type())) {
+				return nullopt;
+			}
+			for (auto& component : m_query.m_optional_reads) {
+				if (component == T::type()) {
+					return m_archetype.read<T>(slot);
+				}
+			}
+			for (auto& component : m_query.m_reads) {
+				if (component == T::type()) {
+					return m_archetype.read<T>(slot);
+				}
+			}
+			return nullopt;
+		}
+
+		// Returns nullopt when the archetype lacks the component or the query was not given write access to it.
+		template <typename T>
+		Option<T&> try_write() {
+			if (!m_archetype.supports(T::type())) {
+				return nullopt;
+			}
+			for (auto& component : m_query.m_optional_writes) {
+				if (component == T::type()) {
+					m_archetype.mark_changed(component, slot, m_change_tick);
+					return m_archetype.write<T>(slot);
+				}
+			}
+			for (auto& component : m_query.m_writes) {
+				if (component == T::type()) {
+					m_archetype.mark_changed(component, slot, m_change_tick);
+					return m_archetype.write<T>(slot);
+				}
+			}
+			return nullopt;
+		}
+
 	private:
-		Slice<const ComponentType> m_reads;
-		Slice<const ComponentType> m_writes;
+		Query const& m_query;
 
 		Archetype& m_archetype;
 		u32 slot;
+		u32 m_change_tick;
 	};
 	void execute(World& world, FunctionRef<void(View&)> callback);
 
 private:
-	Vector<ComponentType> m_reads;
-	Vector<ComponentType> m_writes;
+	struct Filter {
+		ComponentSignature required;
+		ComponentSignature excluded;
+		Vector<ComponentSignature> any;
+
+		OP_NO_DISCARD bool matches(ComponentSignature const& signature) const;
+	};
+	OP_NO_DISCARD Filter compile(ComponentRegistry const& registry) const;
+
+	// Queries rarely name more than a few components per list so these are kept inline to avoid allocating per query.
+	SmallVector<ComponentType, 4> m_reads;
+	SmallVector<ComponentType, 4> m_writes;
+	SmallVector<ComponentType, 4> m_with;
+	SmallVector<ComponentType, 4> m_without;
+	Vector<ComponentType> m_optional_reads;
+	Vector<ComponentType> m_optional_writes;
+	Vector<Vector<ComponentType>> m_any;
+
+	struct ChangeFilter {
+		ComponentType component;
+		u32 tick;
+	};
+	Vector<ChangeFilter> m_changed;
 };
 
-OP_GAME_NAMESPACE_END
\ No newline at end of file
+OP_GAME_NAMESPACE_END
@@ -0,0 +1,47 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#pragma once
+
+#include "core/containers/bit_vector.h"
+#include "game/game.h"
+
+OP_GAME_NAMESPACE_BEGIN
+
+/**
+ * A set of component types stored as a bitset.
+ *
+ * Each bit is the dense index the ComponentRegistry assigned to a component type when it was registered. Archetypes
+ * store the signature of the components they hold so queries can match them with word wide bitwise tests.
+ */
+class ComponentSignature {
+public:
+	explicit ComponentSignature() = default;
+
+	OP_ALWAYS_INLINE void set(u32 index) { m_bits.set(index); }
+	OP_NO_DISCARD OP_ALWAYS_INLINE bool contains(u32 index) const { return m_bits.is_set(index); }
+
+	/**
+	 * @return true if every component in other is also in this signature.
+	 */
+	OP_NO_DISCARD OP_ALWAYS_INLINE bool contains_all(const ComponentSignature& other) const {
+		return m_bits.contains_all(other.m_bits);
+	}
+
+	/**
+	 * @return true if at least one component in other is also in this signature.
+	 */
+	OP_NO_DISCARD OP_ALWAYS_INLINE bool intersects(const ComponentSignature& other) const {
+		return m_bits.intersects(other.m_bits);
+	}
+
+	OP_NO_DISCARD OP_ALWAYS_INLINE bool is_empty() const { return m_bits.is_empty(); }
+
+	// Signatures may store different word counts and still be equal if the extra words are all zero.
+	OP_ALWAYS_INLINE bool operator==(const ComponentSignature& other) const { return m_bits == other.m_bits; }
+	OP_ALWAYS_INLINE bool operator!=(const ComponentSignature& other) const { return !(*this == other); }
+
+private:
+	BitVector<> m_bits;
+};
+
+OP_GAME_NAMESPACE_END
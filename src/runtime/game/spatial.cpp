@@ -0,0 +1,199 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#include "game/spatial.h"
+#include "game/query.h"
+#include "game/world.h"
+
+OP_GAME_NAMESPACE_BEGIN
+
+// Queries that touch more cells than this scan every entry instead of visiting cells one at a time.
+static constexpr i64 max_cells_per_query = 64;
+
+static OP_ALWAYS_INLINE i32 floor_to_i32(f32 value) {
+	// Converting a float outside the range of i32 is undefined so clamp first. NaN lands on the lower bound.
+	if (!(value >= static_cast<f32>(core::I32_MIN))) return core::I32_MIN;
+	if (value >= -static_cast<f32>(core::I32_MIN)) return core::I32_MAX;
+
+	const auto truncated = static_cast<i32>(value);
+	return value < static_cast<f32>(truncated) ? truncated - 1 : truncated;
+}
+
+SpatialHashGrid::SpatialHashGrid(f32 cell_size, u32 bucket_count)
+	: m_cell_size(cell_size)
+	, m_inv_cell_size(1.f / cell_size) {
+	OP_ASSERT(cell_size > 0.f);
+	OP_ASSERT(bucket_count > 0);
+
+	m_buckets.reserve(bucket_count);
+	for (u32 index = 0; index < bucket_count; ++index) {
+		m_buckets.push({});
+	}
+}
+
+void SpatialHashGrid::observe(ComponentRegistry& registry) {
+	registry.observe(Transform::type(), ComponentEvent::Removed, [this](World&, Slice<EntityId const> entities) {
+		for (auto id : entities) {
+			remove(id);
+		}
+	});
+}
+
+void SpatialHashGrid::update(World& world) {
+	const auto since = m_last_change_tick;
+	m_last_change_tick = world.increment_change_tick();
+
+	auto query = Query().read(Transform::type()).changed_since(Transform::type(), since);
+	query.execute(world, [this](Query::View& view) {
+		insert_or_move(view.entity(), view.read<Transform>().position);
+	});
+}
+
+void SpatialHashGrid::remove(EntityId id) {
+	const auto index = id.index();
+	if (index >= m_entries.len()) {
+		return;
+	}
+
+	auto entry_opt = m_entries[index].as_mut();
+	if (!entry_opt || entry_opt.unwrap().id != id) {
+		return;
+	}
+
+	const auto& entry = entry_opt.unwrap();
+	unlink(entry.bucket, entry.bucket_index);
+	m_entries[index] = nullopt;
+	m_len -= 1;
+}
+
+void SpatialHashGrid::query_radius(const Vector3<f32>& center, f32 radius, Vector<EntityId>& out) const {
+	const auto extent = Vector3<f32>(radius);
+	const auto min = to_cell(center - extent);
+	const auto max = to_cell(center + extent);
+	const auto radius_sq = radius * radius;
+	gather(
+		min,
+		max,
+		[&](const Vector3<f32>& position) { return (position - center).len_sq() <= radius_sq; },
+		out
+	);
+}
+
+void SpatialHashGrid::query_aabb(const Vector3<f32>& min, const Vector3<f32>& max, Vector<EntityId>& out) const {
+	gather(
+		to_cell(min),
+		to_cell(max),
+		[&](const Vector3<f32>& position) {
+			return position.x >= min.x && position.y >= min.y && position.z >= min.z && position.x <= max.x &&
+				   position.y <= max.y && position.z <= max.z;
+		},
+		out
+	);
+}
+
+template <typename Test>
+void SpatialHashGrid::gather(const Cell& min, const Cell& max, Test&& test, Vector<EntityId>& out) const {
+	// Extents are taken in i64 as cells span the whole i32 range. Each axis is checked on its own before multiplying so
+	// the product can not overflow.
+	const auto extent_x = static_cast<i64>(max.x) - static_cast<i64>(min.x) + 1;
+	const auto extent_y = static_cast<i64>(max.y) - static_cast<i64>(min.y) + 1;
+	const auto extent_z = static_cast<i64>(max.z) - static_cast<i64>(min.z) + 1;
+	if (extent_x <= 0 || extent_y <= 0 || extent_z <= 0) {
+		return;
+	}
+
+	// Large queries would visit more buckets than there are entities nearby so test everything directly.
+	const bool too_large = extent_x > max_cells_per_query || extent_y > max_cells_per_query ||
+						   extent_z > max_cells_per_query || extent_x * extent_y * extent_z > max_cells_per_query;
+	if (too_large) {
+		for (auto& entry_opt : m_entries) {
+			if (!entry_opt) continue;
+			const auto& entry = entry_opt.as_ref().unwrap();
+			if (test(entry.position)) {
+				out.push(entry.id);
+			}
+		}
+		return;
+	}
+
+	// Distinct cells may hash to the same bucket. Visit each bucket once so no entity is reported twice.
+	u32 visited[max_cells_per_query];
+	usize visited_len = 0;
+	for (i64 z = min.z; z <= max.z; ++z) {
+		for (i64 y = min.y; y <= max.y; ++y) {
+			for (i64 x = min.x; x <= max.x; ++x) {
+				const auto bucket = to_bucket(Cell{ static_cast<i32>(x), static_cast<i32>(y), static_cast<i32>(z) });
+
+				bool seen = false;
+				for (usize index = 0; index < visited_len; ++index) {
+					if (visited[index] == bucket) {
+						seen = true;
+						break;
+					}
+				}
+				if (seen) continue;
+				visited[visited_len] = bucket;
+				visited_len += 1;
+
+				for (auto entry_index : m_buckets[bucket]) {
+					const auto& entry = m_entries[entry_index].as_ref().unwrap();
+					if (test(entry.position)) {
+						out.push(entry.id);
+					}
+				}
+			}
+		}
+	}
+}
+
+SpatialHashGrid::Cell SpatialHashGrid::to_cell(const Vector3<f32>& position) const {
+	return Cell{ floor_to_i32(position.x * m_inv_cell_size),
+				 floor_to_i32(position.y * m_inv_cell_size),
+				 floor_to_i32(position.z * m_inv_cell_size) };
+}
+
+u32 SpatialHashGrid::to_bucket(const Cell& cell) const {
+	// Primes from "Optimized Spatial Hashing for Collision Detection of Deformable Objects" (Teschner et al.)
+	const auto hash = (static_cast<u32>(cell.x) * 73856093u) ^ (static_cast<u32>(cell.y) * 19349663u) ^
+					  (static_cast<u32>(cell.z) * 83492791u);
+	return hash % static_cast<u32>(m_buckets.len());
+}
+
+void SpatialHashGrid::insert_or_move(EntityId id, const Vector3<f32>& position) {
+	const auto index = id.index();
+	while (m_entries.len() <= index) {
+		m_entries.push(nullopt);
+	}
+
+	const auto bucket = to_bucket(to_cell(position));
+	auto entry_opt = m_entries[index].as_mut();
+	if (entry_opt) {
+		auto& entry = entry_opt.unwrap();
+		if (entry.id == id && entry.bucket == bucket) {
+			entry.position = position;
+			return;
+		}
+
+		// Either the entity moved to another bucket or the slot was reused by a new entity.
+		unlink(entry.bucket, entry.bucket_index);
+	} else {
+		m_len += 1;
+	}
+
+	const auto bucket_index = static_cast<u32>(m_buckets[bucket].push(index));
+	m_entries[index] = Entry{ id, position, bucket, bucket_index };
+}
+
+void SpatialHashGrid::unlink(u32 bucket, u32 bucket_index) {
+	// Swap the last entry of the bucket into the hole so removal is O(1).
+	auto& entries = m_buckets[bucket];
+	const auto last = static_cast<u32>(entries.len() - 1);
+	if (bucket_index != last) {
+		const auto moved = entries[last];
+		entries[bucket_index] = moved;
+		m_entries[moved].as_mut().unwrap().bucket_index = bucket_index;
+	}
+	auto removed = entries.pop();
+	OP_UNUSED(removed);
+}
+
+OP_GAME_NAMESPACE_END
@@ -0,0 +1,84 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#pragma once
+
+#include "core/math/vector3.h"
+#include "game/component.h"
+#include "game/entity.h"
+
+OP_GAME_NAMESPACE_BEGIN
+
+class World;
+
+/**
+ * Uniform spatial hash over Transform::position.
+ *
+ * Space is divided into cubic cells of cell_size which are hashed into a fixed number of buckets. Cells that collide in
+ * the same bucket are told apart by the exact position test done during queries, so the bucket count only trades memory
+ * for the amount of filtering.
+ *
+ * The grid is kept up to date incrementally. update only visits entities whose Transform was written since the last
+ * update and removals are delivered by a component observer.
+ */
+class SpatialHashGrid {
+public:
+	explicit SpatialHashGrid(f32 cell_size, u32 bucket_count = 4096);
+
+	/**
+	 * Registers an observer that drops entities from the grid when their Transform is removed or they are despawned.
+	 *
+	 * @safety The grid must outlive every world that flushes events through the registry.
+	 */
+	void observe(ComponentRegistry& registry);
+
+	/**
+	 * Moves every entity whose Transform changed since the last update into its new bucket.
+	 */
+	void update(World& world);
+
+	void remove(EntityId id);
+
+	/**
+	 * Appends every entity within radius of center to out.
+	 */
+	void query_radius(const Vector3<f32>& center, f32 radius, Vector<EntityId>& out) const;
+
+	/**
+	 * Appends every entity inside the box from min to max (inclusive) to out.
+	 */
+	void query_aabb(const Vector3<f32>& min, const Vector3<f32>& max, Vector<EntityId>& out) const;
+
+	OP_NO_DISCARD OP_ALWAYS_INLINE usize len() const { return m_len; }
+	OP_NO_DISCARD OP_ALWAYS_INLINE f32 cell_size() const { return m_cell_size; }
+
+private:
+	struct Cell {
+		i32 x, y, z;
+	};
+	OP_NO_DISCARD Cell to_cell(const Vector3<f32>& position) const;
+	OP_NO_DISCARD u32 to_bucket(const Cell& cell) const;
+
+	void insert_or_move(EntityId id, const Vector3<f32>& position);
+	void unlink(u32 bucket, u32 bucket_index);
+
+	struct Entry {
+		EntityId id;
+		Vector3<f32> position;
+		u32 bucket;
+		u32 bucket_index;
+	};
+	template <typename Test>
+	void gather(const Cell& min, const Cell& max, Test&& test, Vector<EntityId>& out) const;
+
+	// Indexed by EntityId::index() so lookups never hash.
+	Vector<Option<Entry>> m_entries;
+	// Each bucket holds the entry indices of the entities whose cell hashed to it.
+	Vector<Vector<u32>> m_buckets;
+
+	f32 m_cell_size;
+	f32 m_inv_cell_size;
+	u32 m_last_change_tick = 0;
+	usize m_len = 0;
+};
+
+OP_GAME_NAMESPACE_END
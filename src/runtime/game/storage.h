@@ -12,9 +12,28 @@ class Storage {
 public:
 	virtual bool transfer_to(Storage& other, u32 from, u32 to) = 0;
 	virtual bool discard(u32 index) = 0;
+	/**
+	 * Moves every slot of other, used or not, to the end of this storage and leaves other empty. Appended slots are
+	 * stamped with tick.
+	 *
+	 * @safety other must store the same component type and come from the same ComponentRegistry.
+	 */
+	virtual void append_from(Storage& other, u32 tick) = 0;
 	virtual ComponentType type() const = 0;
 	virtual u32 total_slots() const = 0;
 	virtual bool is_slot_used(u32 index) const = 0;
+
+	// Moves the component in a used slot to an unused one, leaving from unused.
+	virtual void move_slot(u32 from, u32 to) = 0;
+	// Drops every slot at or past len and releases the memory they used.
+	virtual void truncate(u32 len) = 0;
+	// Bytes allocated by the storage including unused capacity.
+	virtual usize allocated_bytes() const = 0;
+
+	// World change tick of the last write to the slot. See World::increment_change_tick.
+	virtual u32 changed_tick(u32 index) const = 0;
+	virtual void set_changed_tick(u32 index, u32 tick) = 0;
+
 	virtual ~Storage() = default;
 };
 
@@ -46,16 +65,29 @@ public:
 		if (component_opt.is_set()) {
 			auto component = component_opt.unwrap();
 			typed_storage.store(op::move(component), to);
+			typed_storage.set_changed_tick(to, changed_tick(from));
 			return true;
 		}
 		return false;
 	}
+	void append_from(Storage& other, u32 tick) override {
+		// Storages are created by the registry so the same component type always uses the same storage class.
+		auto& typed_storage = static_cast<VectorStorage<T>&>(other);
+		m_components.reserve(typed_storage.m_components.len());
+		m_changed_ticks.reserve(typed_storage.m_changed_ticks.len());
+		for (auto& component : typed_storage.m_components) {
+			m_components.push(op::move(component));
+			m_changed_ticks.push(tick);
+		}
+		typed_storage.m_components = {};
+		typed_storage.m_changed_ticks = {};
+	}
 	u32 total_slots() const override { return (u32)m_components.len(); }
 	bool discard(u32 index) override {
 		if (index >= m_components.len()) {
 			return false;
 		}
-		auto discarded = m_components[index].unwrap();
+		auto discarded = take(index);
 		OP_UNUSED(discarded);
 
 		return true;
@@ -66,6 +98,33 @@ public:
 		}
 		return m_components[index].is_set();
 	}
+	void move_slot(u32 from, u32 to) override {
+		OP_ASSERT(!is_slot_used(to), "Can not move a component into a used slot.");
+		m_components[to] = take(from).unwrap();
+		m_changed_ticks[to] = m_changed_ticks[from];
+	}
+	void truncate(u32 len) override {
+		if (len >= m_components.len()) {
+			return;
+		}
+
+		// Rebuild the columns rather than popping so the capacity past len is released too.
+		Column<Option<T>> components;
+		Column<u32> changed_ticks;
+		components.reserve(len);
+		changed_ticks.reserve(len);
+		for (u32 index = 0; index < len; ++index) {
+			components.push(op::move(m_components[index]));
+			changed_ticks.push(m_changed_ticks[index]);
+		}
+		m_components = op::move(components);
+		m_changed_ticks = op::move(changed_ticks);
+	}
+	usize allocated_bytes() const override {
+		return m_components.cap() * sizeof(Option<T>) + m_changed_ticks.cap() * sizeof(u32);
+	}
+	u32 changed_tick(u32 index) const override { return m_changed_ticks[index]; }
+	void set_changed_tick(u32 index, u32 tick) override { m_changed_ticks[index] = tick; }
 	// ~Storage
 
 	// TypedStorage
@@ -86,6 +145,7 @@ public:
 	void store(T&& component, u32 index) override {
 		if (index == m_components.len()) {
 			m_components.push(op::move(component));
+			m_changed_ticks.push(0);
 		} else {
 			m_components[index] = op::move(component);
 		}
@@ -94,12 +154,31 @@ public:
 		if (index >= m_components.len()) {
 			return nullopt;
 		}
-		return m_components[index].unwrap();
+		return take(index);
 	}
 	// ~TypedStorage
 
 private:
-	Vector<Option<T>> m_components;
+	// Columns of large worlds grow to several megabytes and are walked linearly by queries, so they move to huge pages.
+	template <typename Element>
+	using Column = Vector<Element, LargePageAllocator>;
+
+	// Moves the component out and marks the slot as unused. Option::unwrap leaves trivially copyable values set so
+	// those slots have to be cleared explicitly.
+	Option<T> take(u32 index) {
+		auto& slot = m_components[index];
+		if (!slot.is_set()) {
+			return nullopt;
+		}
+		T component = slot.unwrap();
+		if constexpr (std::is_trivially_copyable_v<T>) {
+			slot = nullopt;
+		}
+		return component;
+	}
+
+	Column<Option<T>> m_components;
+	Column<u32> m_changed_ticks;
 };
 
 OP_GAME_NAMESPACE_END
\ No newline at end of file
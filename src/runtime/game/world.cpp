@@ -5,10 +5,31 @@
 OP_GAME_NAMESPACE_BEGIN
 
 EntityRefMut World::spawn() {
+	MemoryScope scope(MemoryCategory::Ecs);
 	auto id = m_entities.insert(Entity{});
 	return EntityRefMut(id, *this);
 }
 
+bool World::despawn(EntityId id) {
+	auto entity_opt = m_entities.remove(id);
+	if (!entity_opt) {
+		return false;
+	}
+
+	auto entity = entity_opt.unwrap();
+	auto component_storage_opt = entity.component_storage();
+	if (component_storage_opt.is_set()) {
+		auto component_storage = component_storage_opt.unwrap();
+		m_archetypes[component_storage.archetype_index].discard(component_storage.slot_index);
+	}
+
+	for (auto type : entity.components()) {
+		record_event(type, ComponentEvent::Removed, id);
+	}
+
+	return true;
+}
+
 Option<EntityRef> World::get(EntityId id) const {
 	if (m_entities.contains(id)) {
 		return EntityRef(id, *this);
@@ -23,7 +44,187 @@ Option<EntityRefMut> World::get(EntityId id) {
 	return nullopt;
 }
 
+Option<EntityId> EntityRemap::find(EntityId old_id) const {
+	const auto index = old_id.index();
+	if (index >= m_mappings.len()) {
+		return nullopt;
+	}
+
+	auto mapping_opt = m_mappings[index].as_ref();
+	if (!mapping_opt || mapping_opt.unwrap().from != old_id) {
+		return nullopt;
+	}
+	return mapping_opt.unwrap().to;
+}
+
+void EntityRemap::insert(EntityId old_id, EntityId new_id) {
+	const auto index = old_id.index();
+	while (m_mappings.len() <= index) {
+		m_mappings.push(nullopt);
+	}
+	m_mappings[index] = Mapping{ old_id, new_id };
+	m_len += 1;
+}
+
+EntityRemap World::merge(World&& other) {
+	MemoryScope scope(MemoryCategory::Ecs);
+
+	OP_ASSERT(
+		&*m_component_registry == &*other.m_component_registry,
+		"Worlds can only be merged when they share a component registry."
+	);
+
+	// Append every archetype's columns in one go and remember where its slots landed.
+	struct Placement {
+		u32 archetype_index;
+		u32 base;
+	};
+	Vector<Placement> placements;
+	placements.reserve(other.m_archetypes.len());
+	for (auto& archetype : other.m_archetypes) {
+		const auto types = archetype.component_types();
+		const auto archetype_index = find_or_create_archetype(types);
+		const auto base = m_archetypes[archetype_index].append(archetype, m_change_tick);
+		placements.push(Placement{ archetype_index, base });
+	}
+
+	// Move the entities over, pointing them and their slots at each other.
+	EntityRemap remap;
+	other.m_entities.for_each([&](EntityId old_id, Entity& entity) {
+		auto component_storage_opt = entity.component_storage();
+		if (component_storage_opt.is_set()) {
+			auto component_storage = component_storage_opt.unwrap();
+			auto& placement = placements[component_storage.archetype_index];
+			component_storage = { placement.archetype_index, placement.base + component_storage.slot_index };
+			entity.set_component_storage(component_storage.archetype_index, component_storage.slot_index);
+			component_storage_opt = component_storage;
+		}
+
+		const auto new_id = m_entities.insert(op::move(entity));
+		if (component_storage_opt.is_set()) {
+			auto component_storage = component_storage_opt.unwrap();
+			m_archetypes[component_storage.archetype_index].set_entity(component_storage.slot_index, new_id);
+		}
+
+		for (auto type : m_entities.get(new_id).unwrap().components()) {
+			record_event(type, ComponentEvent::Added, new_id);
+		}
+
+		remap.insert(old_id, new_id);
+	});
+
+	other.m_entities = EntityMap();
+	other.m_archetypes = {};
+	other.m_pending_events = {};
+
+	return remap;
+}
+
+Option<EntityId> World::transfer(EntityId id, World& target) {
+	MemoryScope scope(MemoryCategory::Ecs);
+
+	OP_ASSERT(
+		&*m_component_registry == &*target.m_component_registry,
+		"Entities can only be transferred between worlds that share a component registry."
+	);
+
+	auto entity_opt = m_entities.remove(id);
+	if (!entity_opt) {
+		return nullopt;
+	}
+
+	auto entity = entity_opt.unwrap();
+	auto old_component_storage_opt = entity.component_storage();
+	const auto new_id = target.m_entities.insert(op::move(entity));
+	auto& moved = target.m_entities.get(new_id).unwrap();
+
+	if (old_component_storage_opt.is_set()) {
+		auto old_component_storage = old_component_storage_opt.unwrap();
+		auto new_archetype_index = target.find_or_create_archetype(moved.components());
+		auto& new_archetype = target.m_archetypes[new_archetype_index];
+		auto new_slot_index = new_archetype.next_slot_index(new_id);
+
+		auto& old_archetype = m_archetypes[old_component_storage.archetype_index];
+		old_archetype.transfer_to(new_archetype, old_component_storage.slot_index, new_slot_index);
+		moved.set_component_storage(new_archetype_index, new_slot_index);
+
+		// Change ticks are per world so the moved components count as changed in target.
+		for (auto type : moved.components()) {
+			new_archetype.mark_changed(type, new_slot_index, target.m_change_tick);
+		}
+	}
+
+	for (auto type : moved.components()) {
+		record_event(type, ComponentEvent::Removed, id);
+		target.record_event(type, ComponentEvent::Added, new_id);
+	}
+
+	return new_id;
+}
+
+WorldMemoryReport World::memory_report() const {
+	WorldMemoryReport result;
+
+	result.entity_bytes = m_entities.allocated_bytes();
+	m_entities.for_each([&](EntityId, const Entity& entity) { result.entity_bytes += entity.allocated_bytes(); });
+
+	result.archetypes.reserve(m_archetypes.len());
+	for (u32 archetype_index = 0; archetype_index < m_archetypes.len(); ++archetype_index) {
+		auto& archetype = m_archetypes[archetype_index];
+		const auto bytes = archetype.allocated_bytes();
+		result.archetypes.push(
+			WorldMemoryReport::ArchetypeUsage{ archetype_index, bytes, archetype.count(), archetype.available_slots() }
+		);
+		result.archetype_bytes += bytes;
+
+		for (auto type : archetype.component_types()) {
+			Option<WorldMemoryReport::ComponentUsage&> usage = nullopt;
+			for (auto& it : result.components) {
+				if (it.type == type) {
+					usage = it;
+					break;
+				}
+			}
+			if (!usage.is_set()) {
+				auto& type_info = m_component_registry->find(type);
+				const auto index = result.components.push(
+					WorldMemoryReport::ComponentUsage{ type, type_info.name(), 0, 0, 0 }
+				);
+				usage = result.components[index];
+			}
+
+			auto& component = usage.unwrap();
+			component.bytes += archetype.find_storage(type).allocated_bytes();
+			component.used_slots += archetype.count();
+			component.total_slots += archetype.total_slots();
+		}
+	}
+
+	return result;
+}
+
+u32 World::compact(f32 max_fragmentation) {
+	MemoryScope scope(MemoryCategory::Ecs);
+
+	u32 result = 0;
+	for (u32 archetype_index = 0; archetype_index < m_archetypes.len(); ++archetype_index) {
+		auto& archetype = m_archetypes[archetype_index];
+		const auto total = archetype.total_slots();
+		if (total == 0) continue;
+
+		const auto fragmentation = static_cast<f32>(archetype.available_slots()) / static_cast<f32>(total);
+		if (fragmentation <= max_fragmentation) continue;
+
+		result += archetype.compact([&](EntityId id, u32 slot_index) {
+			m_entities.get(id).unwrap().set_component_storage(archetype_index, slot_index);
+		});
+	}
+	return result;
+}
+
 bool World::remove_component(EntityId id, ComponentType component) {
+	MemoryScope scope(MemoryCategory::Ecs);
+
 	// Check if the entity exists.
 	auto entity_opt = m_entities.get(id);
 	if (!entity_opt) {
@@ -42,7 +243,7 @@ bool World::remove_component(EntityId id, ComponentType component) {
 	// Find the archetype that supports the remaining components.
 	auto new_archetype_index = find_or_create_archetype(entity.components());
 	auto& new_archetype = m_archetypes[new_archetype_index];
-	auto new_slot_index = new_archetype.next_slot_index();
+	auto new_slot_index = new_archetype.next_slot_index(id);
 
 	// Transfer all the components to the new archetype. The component we're trying to remove will be discarded in the
 	// process.
@@ -55,21 +256,70 @@ bool World::remove_component(EntityId id, ComponentType component) {
 	// Update the entity's component storage.
 	entity.set_component_storage(new_archetype_index, new_slot_index);
 
+	record_event(component, ComponentEvent::Removed, id);
+
 	return true;
 }
 
+void World::record_event(ComponentType type, ComponentEvent event, EntityId id) {
+	MemoryScope scope(MemoryCategory::Ecs);
+
+	// Most component types are never observed so avoid buffering anything for them.
+	if (!m_component_registry->is_observed(type, event)) {
+		return;
+	}
+
+	Option<PendingEvents&> pending = nullopt;
+	for (auto& it : m_pending_events) {
+		if (it.type == type) {
+			pending = it;
+			break;
+		}
+	}
+	if (!pending.is_set()) {
+		const auto index = m_pending_events.push(PendingEvents{ type, {}, {} });
+		pending = m_pending_events[index];
+	}
+
+	auto& events = pending.unwrap();
+	if (event == ComponentEvent::Added) {
+		events.added.push(id);
+	} else {
+		events.removed.push(id);
+	}
+}
+
+void World::flush_events() {
+	// Observers are free to change the world so take the pending events first. Anything they record is dispatched on
+	// the next flush.
+	auto pending_events = op::move(m_pending_events);
+
+	for (auto& events : pending_events) {
+		m_component_registry->notify(*this, events.type, ComponentEvent::Removed, events.removed);
+	}
+
+	for (auto& events : pending_events) {
+		// Keep only the entities that still have the component. The buffer is filtered in place.
+		usize len = 0;
+		for (usize index = 0; index < events.added.len(); ++index) {
+			const auto id = events.added[index];
+			auto entity_opt = m_entities.get(id);
+			if (entity_opt && entity_opt.unwrap().contains(events.type)) {
+				events.added[len] = id;
+				len += 1;
+			}
+		}
+		auto added = Slice<EntityId const>(events.added.begin(), len);
+		m_component_registry->notify(*this, events.type, ComponentEvent::Added, added);
+	}
+}
+
 u32 World::find_or_create_archetype(Slice<ComponentType const> supported_types) {
-	// Find an archetype that supports all the components.
+	// Find the archetype that stores exactly these components.
+	auto signature = m_component_registry->signature(supported_types);
 	Option<u32> result = nullopt;
 	for (u32 index = 0; index < m_archetypes.len(); ++index) {
-		bool supports_all = true;
-		for (auto type : supported_types) {
-			if (!m_archetypes[index].supports(type)) {
-				supports_all = false;
-				break;
-			}
-		}
-		if (supports_all) {
+		if (m_archetypes[index].signature() == signature) {
 			result = index;
 			break;
 		}
@@ -77,7 +327,7 @@ u32 World::find_or_create_archetype(Slice<ComponentType const> supported_types)
 
 	// If no archetype was found, create a new one.
 	if (!result.is_set()) {
-		auto archetype = Archetype();
+		auto archetype = Archetype(op::move(signature));
 
 		// Add all the component storages required by the caller.
 		for (auto type : supported_types) {
@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include "core/containers/paged_vector.h"
+#include "core/os/memory_tracking.h"
 #include "game/archetype.h"
 #include "game/component.h"
 #include "game/entity.h"
@@ -38,15 +40,123 @@ private:
 	World const& m_world;
 };
 
+/**
+ * Maps the ids entities had in a merged world to their ids in the world they were merged into.
+ */
+class EntityRemap {
+public:
+	OP_NO_DISCARD Option<EntityId> find(EntityId old_id) const;
+	OP_NO_DISCARD OP_ALWAYS_INLINE usize len() const { return m_len; }
+
+private:
+	friend class World;
+
+	void insert(EntityId old_id, EntityId new_id);
+
+	struct Mapping {
+		EntityId from;
+		EntityId to;
+	};
+	// Indexed by the old EntityId::index().
+	Vector<Option<Mapping>> m_mappings;
+	usize m_len = 0;
+};
+
+/**
+ * Snapshot of the memory used by a world. All byte counts include unused capacity.
+ */
+struct WorldMemoryReport {
+	struct ComponentUsage {
+		ComponentType type;
+		StringView name;
+		usize bytes;
+		// Summed over every archetype storing the component.
+		u32 used_slots;
+		u32 total_slots;
+	};
+	Vector<ComponentUsage> components;
+
+	struct ArchetypeUsage {
+		u32 index;
+		usize bytes;
+		u32 used_rows;
+		u32 free_rows;
+
+		// Share of rows that are allocated but unused.
+		OP_NO_DISCARD OP_ALWAYS_INLINE f32 fragmentation() const {
+			const auto total = used_rows + free_rows;
+			return total > 0 ? static_cast<f32>(free_rows) / static_cast<f32>(total) : 0.f;
+		}
+	};
+	Vector<ArchetypeUsage> archetypes;
+
+	// Slot map plus each entity's component list.
+	usize entity_bytes = 0;
+	// Sum of every archetype's bytes, component columns included.
+	usize archetype_bytes = 0;
+
+	OP_NO_DISCARD OP_ALWAYS_INLINE usize total_bytes() const { return entity_bytes + archetype_bytes; }
+};
+
 class World {
 public:
 	explicit World(const ComponentRegistry& component_registry)
 		: m_component_registry(component_registry.to_shared()) {}
 
 	OP_NO_DISCARD EntityRefMut spawn();
+	bool despawn(EntityId id);
 	OP_NO_DISCARD Option<EntityRef> get(EntityId id) const;
 	OP_NO_DISCARD Option<EntityRefMut> get(EntityId id);
 
+	/**
+	 * Moves every entity of other into this world and leaves other empty.
+	 *
+	 * Archetype columns are appended whole and entity ids are remapped in one pass, so the cost is a move per component
+	 * rather than a spawn and archetype migration per entity. This is intended for worlds built off the main thread,
+	 * e.g. a streamed level chunk, that are merged once ready.
+	 *
+	 * Merged components are reported as added and count as changed at the current tick. Events still pending in other
+	 * are dropped. Components that store EntityIds must be patched by the caller using the returned remap.
+	 *
+	 * @safety Both worlds must use the same ComponentRegistry.
+	 */
+	EntityRemap merge(World&& other);
+
+	/**
+	 * Moves a single entity and its components into target. Returns the entity's id in target.
+	 *
+	 * @safety Both worlds must use the same ComponentRegistry.
+	 */
+	Option<EntityId> transfer(EntityId id, World& target);
+
+	OP_NO_DISCARD WorldMemoryReport memory_report() const;
+
+	/**
+	 * Defragments every archetype whose share of unused rows is above max_fragmentation by moving entities into the
+	 * holes and releasing the freed rows. Entity ids are unaffected. Returns the number of entities moved.
+	 *
+	 * Must not be called while a query is executing.
+	 */
+	u32 compact(f32 max_fragmentation = 0.f);
+
+	/**
+	 * Dispatches the component events recorded since the last flush to the registry's observers.
+	 *
+	 * Removals are dispatched before additions. Additions are filtered to entities that still have the component so an
+	 * entity that gained and lost a component between flushes is only reported as removed.
+	 */
+	void flush_events();
+
+	/**
+	 * Component writes are stamped with the current change tick. Returns the current tick and advances it so anything
+	 * written afterwards compares greater than the returned value.
+	 *
+	 * Systems that want to process only changed components keep the tick returned by their last run and pass it to
+	 * Query::changed_since.
+	 */
+	OP_ALWAYS_INLINE u32 increment_change_tick() { return m_change_tick++; }
+	OP_NO_DISCARD OP_ALWAYS_INLINE u32 change_tick() const { return m_change_tick; }
+
 private:
 	friend class EntityRefMut;
 	friend class EntityRef;
@@ -58,13 +168,26 @@ private:
 
 	u32 find_or_create_archetype(Slice<ComponentType const> supported_types);
 
-	SlotMap<Entity> m_entities;
-	Vector<Archetype> m_archetypes;
-	Shared<ComponentRegistry const> m_component_registry;
+	void record_event(ComponentType type, ComponentEvent event, EntityId id);
+
+	EntityMap m_entities;
+	// Paged so references to archetypes stay valid while new archetypes are created.
+	PagedVector<Archetype> m_archetypes;
+	AtomicShared<ComponentRegistry const> m_component_registry;
+	u32 m_change_tick = 1;
+
+	struct PendingEvents {
+		ComponentType type;
+		Vector<EntityId> added;
+		Vector<EntityId> removed;
+	};
+	Vector<PendingEvents> m_pending_events;
 };
 
 template <typename T>
 bool World::add_component(EntityId id, T&& component) {
+	MemoryScope scope(MemoryCategory::Ecs);
+
 	// Find the entity data.
 	auto entity_opt = m_entities.get(id);
 	if (!entity_opt) {
@@ -81,7 +204,7 @@ bool World::add_component(EntityId id, T&& component) {
 	entity.add_component(T::type());
 	auto new_archetype_index = find_or_create_archetype(entity.components());
 	auto& new_archetype = m_archetypes[new_archetype_index];
-	auto new_slot_index = new_archetype.next_slot_index();
+	auto new_slot_index = new_archetype.next_slot_index(id);
 
 	// Store the old storage state before we change it as we need it for the transfer.
 	auto old_component_storage_opt = entity.component_storage();
@@ -89,6 +212,7 @@ bool World::add_component(EntityId id, T&& component) {
 	// Update the entity state to reflect the new component storage and then store the component.
 	entity.set_component_storage(new_archetype_index, new_slot_index);
 	new_archetype.store(op::forward<T>(component), new_slot_index);
+	new_archetype.mark_changed(T::type(), new_slot_index, m_change_tick);
 
 	// Transfer the old component storage to the new archetype.
 	if (old_component_storage_opt.is_set()) {
@@ -97,6 +221,8 @@ bool World::add_component(EntityId id, T&& component) {
 		old_archetype.transfer_to(new_archetype, old_component_storage.slot_index, new_slot_index);
 	}
 
+	record_event(T::type(), ComponentEvent::Added, id);
+
 	return true;
 }
 
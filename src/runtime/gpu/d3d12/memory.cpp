@@ -25,35 +25,29 @@ void D3D12DescriptorHeap::init(
 	throw_if_failed(device->CreateDescriptorHeap(&desc, IID_PPV_ARGS(&m_heap)));
 
 	m_size = device->GetDescriptorHandleIncrementSize(type);
-	m_free_slots.reserve(cap);
-	// TODO: memcpy this
-	for (usize i = 0; i < cap; ++i) {
-		m_free_slots.push(false);
-	}
+	m_used_slots = AtomicBitVector(cap);
 }
 
 D3D12DescriptorHandle D3D12DescriptorHeap::alloc() const {
 	OP_ASSERT(m_cap > 0, "Heap needs to be initialized with D3D12DescriptorHeap::init");
 
 	while (true) {
-		for (usize i = 0; i < m_cap; ++i) {
-			const auto slot = m_free_slots[i].load();
-			if (!slot) {
-				if (m_free_slots[i].compare_exchange_weak(false, true)) {
-					D3D12_CPU_DESCRIPTOR_HANDLE handle = m_heap->GetCPUDescriptorHandleForHeapStart();
-					handle.ptr += static_cast<SIZE_T>(i * m_size);
-					return { handle, static_cast<u32>(i) };
-				}
-			}
+		const auto slot = m_used_slots.claim_first_unset();
+		if (slot.is_set()) {
+			const auto index = slot.unwrap();
+			D3D12_CPU_DESCRIPTOR_HANDLE handle = m_heap->GetCPUDescriptorHandleForHeapStart();
+			handle.ptr += static_cast<SIZE_T>(index * m_size);
+			return { handle, static_cast<u32>(index) };
 		}
 	}
 }
 
 void D3D12DescriptorHeap::free(const D3D12DescriptorHandle& handle) const {
 	OP_ASSERT(m_cap > 0, "Heap needs to be initialized with D3D12DescriptorHeap::init");
-	OP_ASSERT(m_free_slots[handle.index].load(), "Attempting to free a freed slot");
 
-	m_free_slots[handle.index].store(false);
+	const auto was_used = m_used_slots.unset(handle.index);
+	OP_ASSERT(was_used, "Attempting to free a freed slot");
+	OP_UNUSED(was_used);
 }
 
 void D3D12RootSignature::init(const D3D12Device& context) {
@@ -4,8 +4,7 @@
 
 #include "gpu/d3d12/d3d12.h"
 
-#include "core/atomic.h"
-#include "core/containers/vector.h"
+#include "core/containers/bit_vector.h"
 
 OP_GPU_NAMESPACE_BEGIN
 
@@ -26,7 +25,8 @@ public:
 
 private:
 	ComPtr<ID3D12DescriptorHeap> m_heap;
-	Vector<Atomic<bool>> m_free_slots;
+	// Set bits are descriptors in use.
+	AtomicBitVector m_used_slots;
 	usize m_size = 0;
 	usize m_cap = 0;
 };
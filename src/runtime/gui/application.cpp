@@ -9,6 +9,7 @@
 #include "core/containers/wstring.h"
 #include "core/math/matrix4.h"
 #include "core/os/file_system.h"
+#include "core/task.h"
 
 #include "dxc/dxc.h"
 #include "gpu/buffer.h"
@@ -287,6 +288,9 @@ void Application::run(FunctionRef<void(Builder&)> callable) {
 	window->set_min_size(m_min_size);
 	window->set_max_size(m_max_size);
 
+	// Start reading the font so it loads while the shaders compile
+	auto consola_ttf = core::spawn(m_jobs, core::read_to_bytes_async(m_jobs, String::from("../res/consola.ttf")));
+
 	// Compile the vertex shader using source
 	dxc::Input vertex_input = { source, "vs_main", dxc::ShaderType::Vertex };
 	auto vertex_output = dxc::compile(vertex_input).unwrap();
@@ -309,8 +313,8 @@ void Application::run(FunctionRef<void(Builder&)> callable) {
 	definition.color_attachments.push(gpu::Format::RGBA_U8);
 	auto pipeline = m_device->create_graphics_pipeline(op::move(definition));
 
-	auto consola_ttf = core::read_to_bytes("../res/consola.ttf").unwrap();
-	auto consola = Font::from_bytes(device, op::move(consola_ttf)).unwrap();
+	auto consola_bytes = core::block_on(m_jobs, op::move(consola_ttf)).unwrap();
+	auto consola = Font::from_bytes(device, op::move(consola_bytes)).unwrap();
 
 	window->set_visible(true);
 	while (true) {
@@ -1,5 +1,6 @@
 // Copyright Colby Hall. All Rights Reserved.
 
+#include "core/job_system.h"
 #include "core/math/vector2.h"
 #include "gpu/device.h"
 #include "gui/gui.h"
@@ -67,8 +68,17 @@ public:
 	 */
 	void run(FunctionRef<void(Builder&)> callable);
 
+	/**
+	 * The job system the application loads its assets on. It lives as long as the application so callers can schedule
+	 * their own work on it instead of starting another pool of threads.
+	 *
+	 * @return The application's job system.
+	 */
+	OP_ALWAYS_INLINE JobSystem& jobs() { return m_jobs; }
+
 private:
 	gpu::Shared<gpu::Device> m_device;
+	JobSystem m_jobs;
 
 	Vector2<u32> m_min_size;
 	Vector2<u32> m_max_size;
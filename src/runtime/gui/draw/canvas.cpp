@@ -2,16 +2,19 @@
 
 #include "gui/draw/canvas.h"
 #include "gui/draw/font.h"
+#include "core/os/memory_tracking.h"
 
 OP_GUI_NAMESPACE_BEGIN
 
 Canvas& Canvas::push(Rectangle&& rectangle) {
+	MemoryScope scope(MemoryCategory::Canvas);
 	const auto index = static_cast<u32>(m_rectangles.len());
 	m_rectangles.push(op::move(rectangle));
 	m_indices.push({ index, Shape::Rectangle });
 	return *this;
 }
 Canvas& Canvas::push(Text&& text) {
+	MemoryScope scope(MemoryCategory::Canvas);
 	const auto index = static_cast<u32>(m_texts.len());
 	m_texts.push(op::move(text));
 	m_indices.push({ index, Shape::Text });
@@ -19,12 +22,14 @@ Canvas& Canvas::push(Text&& text) {
 }
 
 Canvas& Canvas::insert(u32 index, Rectangle&& rectangle) {
+	MemoryScope scope(MemoryCategory::Canvas);
 	const auto rectangle_index = static_cast<u32>(m_rectangles.len());
 	m_rectangles.push(op::move(rectangle));
 	m_indices.insert(index, { rectangle_index, Shape::Rectangle });
 	return *this;
 }
 Canvas& Canvas::insert(u32 index, Text&& text) {
+	MemoryScope scope(MemoryCategory::Canvas);
 	const auto text_index = static_cast<u32>(m_texts.len());
 	m_texts.push(op::move(text));
 	m_indices.insert(index, { text_index, Shape::Text });
@@ -32,6 +37,7 @@ Canvas& Canvas::insert(u32 index, Text&& text) {
 }
 
 TessellatedCanvas Canvas::tessellate() const {
+	MemoryScope scope(MemoryCategory::Canvas);
 	TessellatedCanvas result;
 	result.vertices.reserve(m_indices.len() * 4);
 	result.indices.reserve(m_indices.len() * 6);
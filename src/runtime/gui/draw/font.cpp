@@ -4,6 +4,7 @@
 #include "gpu/buffer.h"
 #include "gpu/device.h"
 #include "gpu/graphics_command_list.h"
+#include "core/os/memory_tracking.h"
 
 // Include stb headers
 #include "stb/stb.h"
@@ -18,6 +19,8 @@ OP_SUPPRESS_WARNING_POP
 OP_GUI_NAMESPACE_BEGIN
 
 Option<Font> Font::from_bytes(const gpu::Device& device, Vector<u8>&& bytes) {
+	MemoryScope scope(MemoryCategory::Font);
+
 	stbtt_fontinfo* font_info = new stbtt_fontinfo{};
 	stbtt_InitFont(font_info, bytes.begin(), stbtt_GetFontOffsetForIndex(bytes.begin(), 0));
 
@@ -40,17 +43,15 @@ Option<Font> Font::from_bytes(const gpu::Device& device, Vector<u8>&& bytes) {
 	// seems to work well enough
 	const Vector2<u32> atlas_size = { 4096 };
 
-	Vector<stbrp_node> rect_nodes;
+	// The packer nodes and the bitmap are tens of megabytes so they are backed by huge pages.
+	Vector<stbrp_node, LargePageAllocator> rect_nodes;
 	rect_nodes.reserve(atlas_size.width * atlas_size.height);
 
 	stbrp_context packer = {};
 	stbrp_init_target(&packer, atlas_size.width, atlas_size.height, rect_nodes.begin(), (int)rect_nodes.cap());
 
-	Vector<u8> bitmap;
-	bitmap.reserve(atlas_size.width * atlas_size.height);
-	for (usize index = 0; index < bitmap.cap(); index += 1) {
-		bitmap.push(0);
-	}
+	Vector<u8, LargePageAllocator> bitmap;
+	bitmap.resize(atlas_size.width * atlas_size.height, 0);
 
 	for (auto glyph = 0; glyph < NUM_GLYPHS; ++glyph) {
 		int width, height, xoff, yoff;
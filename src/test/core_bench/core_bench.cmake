@@ -0,0 +1,27 @@
+# Set the root
+set(CORE_BENCH_ROOT ${TEST_ROOT}/core_bench)
+
+# Source files
+set(CORE_BENCH_SRC_FILES
+        ${CORE_BENCH_ROOT}/core_bench.cmake
+        ${CORE_BENCH_ROOT}/core_bench.h
+        ${CORE_BENCH_ROOT}/core_bench.cpp
+
+        ${CORE_BENCH_ROOT}/hash_bench.cpp
+        ${CORE_BENCH_ROOT}/slab_bench.cpp
+        ${CORE_BENCH_ROOT}/small_vector_bench.cpp
+        ${CORE_BENCH_ROOT}/vector_bench.cpp
+        )
+
+# Group source files
+source_group(TREE ${CORE_BENCH_ROOT} FILES ${CORE_BENCH_SRC_FILES})
+
+# Benchmarks are run by hand so they are not registered with ctest
+add_executable(core_bench ${CORE_BENCH_SRC_FILES})
+target_include_directories(core_bench PUBLIC ${RUNTIME_ROOT} ${CORE_BENCH_ROOT})
+target_link_libraries(core_bench LINK_PUBLIC core)
+set_target_properties(core_bench PROPERTIES FOLDER "test")
+
+if ("${CMAKE_SYSTEM_NAME}" STREQUAL "Windows" AND NOT MINGW)
+    target_link_options(core_bench PUBLIC "/SUBSYSTEM:CONSOLE")
+endif ()
@@ -0,0 +1,11 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#include "core_bench.h"
+
+int main() {
+	op::hash_bench();
+	op::slab_bench();
+	op::small_vector_bench();
+	op::vector_bench();
+	return 0;
+}
@@ -0,0 +1,45 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#pragma once
+
+#include "core/os/time.h"
+
+#include <cstdio>
+
+OP_NAMESPACE_BEGIN
+
+/**
+ * Runs callable iterations times and prints the average time per iteration.
+ *
+ * callable returns a u64 derived from its work. The results are folded into a volatile sink so the optimizer can not
+ * drop the work being measured. Returns the average nanoseconds per iteration.
+ */
+template <typename Callable>
+f64 bench(const char* name, usize iterations, Callable&& callable) {
+	static volatile u64 sink = 0;
+
+	// Warm up caches and branch predictors before measuring.
+	u64 result = 0;
+	for (usize index = 0; index < iterations / 10 + 1; ++index) {
+		result += callable();
+	}
+
+	const auto start = Instant::now();
+	for (usize index = 0; index < iterations; ++index) {
+		result += callable();
+	}
+	const auto elapsed = Instant::now().duration_since(start);
+	sink = sink + result;
+
+	const auto nanos = elapsed.as_secs_f64() * static_cast<f64>(core::nanos_per_sec) / static_cast<f64>(iterations);
+	std::printf("%-48s %12.2f ns/iter\n", name, nanos);
+	return nanos;
+}
+
+// Benchmark groups, each in its own translation unit.
+void hash_bench();
+void slab_bench();
+void small_vector_bench();
+void vector_bench();
+
+OP_NAMESPACE_END
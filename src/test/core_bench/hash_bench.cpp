@@ -0,0 +1,71 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#include "core/containers/map.h"
+#include "core/hash.h"
+#include "core_bench.h"
+
+OP_NAMESPACE_BEGIN
+
+template <typename H>
+static u64 hash_once(u8 const* data, usize len) {
+	H hasher;
+	hasher.write(Slice<u8 const>(data, len));
+	return hasher.finish();
+}
+
+template <typename H>
+static void map_lookups(const char* name) {
+	constexpr u64 count = 100000;
+
+	Map<u64, u64, H> map;
+	map.reserve(count);
+	for (u64 key = 0; key < count; ++key) {
+		map.insert(key * 7919, key);
+	}
+
+	u64 key = 0;
+	bench(name, 1000000, [&]() {
+		key = (key + 1) % count;
+		return map.find(key * 7919).unwrap();
+	});
+
+	// Same lookups with the hashes computed up front, as done for hot keys.
+	constexpr u64 hot_count = 1024;
+	static u64 hashes[hot_count];
+	for (u64 index = 0; index < hot_count; ++index) {
+		hashes[index] = Map<u64, u64, H>::hash_key(index * 7919);
+	}
+
+	char hashed_name[64];
+	std::snprintf(hashed_name, sizeof(hashed_name), "%s_hashed", name);
+	bench(hashed_name, 1000000, [&]() {
+		key = (key + 1) % hot_count;
+		return map.find_hashed(key * 7919, hashes[key]).unwrap();
+	});
+}
+
+void hash_bench() {
+	static u8 data[4096];
+	for (usize index = 0; index < sizeof(data); ++index) {
+		data[index] = static_cast<u8>(index * 131 + 17);
+	}
+
+	constexpr usize sizes[] = { 4, 8, 16, 32, 64, 256, 4096 };
+	for (auto size : sizes) {
+		char name[64];
+
+		const auto iterations = size > 256 ? 100000 : 2000000;
+		std::snprintf(name, sizeof(name), "FNV1Hasher %llu bytes", static_cast<unsigned long long>(size));
+		const auto fnv1 = bench(name, iterations, [&]() { return hash_once<FNV1Hasher>(data, size); });
+
+		std::snprintf(name, sizeof(name), "WyHasher %llu bytes", static_cast<unsigned long long>(size));
+		const auto wy = bench(name, iterations, [&]() { return hash_once<WyHasher>(data, size); });
+
+		std::printf("%-48s %12.2fx\n", "  speedup", fnv1 / wy);
+	}
+
+	map_lookups<FNV1Hasher>("Map<u64, u64, FNV1Hasher>::find");
+	map_lookups<WyHasher>("Map<u64, u64, WyHasher>::find");
+}
+
+OP_NAMESPACE_END
@@ -0,0 +1,72 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#include "core/containers/shared.h"
+#include "core/containers/vector.h"
+#include "core/slab.h"
+#include "core_bench.h"
+
+OP_SUPPRESS_WARNINGS_STD_BEGIN
+#include <thread>
+OP_SUPPRESS_WARNINGS_STD_END
+
+OP_NAMESPACE_BEGIN
+
+// Stand in for a GPU resource wrapper created and destroyed every frame.
+struct BenchResource {
+	u64 handle;
+	u64 size;
+	u32 flags;
+};
+
+// Creates a frame worth of resources then releases them in creation order.
+template <Allocator A>
+static u64 churn_resources(usize count) {
+	Vector<AtomicShared<BenchResource>> resources;
+	resources.reserve(count);
+	for (u64 index = 0; index < count; ++index) {
+		resources.push(AtomicShared<BenchResource>::make_in(A(), BenchResource{ index, index * 2, 1 }));
+	}
+
+	u64 result = 0;
+	for (auto& resource : resources) {
+		result += resource->handle;
+	}
+	return result;
+}
+
+// Runs the same churn on several threads at once to expose contention in the underlying allocator.
+template <Allocator A>
+static u64 churn_resources_threaded(usize thread_count, usize count) {
+	Vector<std::thread> threads;
+	u64 results[16] = {};
+	for (usize index = 0; index < thread_count; ++index) {
+		threads.push(std::thread([&results, index, count]() {
+			for (int round = 0; round < 20; ++round) {
+				results[index] += churn_resources<A>(count);
+			}
+		}));
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+
+	u64 result = 0;
+	for (usize index = 0; index < thread_count; ++index) {
+		result += results[index];
+	}
+	return result;
+}
+
+void slab_bench() {
+	bench("GlobalAllocator Shared churn 1000", 2000, []() { return churn_resources<GlobalAllocator>(1000); });
+	bench("SlabAllocator Shared churn 1000", 2000, []() { return churn_resources<SlabAllocator>(1000); });
+
+	bench("GlobalAllocator Shared churn 4 threads", 50, []() {
+		return churn_resources_threaded<GlobalAllocator>(4, 1000);
+	});
+	bench("SlabAllocator Shared churn 4 threads", 50, []() {
+		return churn_resources_threaded<SlabAllocator>(4, 1000);
+	});
+}
+
+OP_NAMESPACE_END
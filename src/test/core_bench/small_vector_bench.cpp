@@ -0,0 +1,110 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#include "core/containers/small_vector.h"
+#include "core/containers/unique.h"
+#include "core/containers/vector.h"
+#include "core_bench.h"
+
+OP_NAMESPACE_BEGIN
+
+// Stand in for a type erased component storage owned by an archetype.
+struct BenchStorage {
+	u64 type;
+};
+
+// Entities are built one component at a time and usually end up with a handful of components.
+template <typename Components>
+static u64 build_entities(usize entity_count, usize component_count) {
+	Vector<Components> entities;
+	entities.reserve(entity_count);
+
+	u64 result = 0;
+	for (usize entity = 0; entity < entity_count; ++entity) {
+		Components components;
+		for (u64 component = 0; component < component_count; ++component) {
+			components.push(component * 31 + entity);
+		}
+		result += components[components.len() - 1];
+		entities.push(op::move(components));
+	}
+	return result;
+}
+
+// Queries are rebuilt every time a system runs and name a few components to read and write.
+template <typename Components>
+static u64 build_query() {
+	Components reads;
+	Components writes;
+	reads.push(1);
+	reads.push(2);
+	writes.push(3);
+
+	u64 result = 0;
+	for (auto component : reads) {
+		result += component;
+	}
+	for (auto component : writes) {
+		result += component;
+	}
+	return result;
+}
+
+// Archetypes own one storage per component in their signature.
+template <typename Storages>
+static u64 build_archetype(usize storage_count) {
+	Storages storages;
+	for (u64 index = 0; index < storage_count; ++index) {
+		storages.push(Unique<BenchStorage>::make(BenchStorage{ index }));
+	}
+	return storages[storage_count - 1]->type;
+}
+
+// Runs the benchmark and prints the average number of allocations made per iteration below it.
+template <typename Callable>
+static void compare(const char* name, usize iterations, Callable&& callable) {
+	const auto before = core::allocation_count();
+	bench(name, iterations, callable);
+	const auto allocations = core::allocation_count() - before;
+
+	// bench also runs a tenth of the iterations as warm up.
+	const auto runs = iterations + iterations / 10 + 1;
+	std::printf("%-48s %12.2f allocs/iter\n", "", static_cast<f64>(allocations) / static_cast<f64>(runs));
+}
+
+void small_vector_bench() {
+	constexpr usize entity_count = 1000;
+	constexpr usize component_counts[] = { 2, 4, 8 };
+	for (auto component_count : component_counts) {
+		char name[64];
+
+		std::snprintf(
+			name,
+			sizeof(name),
+			"Vector entities %llu components",
+			static_cast<unsigned long long>(component_count)
+		);
+		compare(name, 200, [&]() { return build_entities<Vector<u64>>(entity_count, component_count); });
+
+		std::snprintf(
+			name,
+			sizeof(name),
+			"SmallVector<4> entities %llu components",
+			static_cast<unsigned long long>(component_count)
+		);
+		compare(name, 200, [&]() {
+			return build_entities<SmallVector<u64, 4>>(entity_count, component_count);
+		});
+	}
+
+	compare("Vector query", 1000000, []() { return build_query<Vector<u64>>(); });
+	compare("SmallVector<4> query", 1000000, []() { return build_query<SmallVector<u64, 4>>(); });
+
+	compare("Vector archetype 3 storages", 1000000, []() {
+		return build_archetype<Vector<Unique<BenchStorage>>>(3);
+	});
+	compare("SmallVector<4> archetype 3 storages", 1000000, []() {
+		return build_archetype<SmallVector<Unique<BenchStorage>, 4>>(3);
+	});
+}
+
+OP_NAMESPACE_END
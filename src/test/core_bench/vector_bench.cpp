@@ -0,0 +1,84 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#include "core/containers/vector.h"
+#include "core_bench.h"
+
+OP_SUPPRESS_WARNINGS_STD_BEGIN
+#include <vector>
+OP_SUPPRESS_WARNINGS_STD_END
+
+OP_NAMESPACE_BEGIN
+
+// Large enough that copying it is not free but still trivially copyable, like most components.
+struct BenchTransform {
+	f32 values[16];
+};
+
+static constexpr usize push_count = 10000;
+
+void vector_bench() {
+	bench("Vector push u32", 2000, []() {
+		Vector<u32> vec;
+		for (u32 index = 0; index < push_count; ++index) {
+			vec.push(index);
+		}
+		return static_cast<u64>(vec[vec.len() - 1]);
+	});
+	bench("std::vector push_back u32", 2000, []() {
+		std::vector<u32> vec;
+		for (u32 index = 0; index < push_count; ++index) {
+			vec.push_back(index);
+		}
+		return static_cast<u64>(vec.back());
+	});
+
+	bench("Vector push 64 byte", 2000, []() {
+		Vector<BenchTransform> vec;
+		for (u32 index = 0; index < push_count; ++index) {
+			vec.push(BenchTransform{ { static_cast<f32>(index) } });
+		}
+		return static_cast<u64>(vec[vec.len() - 1].values[0]);
+	});
+	bench("std::vector push_back 64 byte", 2000, []() {
+		std::vector<BenchTransform> vec;
+		for (u32 index = 0; index < push_count; ++index) {
+			vec.push_back(BenchTransform{ { static_cast<f32>(index) } });
+		}
+		return static_cast<u64>(vec.back().values[0]);
+	});
+
+	static u32 source[push_count];
+	for (u32 index = 0; index < push_count; ++index) {
+		source[index] = index * 3;
+	}
+	bench("Vector extend u32", 20000, []() {
+		Vector<u32> vec;
+		vec.extend(Slice<u32 const>(source, push_count));
+		return static_cast<u64>(vec[vec.len() - 1]);
+	});
+	bench("std::vector insert range u32", 20000, []() {
+		std::vector<u32> vec;
+		vec.insert(vec.end(), source, source + push_count);
+		return static_cast<u64>(vec.back());
+	});
+
+	// Reusing a buffer every frame is the common pattern so reset must not touch the allocator.
+	Vector<u32> reused;
+	bench("Vector reset and refill u32", 2000, [&]() {
+		reused.reset();
+		for (u32 index = 0; index < push_count; ++index) {
+			reused.push(index);
+		}
+		return static_cast<u64>(reused.len());
+	});
+	std::vector<u32> std_reused;
+	bench("std::vector clear and refill u32", 2000, [&]() {
+		std_reused.clear();
+		for (u32 index = 0; index < push_count; ++index) {
+			std_reused.push_back(index);
+		}
+		return static_cast<u64>(std_reused.size());
+	});
+}
+
+OP_NAMESPACE_END
@@ -0,0 +1,156 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#include "core/allocator.h"
+#include "core/arena.h"
+#include "core/containers/map.h"
+#include "core/containers/shared.h"
+#include "core/containers/slot_map.h"
+#include "core/containers/string.h"
+#include "core/containers/vector.h"
+#include "doctest/doctest.h"
+
+OP_TEST_BEGIN
+
+struct AllocatorStats {
+	usize allocations = 0;
+	usize live_bytes = 0;
+};
+
+// Counts every allocation made through it so tests can check containers route their memory through the allocator.
+class TrackingAllocator {
+public:
+	explicit TrackingAllocator(AllocatorStats& stats) : m_stats(&stats) {}
+
+	// Allocator
+	NonNull<void> malloc(const core::Layout& layout) const {
+		m_stats->allocations += 1;
+		m_stats->live_bytes += layout.size;
+		return m_global.malloc(layout);
+	}
+	NonNull<void> realloc(NonNull<void> old_ptr, const core::Layout& old_layout, const core::Layout& new_layout) const {
+		m_stats->live_bytes -= old_layout.size;
+		m_stats->allocations += 1;
+		m_stats->live_bytes += new_layout.size;
+		return m_global.realloc(old_ptr, old_layout, new_layout);
+	}
+	void free(NonNull<void> ptr, const core::Layout& layout) const {
+		m_stats->live_bytes -= layout.size;
+		m_global.free(ptr, layout);
+	}
+	// ~Allocator
+
+private:
+	GlobalAllocator m_global;
+	AllocatorStats* m_stats;
+};
+
+static_assert(Allocator<GlobalAllocator>);
+static_assert(Allocator<ArenaAllocator>);
+static_assert(Allocator<TrackingAllocator>);
+static_assert(Allocator<LargePageAllocator>);
+static_assert(sizeof(Vector<u32>) == sizeof(void*) + 2 * sizeof(usize), "Global allocator must not take up space");
+
+struct SharedValue {
+	int value;
+};
+
+TEST_CASE("op::core::Allocator") {
+	AllocatorStats stats;
+	const auto allocator = TrackingAllocator(stats);
+
+	SUBCASE("Vector") {
+		{
+			Vector<u32, TrackingAllocator> vec(allocator);
+			for (u32 i = 0; i < 10; ++i) {
+				vec.push(i);
+			}
+			CHECK(stats.allocations > 0);
+			CHECK(stats.live_bytes == vec.cap() * sizeof(u32));
+		}
+		CHECK(stats.live_bytes == 0);
+	}
+
+	SUBCASE("Over aligned elements") {
+		struct alignas(64) CacheLine {
+			u8 bytes[64];
+		};
+
+		Vector<CacheLine, TrackingAllocator> vec(allocator);
+		for (int i = 0; i < 100; ++i) {
+			vec.push(CacheLine{});
+			CHECK(reinterpret_cast<usize>(&vec[0]) % 64 == 0);
+		}
+	}
+
+	SUBCASE("LargePageAllocator") {
+		Vector<u32, LargePageAllocator> vec;
+		const auto count = LargePageAllocator::threshold / sizeof(u32) * 2;
+		for (u32 i = 0; i < count; ++i) {
+			vec.push(i);
+		}
+		CHECK(vec.cap() * sizeof(u32) >= LargePageAllocator::threshold);
+
+		bool success = true;
+		for (u32 i = 0; i < count; ++i) {
+			if (vec[i] != i) {
+				success = false;
+			}
+		}
+		CHECK(success);
+
+		// Shrinking moves the elements back below the threshold.
+		vec.truncate(16);
+		vec.shrink_to_fit();
+		CHECK(vec.cap() * sizeof(u32) < LargePageAllocator::threshold);
+		CHECK(vec[15] == 15);
+	}
+
+	SUBCASE("Map") {
+		{
+			Map<u64, u64, WyHasher, TrackingAllocator> map(allocator);
+			for (u64 i = 0; i < 100; ++i) {
+				map.insert(i, i * 2);
+			}
+			CHECK(map.find(50).unwrap() == 100);
+			CHECK(stats.live_bytes > 100 * 2 * sizeof(u64));
+
+			auto copy = map;
+			CHECK(copy.find(99).unwrap() == 198);
+		}
+		CHECK(stats.live_bytes == 0);
+	}
+
+	SUBCASE("String") {
+		{
+			auto string = BasicString<TrackingAllocator>::from(StringView("tracked"), allocator);
+			CHECK(string == "tracked");
+			CHECK(stats.live_bytes > 0);
+		}
+		CHECK(stats.live_bytes == 0);
+	}
+
+	SUBCASE("SlotMap") {
+		{
+			SlotMap<u32, TrackingAllocator> slots(allocator);
+			const auto key = slots.insert(5);
+			CHECK(slots.get(key).unwrap() == 5);
+			CHECK(stats.live_bytes > 0);
+		}
+		CHECK(stats.live_bytes == 0);
+	}
+
+	SUBCASE("Shared") {
+		{
+			auto shared = Shared<SharedValue>::make_in(allocator, SharedValue{ 42 });
+			CHECK(shared->value == 42);
+			CHECK(stats.allocations == 1);
+
+			auto weak = shared.downgrade();
+			auto copy = shared;
+			CHECK(copy.strong() == 2);
+		}
+		CHECK(stats.live_bytes == 0);
+	}
+}
+
+OP_TEST_END
@@ -0,0 +1,102 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#include "core/arena.h"
+#include "core/containers/string.h"
+#include "core/containers/vector.h"
+#include "doctest/doctest.h"
+
+OP_TEST_BEGIN
+
+TEST_CASE("op::core::Arena") {
+	Arena arena(1024);
+
+	SUBCASE("Alignment") {
+		void* a = arena.malloc(core::Layout{ 1, 1 });
+		void* b = arena.malloc(core::Layout{ 8, 8 });
+		void* c = arena.malloc(core::Layout{ 64, 64 });
+		CHECK(a != b);
+		CHECK(reinterpret_cast<usize>(b) % 8 == 0);
+		CHECK(reinterpret_cast<usize>(c) % 64 == 0);
+
+		// Larger than a block gets a block of its own.
+		void* big = arena.malloc(core::Layout{ 4096, 16 });
+		CHECK(reinterpret_cast<usize>(big) % 16 == 0);
+		CHECK(arena.allocated_bytes() >= 4096 + 1024);
+	}
+
+	SUBCASE("Markers and scopes") {
+		auto& first = arena.make<u32>(1u);
+		const auto used = arena.used_bytes();
+		{
+			ArenaScope scope(arena);
+			for (int i = 0; i < 100; ++i) {
+				arena.make<u64>(static_cast<u64>(i));
+			}
+			CHECK(arena.used_bytes() > used);
+		}
+		CHECK(arena.used_bytes() == used);
+		CHECK(first == 1u);
+
+		const auto marker = arena.mark();
+		arena.make<u64>(5ull);
+		arena.reset_to(marker);
+		CHECK(arena.used_bytes() == used);
+	}
+
+	SUBCASE("Reset reuses blocks") {
+		for (int i = 0; i < 1000; ++i) {
+			arena.make<u64>(static_cast<u64>(i));
+		}
+		const auto allocated = arena.allocated_bytes();
+
+		arena.reset();
+		CHECK(arena.used_bytes() == 0);
+
+		const auto allocations = core::allocation_count();
+		for (int i = 0; i < 1000; ++i) {
+			arena.make<u64>(static_cast<u64>(i));
+		}
+		CHECK(core::allocation_count() == allocations);
+		CHECK(arena.allocated_bytes() == allocated);
+	}
+
+	SUBCASE("Containers") {
+		Vector<u32, ArenaAllocator> vec(ArenaAllocator{ arena });
+		for (u32 i = 0; i < 100; ++i) {
+			vec.push(i);
+		}
+		REQUIRE(vec.len() == 100);
+		CHECK(vec[99] == 99);
+
+		// The vector was the only thing allocating so it grew in place.
+		CHECK(arena.used_bytes() == vec.cap() * sizeof(u32));
+
+		auto copy = vec;
+		CHECK(copy[50] == 50);
+
+		auto string = BasicString<ArenaAllocator>::from(StringView("hello"), ArenaAllocator{ arena });
+		CHECK(string == "hello");
+		string.push(StringView(" world"));
+		CHECK(string == "hello world");
+	}
+}
+
+TEST_CASE("op::core::FrameArena") {
+	FrameArena frames(256);
+
+	auto& first = frames.current().make<u32>(7u);
+	frames.begin_frame();
+
+	// Memory from the previous frame is still valid during the next one.
+	CHECK(first == 7u);
+	CHECK(frames.previous().used_bytes() > 0);
+	CHECK(frames.current().used_bytes() == 0);
+
+	frames.current().make<u32>(8u);
+	frames.begin_frame();
+	CHECK(frames.frame() == 2);
+	CHECK(frames.current().used_bytes() == 0);
+	CHECK(frames.previous().used_bytes() > 0);
+}
+
+OP_TEST_END
@@ -1,6 +1,7 @@
 // Copyright Colby Hall. All Rights Reserved.
 
 #include "core/containers/array.h"
+#include "core/containers/vector.h"
 #include "doctest/doctest.h"
 
 OP_TEST_BEGIN
@@ -53,6 +54,86 @@ TEST_CASE("op::core::Array") {
 			index += 1;
 		}
 	}
+
+	SUBCASE("Bulk operations") {
+		const int values[] = { 1, 2, 3, 4 };
+		arr.extend(Slice<int const>(values, 4));
+		arr.extend(Slice<int const>(values, 2));
+		REQUIRE(arr.len() == 6);
+		CHECK(arr[3] == 4);
+		CHECK(arr[5] == 2);
+
+		CHECK(arr.find(3).unwrap() == 2);
+		CHECK(!arr.find(7).is_set());
+		CHECK(arr.contains(4));
+
+		arr.fill(9);
+		CHECK(arr.is_full());
+		CHECK(arr[0] == 9);
+		CHECK(arr[127] == 9);
+	}
+
+	SUBCASE("Byte elements") {
+		Array<u8, 64> bytes;
+		bytes.fill(3);
+		CHECK(bytes.len() == 64);
+		CHECK(!bytes.find(4).is_set());
+		bytes[40] = 4;
+		CHECK(bytes.find(4).unwrap() == 40);
+	}
+
+	SUBCASE("Comparing") {
+		Array<int, 4> a = { 1, 2, 3 };
+		Array<int, 4> b = { 1, 2, 3 };
+		CHECK(a == b);
+		b[2] = 4;
+		CHECK(a != b);
+		b.pop();
+		CHECK(a != b);
+
+		// Floats compare by value, not by bytes.
+		Array<f32, 4> positive = { 0.0f, 1.0f };
+		Array<f32, 4> negative = { -0.0f, 1.0f };
+		CHECK(positive == negative);
+	}
+
+	SUBCASE("Trivially copyable and constexpr") {
+		static_assert(std::is_trivially_copyable_v<Array<int, 4>>);
+		static_assert(!std::is_trivially_copyable_v<Array<Vector<int>, 4>>);
+
+		constexpr Array<int, 4> constant = { 5, 6 };
+		static_assert(constant.len() == 2);
+		static_assert(constant[1] == 6);
+
+		Array<int, 4> copy = constant;
+		CHECK(copy.len() == 2);
+		CHECK(copy[0] == 5);
+	}
+
+	SUBCASE("Non trivial elements") {
+		Array<Vector<int>, 4> vectors;
+		for (int i = 0; i < 3; ++i) {
+			Vector<int> vector;
+			vector.push(i);
+			vectors.push(op::move(vector));
+		}
+
+		auto removed = vectors.remove(0);
+		CHECK(removed[0] == 0);
+		CHECK(vectors.len() == 2);
+		CHECK(vectors[0][0] == 1);
+		CHECK(vectors[1][0] == 2);
+
+		auto copy = vectors;
+		CHECK(copy[1][0] == 2);
+
+		auto moved = op::move(vectors);
+		CHECK(vectors.is_empty());
+		CHECK(moved[0][0] == 1);
+
+		auto popped = moved.pop();
+		CHECK(popped.as_ref().unwrap()[0] == 2);
+	}
 }
 
 OP_TEST_END
@@ -0,0 +1,198 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#include "core/containers/bit_vector.h"
+#include "core/containers/bitset.h"
+#include "doctest/doctest.h"
+
+OP_SUPPRESS_WARNINGS_STD_BEGIN
+#include <thread>
+OP_SUPPRESS_WARNINGS_STD_END
+
+OP_TEST_BEGIN
+
+TEST_CASE("op::core::Bitset") {
+	SUBCASE("Setting and counting") {
+		Bitset<130> bits;
+		CHECK(bits.is_empty());
+		CHECK(bits.count() == 0);
+		CHECK(!bits.first_set().is_set());
+
+		bits.set(0);
+		bits.set(64);
+		bits.set(129);
+		CHECK(bits.is_set(64));
+		CHECK(!bits.is_set(63));
+		CHECK(bits.count() == 3);
+
+		bits.unset(64);
+		CHECK(!bits.is_set(64));
+		CHECK(bits.count() == 2);
+
+		bits.set_all();
+		CHECK(bits.count() == 130);
+		bits.reset();
+		CHECK(bits.is_empty());
+	}
+
+	SUBCASE("Set operations") {
+		Bitset<100> a;
+		Bitset<100> b;
+		a.set(1);
+		a.set(70);
+		b.set(70);
+		b.set(99);
+
+		CHECK(a.intersects(b));
+		CHECK(!a.contains_all(b));
+		CHECK((a & b).count() == 1);
+		CHECK((a | b).count() == 3);
+		CHECK((a ^ b).count() == 2);
+
+		// Bits past N stay unset.
+		CHECK((~a).count() == 98);
+
+		auto c = a;
+		c.and_not(b);
+		CHECK(c.is_set(1));
+		CHECK(!c.is_set(70));
+		CHECK(a.contains_all(c));
+		CHECK(c != a);
+	}
+
+	SUBCASE("Iterating") {
+		Bitset<300> bits;
+		const usize expected[] = { 3, 63, 64, 200, 299 };
+		for (auto index : expected) {
+			bits.set(index);
+		}
+
+		usize visited = 0;
+		bits.for_each_set([&](usize index) {
+			CHECK(index == expected[visited]);
+			visited += 1;
+		});
+		CHECK(visited == 5);
+
+		CHECK(bits.first_set().unwrap() == 3);
+		CHECK(bits.next_set(4).unwrap() == 63);
+		CHECK(bits.next_set(65).unwrap() == 200);
+		CHECK(bits.next_set(299).unwrap() == 299);
+		CHECK(!bits.next_set(300).is_set());
+	}
+
+	SUBCASE("Constexpr") {
+		static_assert(std::is_trivially_copyable_v<Bitset<256>>);
+
+		constexpr auto bits = []() {
+			Bitset<8> result;
+			result.set(2);
+			result.set(5);
+			return ~result;
+		}();
+		static_assert(bits.is_set(0));
+		static_assert(!bits.is_set(2));
+	}
+}
+
+TEST_CASE("op::core::BitVector") {
+	SUBCASE("Growing") {
+		BitVector<> bits;
+		CHECK(bits.is_empty());
+		CHECK(!bits.is_set(1000));
+
+		bits.set(1000);
+		CHECK(bits.is_set(1000));
+		CHECK(bits.count() == 1);
+		CHECK(bits.words().len() == 16);
+		CHECK(bits.first_set().unwrap() == 1000);
+
+		// Unsetting past the end does nothing.
+		bits.unset(5000);
+		bits.unset(1000);
+		CHECK(bits.is_empty());
+	}
+
+	SUBCASE("Set operations across lengths") {
+		BitVector<> small;
+		BitVector<> large;
+		small.set(3);
+		large.set(3);
+		large.set(500);
+
+		CHECK(large.contains_all(small));
+		CHECK(!small.contains_all(large));
+		CHECK(small.intersects(large));
+		CHECK(small != large);
+
+		large.unset(500);
+		CHECK(small == large);
+
+		large.set(500);
+		small |= large;
+		CHECK(small.is_set(500));
+		small.and_not(large);
+		CHECK(small.is_empty());
+
+		large &= small;
+		CHECK(large.is_empty());
+	}
+
+	SUBCASE("Iterating") {
+		BitVector<> bits;
+		bits.set(1);
+		bits.set(64);
+		bits.set(700);
+
+		usize sum = 0;
+		bits.for_each_set([&](usize index) { sum += index; });
+		CHECK(sum == 765);
+		CHECK(bits.next_set(65).unwrap() == 700);
+	}
+}
+
+TEST_CASE("op::core::AtomicBitVector") {
+	SUBCASE("Single thread") {
+		AtomicBitVector bits(70);
+		CHECK(bits.len() == 70);
+		CHECK(bits.set(3));
+		CHECK(!bits.set(3));
+		CHECK(bits.is_set(3));
+		CHECK(bits.unset(3));
+		CHECK(!bits.unset(3));
+
+		// Claims hand out every bit exactly once, never the padding past len.
+		for (usize index = 0; index < 70; ++index) {
+			CHECK(bits.claim_first_unset().unwrap() == index);
+		}
+		CHECK(!bits.claim_first_unset().is_set());
+		CHECK(bits.count() == 70);
+	}
+
+	SUBCASE("Many threads") {
+		constexpr usize thread_count = 4;
+		constexpr usize per_thread = 500;
+		AtomicBitVector bits(thread_count * per_thread);
+
+		Atomic<usize> failures = 0;
+		Vector<std::thread> threads;
+		for (usize thread_index = 0; thread_index < thread_count; ++thread_index) {
+			threads.push(std::thread([&]() {
+				for (usize index = 0; index < per_thread; ++index) {
+					if (!bits.claim_first_unset().is_set()) {
+						auto previous = failures.fetch_add(1);
+						OP_UNUSED(previous);
+					}
+				}
+			}));
+		}
+		for (auto& thread : threads) {
+			thread.join();
+		}
+
+		CHECK(failures.load() == 0);
+		CHECK(bits.count() == thread_count * per_thread);
+		CHECK(!bits.claim_first_unset().is_set());
+	}
+}
+
+OP_TEST_END
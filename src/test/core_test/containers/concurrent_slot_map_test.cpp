@@ -0,0 +1,127 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#include "core/containers/concurrent_slot_map.h"
+#include "core/containers/vector.h"
+#include "doctest/doctest.h"
+
+OP_SUPPRESS_WARNINGS_STD_BEGIN
+#include <thread>
+OP_SUPPRESS_WARNINGS_STD_END
+
+OP_TEST_BEGIN
+
+TEST_CASE("op::core::ConcurrentSlotMap") {
+	SUBCASE("Insert, get and remove") {
+		ConcurrentSlotMap<int, 4, 8> map;
+		CHECK(map.is_empty());
+
+		auto a = map.insert(1);
+		auto b = map.insert(2);
+		CHECK(map.len() == 2);
+		CHECK(map.get(a).unwrap() == 1);
+		CHECK(map.get(b).unwrap() == 2);
+
+		map.get(a).unwrap() = 10;
+		CHECK(map.get(a).unwrap() == 10);
+
+		auto removed = map.remove(a);
+		REQUIRE(removed.is_set());
+		CHECK(removed.unwrap() == 10);
+		CHECK(!map.contains(a));
+		CHECK(!map.get(a).is_set());
+		CHECK(!map.remove(a).is_set());
+		CHECK(map.len() == 1);
+
+		// The slot is reused but the stale key stays invalid.
+		auto c = map.insert(3);
+		CHECK(c.index() == a.index());
+		CHECK(c != a);
+		CHECK(!map.contains(a));
+		CHECK(map.get(c).unwrap() == 3);
+	}
+
+	SUBCASE("Keys that were never handed out") {
+		ConcurrentSlotMap<int, 4, 8> map;
+		auto a = map.insert(1);
+
+		// Free slots have even versions, unallocated pages have no slots at all.
+		CHECK(!map.contains(ConcurrentSlotMap<int, 4, 8>::Key(a.index(), a.version() + 1)));
+		CHECK(!map.contains(ConcurrentSlotMap<int, 4, 8>::Key(1, 0)));
+		CHECK(!map.contains(ConcurrentSlotMap<int, 4, 8>::Key(20, 1)));
+		CHECK(!map.contains(ConcurrentSlotMap<int, 4, 8>::Key(1000, 1)));
+	}
+
+	SUBCASE("Growing, iterating and moving") {
+		ConcurrentSlotMap<Vector<int>, 4, 8> map;
+		Vector<ConcurrentSlotMap<Vector<int>, 4, 8>::Key> keys;
+		for (int index = 0; index < 20; ++index) {
+			Vector<int> value;
+			value.push(index);
+			keys.push(map.insert(op::move(value)));
+		}
+		CHECK(map.allocated_bytes() > 0);
+
+		for (usize index = 0; index < keys.len(); index += 2) {
+			CHECK(map.remove(keys[index]).is_set());
+		}
+
+		int sum = 0;
+		usize visited = 0;
+		map.for_each([&](auto key, const Vector<int>& value) {
+			CHECK(map.contains(key));
+			sum += value[0];
+			visited += 1;
+		});
+		CHECK(visited == 10);
+		CHECK(sum == 1 + 3 + 5 + 7 + 9 + 11 + 13 + 15 + 17 + 19);
+
+		auto moved = op::move(map);
+		CHECK(map.is_empty());
+		CHECK(!map.contains(keys[1]));
+		CHECK(moved.len() == 10);
+		CHECK(moved.get(keys[1]).unwrap()[0] == 1);
+	}
+
+	SUBCASE("Many threads") {
+		ConcurrentSlotMap<usize, 64, 256> map;
+		constexpr usize thread_count = 4;
+		constexpr usize iterations = 2000;
+
+		Atomic<usize> failures = 0;
+		Vector<std::thread> threads;
+		for (usize thread_index = 0; thread_index < thread_count; ++thread_index) {
+			threads.push(std::thread([&map, &failures, thread_index]() {
+				Vector<ConcurrentSlotMap<usize, 64, 256>::Key> owned;
+				for (usize index = 0; index < iterations; ++index) {
+					const auto value = thread_index * iterations + index;
+					owned.push(map.insert(usize(value)));
+
+					// Churn the free list while other threads do the same.
+					if (index % 3 == 0) {
+						auto key = owned.pop().unwrap();
+						auto removed = map.remove(key);
+						if (!removed.is_set() || removed.unwrap() != value) {
+							auto previous = failures.fetch_add(1);
+							OP_UNUSED(previous);
+						}
+					}
+				}
+
+				for (auto key : owned) {
+					if (!map.get(key).is_set()) {
+						auto previous = failures.fetch_add(1);
+						OP_UNUSED(previous);
+					}
+				}
+			}));
+		}
+		for (auto& thread : threads) {
+			thread.join();
+		}
+
+		CHECK(failures.load() == 0);
+		CHECK(map.len() == thread_count * (iterations - (iterations + 2) / 3));
+	}
+}
+
+OP_TEST_END
@@ -18,6 +18,28 @@ TEST_CASE("op::core::Map") {
 		CHECK(map.len() == 1);
 	}
 
+	SUBCASE("Map::insert replaces existing values") {
+		Map<int, int> map;
+		map.insert(100, 200);
+		map.insert(100, 300);
+		CHECK(map.len() == 1);
+		CHECK(map.find(100).unwrap() == 300);
+	}
+
+	SUBCASE("Map::insert grows") {
+		Map<int, int> map;
+		for (int i = 0; i < 10000; ++i) {
+			map.insert(i, i * 2);
+		}
+		REQUIRE(map.len() == 10000);
+		CHECK(map.cap() >= map.len());
+		for (int i = 0; i < 10000; ++i) {
+			REQUIRE(map.find(i).is_set());
+			CHECK(map.find(i).unwrap() == i * 2);
+		}
+		CHECK(!map.find(10000).is_set());
+	}
+
 	SUBCASE("Map::remove") {
 		Map<int, int> map;
 		map.insert(100, 200);
@@ -26,6 +48,28 @@ TEST_CASE("op::core::Map") {
 		REQUIRE(value.is_set());
 		const auto x = value.unwrap();
 		CHECK(x == 200);
+		CHECK(map.is_empty());
+		CHECK(!map.find(100).is_set());
+		CHECK(!map.remove(100).is_set());
+	}
+
+	SUBCASE("Map::remove and reinsert") {
+		Map<int, int> map;
+		for (int i = 0; i < 1000; ++i) {
+			map.insert(i, i);
+		}
+		for (int i = 0; i < 1000; i += 2) {
+			REQUIRE(map.remove(i).is_set());
+		}
+		REQUIRE(map.len() == 500);
+		for (int i = 0; i < 1000; ++i) {
+			CHECK(map.find(i).is_set() == (i % 2 == 1));
+		}
+		for (int i = 0; i < 1000; i += 2) {
+			map.insert(i, -i);
+		}
+		CHECK(map.len() == 1000);
+		CHECK(map.find(10).unwrap() == -10);
 	}
 
 	SUBCASE("Map::retain") {
@@ -52,6 +96,17 @@ TEST_CASE("op::core::Map") {
 		CHECK(b == 50);
 	}
 
+	SUBCASE("Map::find_hashed, Map::find_mut_hashed") {
+		Map<int, int> map;
+		map.insert(100, 200);
+		map.insert(99, 100);
+		const auto hash = Map<int, int>::hash_key(99);
+		CHECK(map.find_hashed(99, hash).unwrap() == 100);
+		map.find_mut_hashed(99, hash).unwrap() = 101;
+		CHECK(map.find(99).unwrap() == 101);
+		CHECK(!map.find_hashed(98, Map<int, int>::hash_key(98)).is_set());
+	}
+
 	SUBCASE("Map::iter, Map::iter_mut") {
 		Map<int, int> map;
 		map.insert(100, 200);
@@ -0,0 +1,81 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#include "core/containers/paged_vector.h"
+#include "doctest/doctest.h"
+
+OP_TEST_BEGIN
+
+TEST_CASE("op::core::PagedVector") {
+	PagedVector<int, 4> vec;
+
+	CHECK(vec.len() == 0);
+	CHECK(vec.page_count() == 0);
+
+	SUBCASE("Adding elements") {
+		for (int i = 0; i < 10; ++i) {
+			CHECK(vec.push(i) == static_cast<usize>(i));
+		}
+
+		REQUIRE(vec.len() == 10);
+		CHECK(vec.page_count() == 3);
+		for (int i = 0; i < 10; ++i) {
+			CHECK(vec[i] == i);
+		}
+
+		int expected = 0;
+		for (int value : vec) {
+			CHECK(value == expected);
+			expected += 1;
+		}
+		CHECK(expected == 10);
+
+		CHECK(vec.page(0).len() == 4);
+		CHECK(vec.page(2).len() == 2);
+		CHECK(vec.page(2)[1] == 9);
+	}
+
+	SUBCASE("Stable addresses") {
+		vec.push(42);
+		int* first = &vec[0];
+
+		// Push enough to outgrow the page table several times.
+		for (int i = 0; i < 1000; ++i) {
+			vec.push(i);
+		}
+		CHECK(first == &vec[0]);
+		CHECK(*first == 42);
+		CHECK(vec[1000] == 999);
+	}
+
+	SUBCASE("Removing elements") {
+		vec.push(5);
+		vec.push(10);
+		vec.emplace(15);
+
+		auto popped = vec.pop();
+		REQUIRE(popped.is_set());
+		CHECK(popped.unwrap() == 15);
+		CHECK(vec.len() == 2);
+		CHECK(vec.last().unwrap() == 10);
+
+		const auto cap = vec.cap();
+		vec.reset();
+		CHECK(vec.is_empty());
+		CHECK(vec.cap() == cap); // Pages are kept for reuse
+		CHECK(!vec.pop().is_set());
+	}
+
+	SUBCASE("Moving") {
+		vec.reserve(9);
+		CHECK(vec.cap() >= 9);
+		vec.push(1);
+		vec.push(2);
+
+		auto moved = op::move(vec);
+		CHECK(vec.is_empty());
+		REQUIRE(moved.len() == 2);
+		CHECK(moved[1] == 2);
+	}
+}
+
+OP_TEST_END
@@ -0,0 +1,172 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#include "core/containers/function.h"
+#include "core/containers/mpmc_queue.h"
+#include "core/containers/spsc_queue.h"
+#include "core/containers/vector.h"
+#include "doctest/doctest.h"
+
+OP_SUPPRESS_WARNINGS_STD_BEGIN
+#include <thread>
+OP_SUPPRESS_WARNINGS_STD_END
+
+OP_TEST_BEGIN
+
+namespace {
+	// Owns memory and can only be moved, like the functions and command lists passed through queues.
+	struct Payload {
+		explicit Payload(usize value) { values.push(value); }
+		Payload(Payload&& move) noexcept = default;
+		Payload& operator=(Payload&& move) noexcept = default;
+		Payload(const Payload& copy) = delete;
+		Payload& operator=(const Payload& copy) = delete;
+
+		usize value() const { return values[0]; }
+
+		Vector<usize> values;
+	};
+} // namespace
+
+TEST_CASE("op::core::MpmcQueue") {
+	SUBCASE("Single thread") {
+		MpmcQueue<Payload> queue(4);
+		CHECK(queue.cap() == 4);
+		CHECK(queue.is_empty());
+		CHECK(!queue.pop().is_set());
+
+		for (usize index = 0; index < 4; ++index) {
+			CHECK(queue.push(Payload(index)));
+		}
+		CHECK(queue.len() == 4);
+
+		// A failed push leaves the value with the caller.
+		Payload rejected(99);
+		CHECK(!queue.push(op::move(rejected)));
+		CHECK(rejected.value() == 99);
+
+		for (usize index = 0; index < 4; ++index) {
+			auto popped = queue.pop();
+			REQUIRE(popped.is_set());
+			CHECK(popped.as_ref().unwrap().value() == index);
+		}
+		CHECK(queue.is_empty());
+
+		// Wrap around several times.
+		for (usize index = 0; index < 10; ++index) {
+			CHECK(queue.push(Payload(index)));
+			CHECK(queue.pop().as_ref().unwrap().value() == index);
+		}
+
+		// Elements left behind are destroyed with the queue.
+		CHECK(queue.push(Payload(1)));
+	}
+
+	SUBCASE("Functions") {
+		MpmcQueue<Function<void()>> queue(8);
+		usize sum = 0;
+		for (usize index = 0; index < 5; ++index) {
+			CHECK(queue.push(Function<void()>([&sum, index]() { sum += index; })));
+		}
+		while (true) {
+			auto job = queue.pop();
+			if (!job.is_set()) {
+				break;
+			}
+			job.as_mut().unwrap()();
+		}
+		CHECK(sum == 10);
+	}
+
+	SUBCASE("Many producers and consumers") {
+		MpmcQueue<usize> queue(64);
+		constexpr usize thread_count = 4;
+		constexpr usize per_thread = 10000;
+
+		Atomic<usize> consumed = 0;
+		Atomic<usize> sum = 0;
+		Vector<std::thread> threads;
+		for (usize thread_index = 0; thread_index < thread_count; ++thread_index) {
+			threads.push(std::thread([&queue, thread_index]() {
+				for (usize index = 0; index < per_thread; ++index) {
+					auto value = thread_index * per_thread + index;
+					while (!queue.push(op::move(value))) {
+						std::this_thread::yield();
+					}
+				}
+			}));
+			threads.push(std::thread([&]() {
+				while (consumed.load() < thread_count * per_thread) {
+					auto popped = queue.pop();
+					if (popped.is_set()) {
+						auto previous_sum = sum.fetch_add(popped.unwrap());
+						auto previous = consumed.fetch_add(1);
+						OP_UNUSED(previous_sum);
+						OP_UNUSED(previous);
+					} else {
+						std::this_thread::yield();
+					}
+				}
+			}));
+		}
+		for (auto& thread : threads) {
+			thread.join();
+		}
+
+		constexpr usize total = thread_count * per_thread;
+		CHECK(consumed.load() == total);
+		CHECK(sum.load() == total * (total - 1) / 2);
+		CHECK(queue.is_empty());
+	}
+}
+
+TEST_CASE("op::core::SpscQueue") {
+	SUBCASE("Single thread") {
+		SpscQueue<Payload> queue(2);
+		CHECK(queue.push(Payload(1)));
+		CHECK(queue.push(Payload(2)));
+
+		Payload rejected(3);
+		CHECK(!queue.push(op::move(rejected)));
+		CHECK(rejected.value() == 3);
+
+		CHECK(queue.pop().as_ref().unwrap().value() == 1);
+		CHECK(queue.push(op::move(rejected)));
+		CHECK(queue.len() == 2);
+		CHECK(queue.pop().as_ref().unwrap().value() == 2);
+		CHECK(queue.pop().as_ref().unwrap().value() == 3);
+		CHECK(!queue.pop().is_set());
+
+		CHECK(queue.push(Payload(4)));
+	}
+
+	SUBCASE("Producer and consumer") {
+		SpscQueue<usize> queue(16);
+		constexpr usize count = 100000;
+
+		std::thread producer([&queue]() {
+			for (usize index = 0; index < count; ++index) {
+				auto value = index;
+				while (!queue.push(op::move(value))) {
+					std::this_thread::yield();
+				}
+			}
+		});
+
+		// Elements arrive in the order they were pushed.
+		usize expected = 0;
+		bool in_order = true;
+		while (expected < count) {
+			auto popped = queue.pop();
+			if (popped.is_set()) {
+				in_order &= popped.unwrap() == expected;
+				expected += 1;
+			}
+		}
+		producer.join();
+
+		CHECK(in_order);
+		CHECK(queue.is_empty());
+	}
+}
+
+OP_TEST_END
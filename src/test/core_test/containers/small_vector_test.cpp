@@ -0,0 +1,119 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#include "core/containers/small_vector.h"
+#include "core/containers/unique.h"
+#include "doctest/doctest.h"
+
+OP_TEST_BEGIN
+
+struct Boxed {
+	int value;
+};
+
+TEST_CASE("op::core::SmallVector") {
+	SmallVector<int, 4> vec;
+
+	CHECK(vec.len() == 0);
+	CHECK(vec.cap() == 4); // Inline capacity is available without allocating
+	CHECK(vec.is_inline());
+
+	SUBCASE("Adding elements") {
+		vec.push(5);
+		vec.push(10);
+		vec.push(15);
+
+		REQUIRE(vec.len() == 3);
+		CHECK(vec.is_inline());
+		CHECK(vec[0] == 5);
+		CHECK(vec[1] == 10);
+		CHECK(vec[2] == 15);
+
+		vec.insert(1, 7);
+		REQUIRE(vec.len() == 4);
+		CHECK(vec[0] == 5);
+		CHECK(vec[1] == 7);
+		CHECK(vec[2] == 10);
+		CHECK(vec[3] == 15);
+	}
+
+	SUBCASE("Spilling to the heap") {
+		for (int i = 0; i < 32; ++i) {
+			vec.push(i);
+		}
+
+		REQUIRE(vec.len() == 32);
+		CHECK(!vec.is_inline());
+		for (int i = 0; i < 32; ++i) {
+			CHECK(vec[i] == i);
+		}
+
+		auto copy = vec;
+		CHECK(copy.len() == 32);
+		CHECK(copy[31] == 31);
+
+		auto moved = op::move(vec);
+		CHECK(moved.len() == 32);
+		CHECK(vec.is_empty());
+		CHECK(vec.is_inline());
+	}
+
+	SUBCASE("Removing elements") {
+		vec.push(5);
+		vec.push(10);
+		vec.push(15);
+		vec.push(20);
+
+		auto popped = vec.pop();
+		REQUIRE(popped.is_set());
+		CHECK(popped.unwrap() == 20);
+		CHECK(vec.len() == 3);
+
+		const auto first = vec.remove(0);
+		CHECK(first == 5);
+		REQUIRE(vec.len() == 2);
+		CHECK(vec[0] == 10);
+		CHECK(vec[1] == 15);
+
+		vec.reset();
+		CHECK(vec.is_empty());
+		CHECK(!vec.pop().is_set());
+	}
+
+	SUBCASE("Slice conversion") {
+		vec.push(5);
+		vec.push(10);
+
+		Slice<int const> slice = vec;
+		REQUIRE(slice.len() == 2);
+		CHECK(slice[0] == 5);
+		CHECK(slice[1] == 10);
+
+		const auto from = SmallVector<int, 4>::from(slice);
+		CHECK(from.len() == 2);
+		CHECK(from[1] == 10);
+	}
+
+	SUBCASE("Non trivial elements") {
+		SmallVector<Unique<Boxed>, 2> uniques;
+		for (int i = 0; i < 5; ++i) {
+			uniques.push(Unique<Boxed>::make(Boxed{ i }));
+		}
+
+		auto removed = uniques.remove(1);
+		CHECK(removed->value == 1);
+
+		auto moved = op::move(uniques);
+		REQUIRE(moved.len() == 4);
+		CHECK(moved[0]->value == 0);
+		CHECK(moved[1]->value == 2);
+		CHECK(moved[3]->value == 4);
+
+		SmallVector<Unique<Boxed>, 2> inline_uniques;
+		inline_uniques.push(Unique<Boxed>::make(Boxed{ 42 }));
+		auto inline_moved = op::move(inline_uniques);
+		REQUIRE(inline_moved.len() == 1);
+		CHECK(inline_moved[0]->value == 42);
+	}
+}
+
+OP_TEST_END
@@ -5,6 +5,20 @@
 
 OP_TEST_BEGIN
 
+struct Tracked {
+	static inline int alive = 0;
+
+	int value = 0;
+
+	Tracked() { alive += 1; }
+	explicit Tracked(int v) : value(v) { alive += 1; }
+	Tracked(const Tracked& copy) : value(copy.value) { alive += 1; }
+	Tracked(Tracked&& move) noexcept : value(move.value) { alive += 1; }
+	Tracked& operator=(const Tracked&) = default;
+	Tracked& operator=(Tracked&&) noexcept = default;
+	~Tracked() { alive -= 1; }
+};
+
 TEST_CASE("op::core::Vector") {
 	Vector<int> vec;
 
@@ -56,6 +70,90 @@ TEST_CASE("op::core::Vector") {
 			index += 1;
 		}
 	}
+
+	SUBCASE("Growth") {
+		vec.reserve(10);
+		CHECK(vec.cap() >= 10);
+		CHECK(vec.len() == 0);
+
+		for (int i = 0; i < 1000; ++i) {
+			vec.push(i);
+		}
+		CHECK(vec.len() == 1000);
+		CHECK(vec.cap() >= 1000);
+		CHECK(vec.cap() < 4000); // Growth is geometric and does not over allocate
+		for (int i = 0; i < 1000; ++i) {
+			CHECK(vec[i] == i);
+		}
+
+		vec.truncate(10);
+		CHECK(vec.len() == 10);
+		vec.shrink_to_fit();
+		CHECK(vec.cap() == 10);
+		CHECK(vec[9] == 9);
+
+		vec.reset();
+		vec.shrink_to_fit();
+		CHECK(vec.cap() == 0);
+	}
+
+	SUBCASE("Bulk operations") {
+		const int values[] = { 1, 2, 3, 4 };
+		vec.extend(Slice<int const>(values, 4));
+		vec.extend(Slice<int const>(values, 2));
+		REQUIRE(vec.len() == 6);
+		CHECK(vec[3] == 4);
+		CHECK(vec[5] == 2);
+
+		vec.resize(8);
+		REQUIRE(vec.len() == 8);
+		CHECK(vec[7] == 0);
+
+		vec.resize(10, 42);
+		REQUIRE(vec.len() == 10);
+		CHECK(vec[9] == 42);
+
+		vec.resize(2);
+		REQUIRE(vec.len() == 2);
+		CHECK(vec[1] == 2);
+
+		const auto removed = vec.remove(0);
+		CHECK(removed == 1);
+		CHECK(vec[0] == 2);
+	}
+
+	SUBCASE("Element lifetimes") {
+		{
+			Vector<Tracked> tracked;
+			for (int i = 0; i < 20; ++i) {
+				tracked.emplace(i);
+			}
+			CHECK(Tracked::alive == 20);
+
+			auto copy = tracked;
+			CHECK(Tracked::alive == 40);
+			copy = tracked;
+			CHECK(Tracked::alive == 40);
+
+			auto removed = tracked.remove(3);
+			CHECK(removed.value == 3);
+			CHECK(tracked[3].value == 4);
+			CHECK(Tracked::alive == 40);
+
+			auto popped = tracked.pop();
+			CHECK(popped.as_ref().unwrap().value == 19);
+
+			tracked.resize(5);
+			CHECK(tracked.len() == 5);
+			tracked.resize(8);
+			CHECK(tracked[7].value == 0);
+
+			tracked.reset();
+			CHECK(tracked.is_empty());
+			CHECK(Tracked::alive == 20 + 1 + 1);
+		}
+		CHECK(Tracked::alive == 0);
+	}
 }
 
 OP_TEST_END
@@ -5,15 +5,26 @@ set(CORE_TEST_ROOT ${TEST_ROOT}/core_test)
 set(CORE_TEST_SRC_FILES
         ${CORE_TEST_ROOT}/core_test.cmake
         ${CORE_TEST_ROOT}/core_test.cpp
+        ${CORE_TEST_ROOT}/allocator_test.cpp
+        ${CORE_TEST_ROOT}/arena_test.cpp
+        ${CORE_TEST_ROOT}/hash_test.cpp
+        ${CORE_TEST_ROOT}/job_system_test.cpp
+        ${CORE_TEST_ROOT}/slab_test.cpp
+        ${CORE_TEST_ROOT}/task_test.cpp
 
         ${CORE_TEST_ROOT}/containers/array_test.cpp
+        ${CORE_TEST_ROOT}/containers/bitset_test.cpp
+        ${CORE_TEST_ROOT}/containers/concurrent_slot_map_test.cpp
         ${CORE_TEST_ROOT}/containers/function_test.cpp
         ${CORE_TEST_ROOT}/containers/map_test.cpp
         ${CORE_TEST_ROOT}/containers/non_null_test.cpp
         ${CORE_TEST_ROOT}/containers/option_test.cpp
+        ${CORE_TEST_ROOT}/containers/paged_vector_test.cpp
+        ${CORE_TEST_ROOT}/containers/queue_test.cpp
         ${CORE_TEST_ROOT}/containers/result_test.cpp
         ${CORE_TEST_ROOT}/containers/shared_test.cpp
         ${CORE_TEST_ROOT}/containers/slice_test.cpp
+        ${CORE_TEST_ROOT}/containers/small_vector_test.cpp
         ${CORE_TEST_ROOT}/containers/string_view_test.cpp
         ${CORE_TEST_ROOT}/containers/string_test.cpp
         ${CORE_TEST_ROOT}/containers/vector_test.cpp
@@ -25,7 +36,11 @@ set(CORE_TEST_SRC_FILES
         ${CORE_TEST_ROOT}/math/vec2_test.cpp
         ${CORE_TEST_ROOT}/math/vec3_test.cpp
 
+        ${CORE_TEST_ROOT}/os/cpu_test.cpp
+        ${CORE_TEST_ROOT}/os/fiber_test.cpp
         ${CORE_TEST_ROOT}/os/memory_test.cpp
+        ${CORE_TEST_ROOT}/os/memory_tracking_test.cpp
+        ${CORE_TEST_ROOT}/os/thread_test.cpp
         )
 
 # Group source files
@@ -0,0 +1,82 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#include "core/hash.h"
+#include "doctest/doctest.h"
+
+OP_TEST_BEGIN
+
+static_assert(Hasher<FNV1Hasher>);
+static_assert(Hasher<WyHasher>);
+
+template <typename H>
+static u64 hash_bytes(Slice<u8 const> bytes) {
+	H hasher;
+	hasher.write(bytes);
+	return hasher.finish();
+}
+
+template <typename H>
+static u64 hash_split(Slice<u8 const> bytes, usize chunk) {
+	H hasher;
+	for (usize offset = 0; offset < bytes.len(); offset += chunk) {
+		const auto len = bytes.len() - offset < chunk ? bytes.len() - offset : chunk;
+		hasher.write(Slice<u8 const>(bytes.begin() + offset, len));
+	}
+	return hasher.finish();
+}
+
+TEST_CASE("op::core::Hasher") {
+	u8 data[200];
+	for (usize i = 0; i < sizeof(data); ++i) {
+		data[i] = static_cast<u8>(i * 31 + 7);
+	}
+
+	SUBCASE("FNV1Hasher streams") {
+		const auto bytes = Slice<u8 const>(data, sizeof(data));
+		const auto expected = hash_bytes<FNV1Hasher>(bytes);
+		CHECK(hash_split<FNV1Hasher>(bytes, 1) == expected);
+		CHECK(hash_split<FNV1Hasher>(bytes, 7) == expected);
+	}
+
+	SUBCASE("WyHasher streams") {
+		// Cover every tail length and stripe boundary.
+		for (usize len = 0; len <= sizeof(data); ++len) {
+			const auto bytes = Slice<u8 const>(data, len);
+			const auto expected = hash_bytes<WyHasher>(bytes);
+			REQUIRE(hash_split<WyHasher>(bytes, 1) == expected);
+			REQUIRE(hash_split<WyHasher>(bytes, 5) == expected);
+			REQUIRE(hash_split<WyHasher>(bytes, 32) == expected);
+			REQUIRE(hash_split<WyHasher>(bytes, 33) == expected);
+		}
+	}
+
+	SUBCASE("WyHasher distinguishes inputs") {
+		for (usize len = 1; len <= 64; ++len) {
+			const auto a = hash_bytes<WyHasher>(Slice<u8 const>(data, len));
+			const auto b = hash_bytes<WyHasher>(Slice<u8 const>(data, len - 1));
+			CHECK(a != b);
+
+			u8 copy[64];
+			for (usize i = 0; i < len; ++i) {
+				copy[i] = data[i];
+			}
+			copy[len - 1] ^= 1;
+			CHECK(hash_bytes<WyHasher>(Slice<u8 const>(copy, len)) != a);
+		}
+	}
+
+	SUBCASE("hash") {
+		const u64 value = 0x1234;
+		const auto bytes = Slice<u8 const>((u8 const*)&value, sizeof(value));
+		CHECK(op::hash(value) == hash_bytes<WyHasher>(bytes));
+		CHECK(op::hash<FNV1Hasher>(value) == hash_bytes<FNV1Hasher>(bytes));
+	}
+
+	SUBCASE("WyHasher finish is repeatable") {
+		WyHasher hasher;
+		hasher.write(Slice<u8 const>(data, 40));
+		CHECK(hasher.finish() == hasher.finish());
+	}
+}
+
+OP_TEST_END
@@ -0,0 +1,170 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#include "core/job_system.h"
+#include "doctest/doctest.h"
+
+OP_TEST_BEGIN
+
+TEST_CASE("op::core::JobSystem") {
+	SUBCASE("Run and wait") {
+		JobSystem jobs(3);
+		CHECK(jobs.worker_count() == 3);
+
+		Atomic<usize> sum = 0;
+		JobCounter counter;
+		CHECK(counter.is_done());
+		for (usize index = 0; index < 1000; ++index) {
+			jobs.run(Function<void()>([&sum, index]() {
+						 const auto previous = sum.fetch_add(index);
+						 OP_UNUSED(previous);
+					 }),
+					 counter);
+		}
+		jobs.wait(counter);
+		CHECK(counter.is_done());
+		CHECK(sum.load() == 1000 * 999 / 2);
+	}
+
+	SUBCASE("Without workers") {
+		// The waiting thread runs every job itself.
+		JobSystem jobs(0);
+		usize sum = 0;
+		JobCounter counter;
+		for (usize index = 0; index < 10; ++index) {
+			jobs.run(Function<void()>([&sum, index]() { sum += index; }), counter);
+		}
+		jobs.wait(counter);
+		CHECK(sum == 45);
+	}
+
+	SUBCASE("Nested jobs") {
+		// Jobs that spawn and wait on jobs of their own help run them instead of blocking a worker.
+		JobSystem jobs(2);
+		Atomic<usize> leaves = 0;
+		JobCounter outer;
+		for (usize index = 0; index < 16; ++index) {
+			jobs.run(Function<void()>([&jobs, &leaves]() {
+						 JobCounter inner;
+						 for (usize leaf = 0; leaf < 16; ++leaf) {
+							 jobs.run(Function<void()>([&leaves]() {
+										  const auto previous = leaves.fetch_add(1);
+										  OP_UNUSED(previous);
+									  }),
+									  inner);
+						 }
+						 jobs.wait(inner);
+					 }),
+					 outer);
+		}
+		jobs.wait(outer);
+		CHECK(leaves.load() == 16 * 16);
+	}
+
+	SUBCASE("Deep dependency chain") {
+		// Every job waits on the next one. Far more jobs wait at once than there are workers, or even fibers.
+		JobSystem jobs(2);
+		constexpr usize depth = 200;
+		Atomic<usize> finished = 0;
+		Function<void(usize)> link = [&](usize level) {
+			if (level == depth) {
+				return;
+			}
+			JobCounter next;
+			jobs.run(Function<void()>([&link, level]() { link(level + 1); }), next);
+			jobs.wait(next);
+			const auto previous = finished.fetch_add(1);
+			OP_UNUSED(previous);
+		};
+
+		JobCounter root;
+		jobs.run(Function<void()>([&link]() { link(0); }), root);
+		jobs.wait(root);
+		CHECK(finished.load() == depth);
+	}
+
+	SUBCASE("Dependencies") {
+		JobSystem jobs(3);
+		Vector<usize> values;
+		values.resize(64, 0);
+
+		JobCounter produce;
+		for (usize index = 0; index < 64; ++index) {
+			jobs.run(Function<void()>([&values, index]() { values[index] = index; }), produce);
+		}
+		jobs.wait(produce);
+
+		JobCounter consume;
+		Atomic<usize> sum = 0;
+		for (usize index = 0; index < 64; ++index) {
+			jobs.run(Function<void()>([&values, &sum, index]() {
+						 const auto previous = sum.fetch_add(values[index]);
+						 OP_UNUSED(previous);
+					 }),
+					 consume);
+		}
+		jobs.wait(consume);
+		CHECK(sum.load() == 64 * 63 / 2);
+	}
+
+	SUBCASE("Parallel for") {
+		JobSystem jobs(3);
+		constexpr usize len = 100000;
+		Vector<u32> hits;
+		hits.resize(len, 0);
+
+		Atomic<usize> ranges = 0;
+		jobs.parallel_for(0, len, [&](usize start, usize end) {
+			const auto previous = ranges.fetch_add(1);
+			OP_UNUSED(previous);
+			for (usize index = start; index < end; ++index) {
+				hits[index] += 1;
+			}
+		});
+
+		bool all_once = true;
+		for (usize index = 0; index < len; ++index) {
+			all_once &= hits[index] == 1;
+		}
+		CHECK(all_once);
+		CHECK(ranges.load() == jobs.thread_count() * 4);
+
+		// Small ranges are not split below the grain.
+		ranges.store(0);
+		jobs.parallel_for(
+			0,
+			10,
+			[&](usize start, usize end) {
+				const auto previous = ranges.fetch_add(1);
+				OP_UNUSED(previous);
+				CHECK(end - start == 10);
+			},
+			16);
+		CHECK(ranges.load() == 1);
+
+		ranges.store(0);
+		jobs.parallel_for(5, 5, [&](usize, usize) {
+			const auto previous = ranges.fetch_add(1);
+			OP_UNUSED(previous);
+		});
+		CHECK(ranges.load() == 0);
+	}
+
+	SUBCASE("Queued jobs finish before shutdown") {
+		Atomic<usize> count = 0;
+		JobCounter counter;
+		{
+			JobSystem jobs(2);
+			for (usize index = 0; index < 100; ++index) {
+				jobs.run(Function<void()>([&count]() {
+							 const auto previous = count.fetch_add(1);
+							 OP_UNUSED(previous);
+						 }),
+						 counter);
+			}
+		}
+		CHECK(count.load() == 100);
+		CHECK(counter.is_done());
+	}
+}
+
+OP_TEST_END
@@ -0,0 +1,64 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#include "core/os/cpu.h"
+#include "doctest/doctest.h"
+
+OP_TEST_BEGIN
+
+TEST_CASE("op::core::cpu_topology") {
+	const auto& topology = cpu_topology();
+	REQUIRE(topology.logical_cores.len() > 0);
+	CHECK(topology.logical_cores.len() <= logical_core_count());
+	CHECK(topology.core_count > 0);
+	CHECK(topology.core_count <= topology.logical_cores.len());
+	CHECK(topology.numa_node_count > 0);
+	CHECK(topology.l3_group_count > 0);
+
+	SUBCASE("Ids are dense") {
+		CpuSet all;
+		for (usize index = 0; index < topology.logical_cores.len(); ++index) {
+			const auto& core = topology.logical_cores[index];
+			if (index > 0) {
+				CHECK(topology.logical_cores[index - 1].index < core.index);
+			}
+			CHECK(core.core < topology.core_count);
+			CHECK(core.numa_node < topology.numa_node_count);
+			CHECK(core.l3_group < topology.l3_group_count);
+			all.set(core.index);
+		}
+
+		CpuSet cores;
+		for (u32 core = 0; core < topology.core_count; ++core) {
+			const auto siblings = topology.smt_siblings(core);
+			CHECK(!siblings.is_empty());
+			CHECK(!cores.intersects(siblings));
+			cores |= siblings;
+		}
+		CHECK(cores == all);
+
+		CpuSet groups;
+		for (u32 group = 0; group < topology.l3_group_count; ++group) {
+			const auto members = topology.l3_group(group);
+			CHECK(!members.is_empty());
+			CHECK(!groups.intersects(members));
+			groups |= members;
+		}
+		CHECK(groups == all);
+
+		CpuSet nodes;
+		for (u32 node = 0; node < topology.numa_node_count; ++node) {
+			nodes |= topology.numa_node(node);
+		}
+		CHECK(nodes == all);
+	}
+
+	SUBCASE("SMT siblings share their caches") {
+		for (const auto& core : topology.logical_cores) {
+			topology.smt_siblings(core.core).for_each_set([&](usize index) {
+				CHECK(topology.l3_group(core.l3_group).is_set(index));
+			});
+		}
+	}
+}
+
+OP_TEST_END
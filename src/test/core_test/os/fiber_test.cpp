@@ -0,0 +1,98 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#include "core/os/fiber.h"
+#include "doctest/doctest.h"
+
+OP_TEST_BEGIN
+
+namespace {
+	struct PingPong {
+		Fiber* thread;
+		Fiber* fiber;
+		u32 rounds = 0;
+		f64 product = 1.0;
+	};
+
+	void ping_pong(void* user_data) {
+		auto& state = *static_cast<PingPong*>(user_data);
+		// Locals live on the fiber's own stack and survive every switch.
+		f64 factor = 1.5;
+		while (true) {
+			state.rounds += 1;
+			state.product *= factor;
+			factor += 0.5;
+			Fiber::switch_to(*state.fiber, *state.thread);
+		}
+	}
+
+	struct Chain {
+		Fiber* thread;
+		Fiber* outer;
+		Fiber* inner;
+		u32 trace = 0;
+	};
+
+	void chain_inner(void* user_data) {
+		auto& chain = *static_cast<Chain*>(user_data);
+		chain.trace = chain.trace * 10 + 2;
+		while (true) {
+			Fiber::switch_to(*chain.inner, *chain.outer);
+		}
+	}
+
+	void chain_outer(void* user_data) {
+		auto& chain = *static_cast<Chain*>(user_data);
+		chain.trace = chain.trace * 10 + 1;
+		Fiber::switch_to(*chain.outer, *chain.inner);
+		chain.trace = chain.trace * 10 + 3;
+		while (true) {
+			Fiber::switch_to(*chain.outer, *chain.thread);
+		}
+	}
+} // namespace
+
+TEST_CASE("op::core::Fiber") {
+	SUBCASE("Switch back and forth") {
+		auto thread = Fiber::from_thread();
+		PingPong state;
+		Fiber fiber(&ping_pong, &state, 64 * KB);
+		state.thread = &thread;
+		state.fiber = &fiber;
+
+		Fiber::switch_to(thread, fiber);
+		CHECK(state.rounds == 1);
+		CHECK(state.product == 1.5);
+
+		Fiber::switch_to(thread, fiber);
+		Fiber::switch_to(thread, fiber);
+		CHECK(state.rounds == 3);
+		CHECK(state.product == 1.5 * 2.0 * 2.5);
+	}
+
+	SUBCASE("Fibers switch to each other") {
+		auto thread = Fiber::from_thread();
+		Chain chain;
+		Fiber outer(&chain_outer, &chain);
+		Fiber inner(&chain_inner, &chain);
+		chain.thread = &thread;
+		chain.outer = &outer;
+		chain.inner = &inner;
+
+		Fiber::switch_to(thread, outer);
+		CHECK(chain.trace == 123);
+	}
+
+	SUBCASE("Move") {
+		auto thread = Fiber::from_thread();
+		PingPong state;
+		Fiber created(&ping_pong, &state);
+		Fiber fiber = op::move(created);
+		state.thread = &thread;
+		state.fiber = &fiber;
+
+		Fiber::switch_to(thread, fiber);
+		CHECK(state.rounds == 1);
+	}
+}
+
+OP_TEST_END
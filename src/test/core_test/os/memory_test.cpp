@@ -103,6 +103,132 @@ TEST_CASE("op::core::memory") {
 
 		core::free(a);
 	}
+
+	SUBCASE("Over aligned allocations") {
+		// Alignment in the layout is honored even when it exceeds what the C allocator guarantees.
+		const usize alignments[] = { 32, 64, 256, 4096 };
+		for (auto alignment : alignments) {
+			const auto layout = core::Layout{ 100, alignment };
+			auto a = core::malloc(layout);
+			CHECK(reinterpret_cast<usize>(static_cast<void*>(a)) % alignment == 0);
+
+			auto bytes = a.as<u8>();
+			for (u8 index = 0; index < 100; ++index) {
+				bytes[index] = index;
+			}
+
+			// Realloc keeps the alignment and the contents when the block grows and moves.
+			const auto new_layout = core::Layout{ 64 * 1024, alignment };
+			auto b = core::realloc(a, layout, new_layout);
+			CHECK(reinterpret_cast<usize>(static_cast<void*>(b)) % alignment == 0);
+
+			bool success = true;
+			auto new_bytes = b.as<u8>();
+			for (u8 index = 0; index < 100; ++index) {
+				if (new_bytes[index] != index) {
+					success = false;
+				}
+			}
+			CHECK(success);
+
+			core::free(b);
+		}
+	}
+
+	SUBCASE("op::core::malloc_large, op::core::free_large") {
+		const auto page_size = core::large_page_size();
+		CHECK(page_size >= 4096);
+
+		const auto layout = core::Layout{ page_size * 2 + 1, 64 };
+		auto a = core::malloc_large(layout);
+		// Blocks start on a large page boundary so the OS can back them with huge pages.
+		CHECK(reinterpret_cast<usize>(static_cast<void*>(a)) % page_size == 0);
+
+		auto bytes = a.as<u8>();
+		bytes[0] = 1;
+		bytes[layout.size - 1] = 2;
+		CHECK(bytes[0] == 1);
+		CHECK(bytes[layout.size - 1] == 2);
+
+		core::free_large(a, layout);
+	}
+
+	SUBCASE("op::core::count_ones") {
+		CHECK(core::count_ones(u8(0)) == 0);
+		CHECK(core::count_ones(u8(0xff)) == 8);
+		CHECK(core::count_ones(u32(0x80000001)) == 2);
+		CHECK(core::count_ones(~u64(0)) == 64);
+
+		// Types that are not unsigned integers are counted byte by byte.
+		CHECK(core::count_ones(i32(-1)) == 32);
+		struct Mask {
+			u64 words[3];
+		};
+		CHECK(core::count_ones(Mask{ { 1, 3, 7 } }) == 6);
+
+		// Odd lengths exercise the tail after the last whole word.
+		u8 bytes[37];
+		core::set(bytes, 0x11, sizeof(bytes));
+		CHECK(core::count_ones(bytes, sizeof(bytes)) == 74);
+		CHECK(core::count_ones(bytes, 0) == 0);
+	}
+
+	SUBCASE("op::core::count_trailing_zeros, op::core::count_leading_zeros") {
+		CHECK(core::count_trailing_zeros(u32(8)) == 3);
+		CHECK(core::count_trailing_zeros(u32(0)) == 32);
+		CHECK(core::count_leading_zeros(u64(1)) == 63);
+		CHECK(core::count_leading_zeros(u8(0)) == 8);
+	}
+
+	SUBCASE("op::core::find_first_set") {
+		u64 words[11] = {};
+		CHECK(core::find_first_set(words, 11) == 11 * 64);
+
+		// In the tail past the last group of four words.
+		words[9] = u64(1) << 5;
+		CHECK(core::find_first_set(words, 11) == 9 * 64 + 5);
+
+		words[2] = u64(1) << 63;
+		CHECK(core::find_first_set(words, 11) == 2 * 64 + 63);
+
+		words[0] = 1;
+		CHECK(core::find_first_set(words, 11) == 0);
+	}
+
+	SUBCASE("op::core::find_byte") {
+		u8 bytes[100];
+		core::set(bytes, 0, sizeof(bytes));
+		CHECK(core::find_byte(bytes, 7, sizeof(bytes)) == sizeof(bytes));
+
+		// Every position, including those handled after the last 32 byte chunk.
+		bool success = true;
+		for (usize index = 0; index < sizeof(bytes); ++index) {
+			bytes[index] = 7;
+			if (core::find_byte(bytes, 7, sizeof(bytes)) != index) {
+				success = false;
+			}
+			// Bytes past count are never looked at.
+			if (core::find_byte(bytes, 7, index) != index) {
+				success = false;
+			}
+			bytes[index] = 0;
+		}
+		CHECK(success);
+
+		bytes[40] = 7;
+		bytes[70] = 7;
+		CHECK(core::find_byte(bytes, 7, sizeof(bytes)) == 40);
+		CHECK(core::find_byte(bytes + 41, 7, sizeof(bytes) - 41) == 29);
+	}
+
+	SUBCASE("op::core::compare") {
+		const char a[] = "archetype";
+		const char b[] = "archetypf";
+		CHECK(core::compare(a, a, sizeof(a)) == 0);
+		CHECK(core::compare(a, b, sizeof(a)) < 0);
+		CHECK(core::compare(b, a, sizeof(a)) > 0);
+		CHECK(core::compare(a, b, 8) == 0);
+	}
 }
 
 OP_TEST_END
@@ -0,0 +1,127 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#include "core/containers/map.h"
+#include "core/containers/string_view.h"
+#include "core/containers/vector.h"
+#include "core/os/memory.h"
+#include "core/os/memory_tracking.h"
+#include "doctest/doctest.h"
+
+OP_SUPPRESS_WARNINGS_STD_BEGIN
+#include <cstdio>
+OP_SUPPRESS_WARNINGS_STD_END
+
+OP_TEST_BEGIN
+
+#ifdef OP_ENABLE_MEMORY_TRACKING
+
+TEST_CASE("op::core::MemoryScope") {
+	SUBCASE("Scopes nest") {
+		CHECK(core::current_memory_category() == MemoryCategory::General);
+		{
+			MemoryScope ecs(MemoryCategory::Ecs);
+			CHECK(core::current_memory_category() == MemoryCategory::Ecs);
+			{
+				MemoryScope font(MemoryCategory::Font);
+				CHECK(core::current_memory_category() == MemoryCategory::Font);
+			}
+			CHECK(core::current_memory_category() == MemoryCategory::Ecs);
+		}
+		CHECK(core::current_memory_category() == MemoryCategory::General);
+	}
+
+	SUBCASE("Live and peak bytes") {
+		const auto before = core::memory_stats(MemoryCategory::Canvas);
+
+		void* ptr = nullptr;
+		{
+			MemoryScope scope(MemoryCategory::Canvas);
+			ptr = core::malloc(core::Layout{ 1000, 64 });
+			CHECK(reinterpret_cast<usize>(ptr) % 64 == 0);
+		}
+
+		auto stats = core::memory_stats(MemoryCategory::Canvas);
+		CHECK(stats.live_bytes == before.live_bytes + 1000);
+		CHECK(stats.live_allocations == before.live_allocations + 1);
+		CHECK(stats.total_allocations == before.total_allocations + 1);
+		CHECK(stats.peak_bytes >= before.live_bytes + 1000);
+
+		// Blocks keep their category when reallocated outside the scope.
+		ptr = core::realloc(ptr, core::Layout{ 1000, 64 }, core::Layout{ 5000, 64 });
+		CHECK(reinterpret_cast<usize>(ptr) % 64 == 0);
+		stats = core::memory_stats(MemoryCategory::Canvas);
+		CHECK(stats.live_bytes == before.live_bytes + 5000);
+		CHECK(stats.peak_bytes >= before.live_bytes + 5000);
+
+		core::free(ptr);
+		stats = core::memory_stats(MemoryCategory::Canvas);
+		CHECK(stats.live_bytes == before.live_bytes);
+		CHECK(stats.live_allocations == before.live_allocations);
+		CHECK(stats.peak_bytes >= before.live_bytes + 5000);
+	}
+
+	SUBCASE("Large allocations") {
+		const auto before = core::memory_stats(MemoryCategory::Font);
+		const auto layout = core::Layout{ 3 * MB, 16 };
+		void* ptr = nullptr;
+		{
+			MemoryScope scope(MemoryCategory::Font);
+			ptr = core::malloc_large(layout);
+		}
+		CHECK(core::memory_stats(MemoryCategory::Font).live_bytes == before.live_bytes + layout.size);
+
+		core::free_large(ptr, layout);
+		CHECK(core::memory_stats(MemoryCategory::Font).live_bytes == before.live_bytes);
+	}
+
+	SUBCASE("Map rebuilds are charged to Map") {
+		const auto before = core::memory_stats(MemoryCategory::Map);
+		{
+			Map<u32, u32> map;
+			for (u32 i = 0; i < 1000; ++i) {
+				map.insert(i, i);
+			}
+			CHECK(core::memory_stats(MemoryCategory::Map).live_bytes > before.live_bytes);
+		}
+		CHECK(core::memory_stats(MemoryCategory::Map).live_bytes == before.live_bytes);
+	}
+
+	SUBCASE("Event stream") {
+		const char* path = "memory_tracking_test_events.txt";
+		REQUIRE(core::begin_memory_event_stream(path));
+		{
+			MemoryScope scope(MemoryCategory::Ecs);
+			Vector<u64> vec;
+			vec.push(1);
+		}
+		core::end_memory_event_stream();
+
+		std::FILE* file = std::fopen(path, "r");
+		REQUIRE(file != nullptr);
+		char op = 0;
+		void* address = nullptr;
+		unsigned long long old_size = 0;
+		unsigned long long new_size = 0;
+		char category[32] = {};
+		CHECK(std::fscanf(file, "%c %p %llu %llu %31s", &op, &address, &old_size, &new_size, category) == 5);
+		CHECK(op == 'a');
+		CHECK(new_size > 0);
+		CHECK(StringView(category) == "ECS");
+		std::fclose(file);
+		std::remove(path);
+	}
+}
+
+#else
+
+TEST_CASE("op::core::MemoryScope") {
+	// Scopes and counters compile away to nothing when tracking is disabled.
+	MemoryScope scope(MemoryCategory::Ecs);
+	CHECK(core::current_memory_category() == MemoryCategory::General);
+	CHECK(core::memory_stats(MemoryCategory::Ecs).live_bytes == 0);
+	CHECK(!core::begin_memory_event_stream("unused"));
+}
+
+#endif
+
+OP_TEST_END
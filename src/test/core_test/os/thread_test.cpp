@@ -0,0 +1,57 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#include "core/atomic.h"
+#include "core/os/thread.h"
+#include "doctest/doctest.h"
+
+OP_TEST_BEGIN
+
+TEST_CASE("op::core::Thread") {
+	SUBCASE("Spawn and join") {
+		Atomic<u32> ran = 0;
+		auto thread = Thread::spawn([&ran]() {
+			ran.store(1);
+			return 0;
+		});
+		thread.join();
+		CHECK(ran.load() == 1);
+	}
+
+	SUBCASE("Current") {
+		Atomic<Thread::Id> inside = 0;
+		auto thread = Thread::spawn([&inside]() {
+			inside.store(Thread::current().id());
+			return 0;
+		});
+		thread.join();
+		CHECK(inside.load() == thread.id());
+		CHECK(thread != Thread::current());
+		CHECK(Thread::current() == Thread::current());
+	}
+
+	SUBCASE("Name, affinity and priority") {
+		Atomic<bool> release = false;
+		auto thread = Thread::spawn([&release]() {
+			while (!release.load()) {
+				cpu_relax();
+			}
+			return 0;
+		});
+
+		// Longer than the 15 bytes Linux keeps.
+		thread.set_name(String::from("Test Thread With A Long Name"));
+
+		CpuSet cpus;
+		cpus.set(cpu_topology().logical_cores[0].index);
+		CHECK(thread.set_affinity(cpus));
+		CHECK(!thread.set_affinity(CpuSet{}));
+
+		// Lowering the priority never needs extra rights.
+		CHECK(thread.set_priority(Thread::Priority::Low));
+
+		release.store(true);
+		thread.join();
+	}
+}
+
+OP_TEST_END
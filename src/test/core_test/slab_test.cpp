@@ -0,0 +1,163 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#include "core/containers/function.h"
+#include "core/containers/shared.h"
+#include "core/containers/unique.h"
+#include "core/containers/vector.h"
+#include "core/slab.h"
+#include "doctest/doctest.h"
+
+OP_SUPPRESS_WARNINGS_STD_BEGIN
+#include <thread>
+OP_SUPPRESS_WARNINGS_STD_END
+
+OP_TEST_BEGIN
+
+struct SlabBase {
+	virtual ~SlabBase() = default;
+	virtual u64 value() const = 0;
+};
+
+struct SlabDerived : public SlabBase {
+	explicit SlabDerived(u64 v) : padding{ v, v, v, v } {}
+	u64 value() const override { return padding[0] + padding[3]; }
+
+	u64 padding[4];
+};
+
+// Frees its block from a thread local destructor, which runs after the thread's slab cache is gone.
+struct ExitFree {
+	void* block = nullptr;
+
+	~ExitFree() {
+		const auto allocator = SlabAllocator();
+		const auto layout = core::Layout{ 48, 8 };
+		if (block != nullptr) {
+			allocator.free(block, layout);
+		}
+		allocator.free(allocator.malloc(layout), layout);
+	}
+};
+
+TEST_CASE("op::core::SlabAllocator") {
+	const auto allocator = SlabAllocator();
+
+	SUBCASE("Blocks are reused") {
+		const auto layout = core::Layout{ 40, 8 };
+		void* first = allocator.malloc(layout);
+		allocator.free(first, layout);
+
+		// Sizes in the same class share blocks.
+		void* second = allocator.malloc(core::Layout{ 33, 8 });
+		CHECK(first == second);
+		allocator.free(second, core::Layout{ 33, 8 });
+	}
+
+	SUBCASE("Warm allocations do not reach core::malloc") {
+		const auto layout = core::Layout{ 64, 16 };
+		Vector<void*> blocks;
+		blocks.reserve(256);
+		for (int i = 0; i < 256; ++i) {
+			blocks.push(allocator.malloc(layout));
+		}
+		for (auto* block : blocks) {
+			allocator.free(block, layout);
+		}
+
+		const auto before = core::allocation_count();
+		for (int round = 0; round < 10; ++round) {
+			for (int i = 0; i < 64; ++i) {
+				blocks[i] = allocator.malloc(layout);
+				CHECK(reinterpret_cast<usize>(blocks[i]) % 16 == 0);
+			}
+			for (int i = 0; i < 64; ++i) {
+				allocator.free(blocks[i], layout);
+			}
+		}
+		CHECK(core::allocation_count() == before);
+	}
+
+	SUBCASE("Blocks do not overlap") {
+		Vector<u8*> blocks;
+		for (usize size = 1; size <= SlabAllocator::max_size; size += 7) {
+			auto* block = static_cast<u8*>(static_cast<void*>(allocator.malloc(core::Layout{ size, 1 })));
+			core::set(block, static_cast<u8>(size), size);
+			blocks.push(block);
+		}
+
+		usize size = 1;
+		for (auto* block : blocks) {
+			CHECK(block[0] == static_cast<u8>(size));
+			CHECK(block[size - 1] == static_cast<u8>(size));
+			allocator.free(block, core::Layout{ size, 1 });
+			size += 7;
+		}
+	}
+
+	SUBCASE("Large and over aligned requests") {
+		CHECK(!SlabAllocator::is_small(core::Layout{ SlabAllocator::max_size + 1, 8 }));
+		CHECK(!SlabAllocator::is_small(core::Layout{ 64, 64 }));
+
+		const auto layout = core::Layout{ 4096, 8 };
+		void* ptr = allocator.malloc(layout);
+		ptr = allocator.realloc(ptr, layout, core::Layout{ 8192, 8 });
+		allocator.free(ptr, core::Layout{ 8192, 8 });
+	}
+
+	SUBCASE("Realloc across classes") {
+		auto* ptr = static_cast<u8*>(static_cast<void*>(allocator.malloc(core::Layout{ 16, 8 })));
+		ptr[15] = 42;
+		ptr = static_cast<u8*>(static_cast<void*>(allocator.realloc(ptr, core::Layout{ 16, 8 }, core::Layout{ 1024, 8 })));
+		CHECK(ptr[15] == 42);
+		ptr = static_cast<u8*>(static_cast<void*>(allocator.realloc(ptr, core::Layout{ 1024, 8 }, core::Layout{ 32, 8 })));
+		CHECK(ptr[15] == 42);
+		allocator.free(ptr, core::Layout{ 32, 8 });
+	}
+
+	SUBCASE("Blocks freed on another thread") {
+		const auto layout = core::Layout{ 96, 8 };
+		Vector<void*> blocks;
+		for (int i = 0; i < 200; ++i) {
+			blocks.push(allocator.malloc(layout));
+		}
+
+		std::thread thread([&]() {
+			for (auto* block : blocks) {
+				allocator.free(block, layout);
+			}
+			// Allocate on this thread too so its cache has something to hand back when it exits.
+			allocator.free(allocator.malloc(layout), layout);
+		});
+		thread.join();
+
+		for (auto& block : blocks) {
+			block = allocator.malloc(layout);
+		}
+		for (auto* block : blocks) {
+			allocator.free(block, layout);
+		}
+	}
+
+	SUBCASE("Thread local destructors after the cache") {
+		std::thread thread([&]() {
+			// Constructed before the cache so it is destroyed after it.
+			static thread_local ExitFree exit_free;
+			exit_free.block = allocator.malloc(core::Layout{ 48, 8 });
+		});
+		thread.join();
+	}
+
+	SUBCASE("Containers") {
+		Unique<SlabBase> unique = Unique<SlabDerived>::make(7);
+		CHECK(unique->value() == 14);
+
+		auto shared = Shared<SlabDerived>::make(3);
+		CHECK(shared->value() == 6);
+
+		u64 captured[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+		Function<u64()> function = [captured]() { return captured[7]; };
+		CHECK(function() == 8);
+	}
+}
+
+OP_TEST_END
@@ -0,0 +1,182 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#include "core/containers/unique.h"
+#include "core/task.h"
+#include "doctest/doctest.h"
+
+OP_TEST_BEGIN
+
+namespace {
+	Task<u32> constant(u32 value) { co_return value; }
+
+	Task<u32> add(u32 a, u32 b) {
+		const auto lhs = co_await constant(a);
+		const auto rhs = co_await constant(b);
+		co_return lhs + rhs;
+	}
+
+	Task<u32> count_down(u32 depth) {
+		if (depth == 0) {
+			co_return 0;
+		}
+		co_return co_await count_down(depth - 1) + 1;
+	}
+
+	Task<void> increment(JobSystem& jobs, Atomic<u32>& count) {
+		co_await schedule(jobs);
+		const auto previous = count.fetch_add(1);
+		OP_UNUSED(previous);
+	}
+
+	Task<u32> square(JobSystem& jobs, u32 value) {
+		co_await schedule(jobs);
+		co_return value * value;
+	}
+
+	// Suspends the awaiting coroutine until the test resumes it by hand.
+	struct Parking {
+		std::coroutine_handle<> handle;
+		Atomic<bool> parked = false;
+
+		bool await_ready() const noexcept { return false; }
+		void await_suspend(std::coroutine_handle<> awaiting) noexcept {
+			handle = awaiting;
+			parked.store(true, core::Order::Release);
+		}
+		void await_resume() const noexcept {}
+
+		void resume() {
+			while (!parked.load(core::Order::Acquire)) {
+				cpu_relax();
+			}
+			handle.resume();
+		}
+	};
+
+	Task<u32> park(JobSystem& jobs, Parking& parking, u32 value) {
+		co_await schedule(jobs);
+		co_await parking;
+		co_return value;
+	}
+
+	struct Boxed {
+		u32 value;
+	};
+
+	Task<Unique<Boxed>> boxed(JobSystem& jobs, u32 value) {
+		co_await schedule(jobs);
+		co_return Unique<Boxed>::make(Boxed{ value });
+	}
+
+	Task<u32> sum_of_squares(JobSystem& jobs, u32 count) {
+		Vector<Task<u32>> tasks;
+		for (u32 index = 0; index < count; ++index) {
+			tasks.push(square(jobs, index));
+		}
+		const auto squares = co_await when_all(jobs, op::move(tasks));
+
+		u32 sum = 0;
+		for (const auto value : squares) {
+			sum += value;
+		}
+		co_return sum;
+	}
+} // namespace
+
+TEST_CASE("op::core::Task") {
+	SUBCASE("Await chains") {
+		JobSystem jobs(0);
+		CHECK(block_on(jobs, add(2, 3)) == 5);
+		CHECK(block_on(jobs, count_down(1000)) == 1000);
+	}
+
+	SUBCASE("Tasks are lazy") {
+		JobSystem jobs(0);
+		Atomic<u32> count = 0;
+		{
+			auto task = increment(jobs, count);
+			OP_UNUSED(task);
+		}
+		CHECK(count.load() == 0);
+
+		block_on(jobs, increment(jobs, count));
+		CHECK(count.load() == 1);
+	}
+
+	SUBCASE("Schedule on workers") {
+		JobSystem jobs(2);
+		Atomic<u32> count = 0;
+		for (u32 index = 0; index < 100; ++index) {
+			block_on(jobs, increment(jobs, count));
+		}
+		CHECK(count.load() == 100);
+	}
+
+	SUBCASE("Spawn starts right away") {
+		JobSystem jobs(2);
+		Atomic<u32> count = 0;
+		auto task = spawn(jobs, increment(jobs, count));
+		while (count.load() == 0) {
+			cpu_relax();
+		}
+		block_on(jobs, op::move(task));
+		CHECK(count.load() == 1);
+
+		CHECK(block_on(jobs, spawn(jobs, square(jobs, 7))) == 49);
+	}
+
+	SUBCASE("When all") {
+		JobSystem jobs(3);
+		CHECK(block_on(jobs, sum_of_squares(jobs, 100)) == 328350);
+		CHECK(block_on(jobs, sum_of_squares(jobs, 0)) == 0);
+
+		Atomic<u32> count = 0;
+		Vector<Task<void>> tasks;
+		for (u32 index = 0; index < 64; ++index) {
+			tasks.push(increment(jobs, count));
+		}
+		block_on(jobs, when_all(jobs, op::move(tasks)));
+		CHECK(count.load() == 64);
+	}
+
+	SUBCASE("When any") {
+		JobSystem jobs(2);
+		Parking parking;
+		Vector<Task<u32>> tasks;
+		tasks.push(park(jobs, parking, 1));
+		tasks.push(square(jobs, 5));
+		const auto first = block_on(jobs, when_any(jobs, op::move(tasks)));
+		CHECK(first.index == 1);
+		CHECK(first.value == 25);
+
+		// The parked task still runs to completion after the result was taken.
+		parking.resume();
+	}
+
+	SUBCASE("Move only results") {
+		JobSystem jobs(2);
+		Vector<Task<Unique<Boxed>>> tasks;
+		for (u32 index = 0; index < 8; ++index) {
+			tasks.push(boxed(jobs, index));
+		}
+		auto results = block_on(jobs, when_all(jobs, op::move(tasks)));
+		REQUIRE(results.len() == 8);
+		for (u32 index = 0; index < 8; ++index) {
+			CHECK(results[index]->value == index);
+		}
+	}
+
+	SUBCASE("Many tasks") {
+		JobSystem jobs(3);
+		Vector<Task<u32>> tasks;
+		for (u32 index = 0; index < 16; ++index) {
+			tasks.push(sum_of_squares(jobs, 32));
+		}
+		const auto sums = block_on(jobs, when_all(jobs, op::move(tasks)));
+		for (const auto sum : sums) {
+			CHECK(sum == 10416);
+		}
+	}
+}
+
+OP_TEST_END
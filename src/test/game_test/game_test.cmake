@@ -0,0 +1,26 @@
+# Set the root
+set(GAME_TEST_ROOT ${TEST_ROOT}/game_test)
+
+# Source files
+set(GAME_TEST_SRC_FILES
+        ${GAME_TEST_ROOT}/game_test.cmake
+        ${GAME_TEST_ROOT}/game_test.cpp
+        ${GAME_TEST_ROOT}/query_test.cpp
+        ${GAME_TEST_ROOT}/spatial_test.cpp
+        ${GAME_TEST_ROOT}/world_test.cpp
+        )
+
+# Group source files
+source_group(TREE ${GAME_TEST_ROOT} FILES ${GAME_TEST_SRC_FILES})
+
+add_executable(game_test ${GAME_TEST_SRC_FILES})
+target_include_directories(game_test PUBLIC ${RUNTIME_ROOT} ${THIRD_PARTY_ROOT})
+target_link_libraries(game_test LINK_PUBLIC game doctest)
+set_target_properties(game_test PROPERTIES FOLDER "test")
+
+if ("${CMAKE_SYSTEM_NAME}" STREQUAL "Windows" AND NOT MINGW)
+    target_link_options(game_test PUBLIC "/SUBSYSTEM:CONSOLE")
+endif ()
+
+enable_testing()
+add_test(game_test game_test)
@@ -0,0 +1,156 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#include "game/query.h"
+#include "game/world.h"
+#include "doctest/doctest.h"
+
+OP_TEST_BEGIN
+
+using namespace op::game;
+
+namespace {
+	struct Health : public Component {
+		OP_GAME_COMPONENT(Health) {}
+
+		Health() = default;
+		explicit Health(i32 amount) : value(amount) {}
+
+		i32 value = 0;
+	};
+
+	struct Armor : public Component {
+		OP_GAME_COMPONENT(Armor) {}
+
+		Armor() = default;
+		explicit Armor(i32 amount) : value(amount) {}
+
+		i32 value = 0;
+	};
+
+	struct Speed : public Component {
+		OP_GAME_COMPONENT(Speed) {}
+
+		Speed() = default;
+		explicit Speed(i32 amount) : value(amount) {}
+
+		i32 value = 0;
+	};
+
+	usize count(World& world, Query& query) {
+		usize result = 0;
+		query.execute(world, [&](Query::View&) { result += 1; });
+		return result;
+	}
+} // namespace
+
+TEST_CASE("op::game::Query") {
+	auto registry = ComponentRegistry::make();
+	OP_GAME_REGISTER_COMPONENT(*registry, Health);
+	OP_GAME_REGISTER_COMPONENT(*registry, Armor);
+	OP_GAME_REGISTER_COMPONENT(*registry, Speed);
+
+	World world(*registry);
+	world.spawn().add(Health(1));
+	world.spawn().add(Health(2)).add(Armor(20));
+	world.spawn().add(Armor(30)).add(Speed(300));
+	world.spawn().add(Speed(400));
+
+	SUBCASE("Required terms") {
+		CHECK(count(world, Query().read(Health::type())) == 2);
+		CHECK(count(world, Query().write(Armor::type())) == 2);
+		CHECK(count(world, Query().read(Health::type()).write(Armor::type())) == 1);
+
+		i32 sum = 0;
+		Query().read(Health::type()).execute(world, [&](Query::View& view) { sum += view.read<Health>().value; });
+		CHECK(sum == 3);
+	}
+
+	SUBCASE("with and without") {
+		CHECK(count(world, Query().with(Armor::type())) == 2);
+		CHECK(count(world, Query().read(Health::type()).without(Armor::type())) == 1);
+		CHECK(count(world, Query().without(Health::type()).without(Armor::type())) == 1);
+		CHECK(count(world, Query().with(Health::type()).without(Health::type())) == 0);
+	}
+
+	SUBCASE("any_of") {
+		CHECK(count(world, Query().any_of({ Health::type(), Speed::type() })) == 4);
+		CHECK(count(world, Query().any_of({ Health::type(), Speed::type() }).without(Armor::type())) == 2);
+		CHECK(count(world, Query().any_of({ Health::type() }).any_of({ Armor::type(), Speed::type() })) == 1);
+		CHECK(count(world, Query().any_of({ Health::type() }).any_of({ Speed::type() })) == 0);
+	}
+
+	SUBCASE("Optional access") {
+		usize visited = 0;
+		usize with_armor = 0;
+		Query().read(Health::type()).optional_read(Armor::type()).execute(world, [&](Query::View& view) {
+			visited += 1;
+			auto armor = view.try_read<Armor>();
+			if (armor) {
+				with_armor += 1;
+				CHECK(view.read<Health>().value == 2);
+				CHECK(armor.unwrap().value == 20);
+			}
+		});
+		CHECK(visited == 2);
+		CHECK(with_armor == 1);
+
+		Query().read(Speed::type()).optional_write(Armor::type()).execute(world, [&](Query::View& view) {
+			auto armor = view.try_write<Armor>();
+			CHECK(armor.is_set() == (view.read<Speed>().value == 300));
+			if (armor) {
+				armor.unwrap().value += 1;
+			}
+		});
+
+		i32 armor_sum = 0;
+		Query().read(Armor::type()).execute(world, [&](Query::View& view) { armor_sum += view.read<Armor>().value; });
+		CHECK(armor_sum == 51);
+	}
+
+	SUBCASE("changed_since") {
+		// Everything spawned so far was written at the first tick.
+		const auto last_run = world.increment_change_tick();
+		CHECK(count(world, Query().changed_since(Health::type(), last_run)) == 0);
+		CHECK(count(world, Query().changed_since(Armor::type(), 0)) == 2);
+
+		// Only writes through the view stamp the component, reads and unused write access do not.
+		Query().write(Health::type()).with(Armor::type()).execute(world, [&](Query::View& view) {
+			view.write<Health>().value += 1;
+		});
+		i32 armor_sum = 0;
+		Query().read(Armor::type()).execute(world, [&](Query::View& view) { armor_sum += view.read<Armor>().value; });
+		CHECK(armor_sum == 50);
+		Query().write(Speed::type()).execute(world, [&](Query::View&) {});
+		CHECK(count(world, Query().changed_since(Health::type(), last_run)) == 1);
+		CHECK(count(world, Query().changed_since(Armor::type(), last_run)) == 0);
+		CHECK(count(world, Query().changed_since(Speed::type(), last_run)) == 0);
+
+		// Every filter has to pass.
+		CHECK(count(world, Query().changed_since(Health::type(), last_run).changed_since(Armor::type(), 0)) == 1);
+		CHECK(
+			count(world, Query().changed_since(Health::type(), last_run).changed_since(Armor::type(), last_run)) == 0);
+	}
+
+	SUBCASE("Components the query does not name are not accessible") {
+		usize visited = 0;
+		Query().with(Armor::type()).execute(world, [&](Query::View& view) {
+			visited += 1;
+			CHECK(!view.try_read<Armor>().is_set());
+			CHECK(!view.try_write<Armor>().is_set());
+		});
+		CHECK(visited == 2);
+
+		Query().read(Armor::type()).execute(world, [&](Query::View& view) {
+			CHECK(view.try_read<Armor>().is_set());
+			CHECK(!view.try_write<Armor>().is_set());
+			CHECK(!view.try_read<Health>().is_set());
+		});
+
+		Query().write(Armor::type()).execute(world, [&](Query::View& view) {
+			CHECK(view.try_write<Armor>().is_set());
+			CHECK(!view.try_read<Armor>().is_set());
+		});
+	}
+}
+
+OP_TEST_END
@@ -0,0 +1,84 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#include "game/query.h"
+#include "game/spatial.h"
+#include "game/world.h"
+#include "doctest/doctest.h"
+
+OP_SUPPRESS_WARNINGS_STD_BEGIN
+#include <limits>
+OP_SUPPRESS_WARNINGS_STD_END
+
+OP_TEST_BEGIN
+
+using namespace op::game;
+
+TEST_CASE("op::game::SpatialHashGrid") {
+	auto registry = ComponentRegistry::make();
+	OP_GAME_REGISTER_COMPONENT(*registry, Transform);
+
+	SpatialHashGrid grid(2.f, 64);
+	grid.observe(*registry);
+
+	// One entity per unit along the x axis.
+	World world(*registry);
+	Vector<EntityId> ids;
+	for (i32 index = 0; index < 100; ++index) {
+		Transform transform;
+		transform.position = Vector3<f32>(static_cast<f32>(index), 0.f, 0.f);
+		ids.push(world.spawn().add(op::move(transform)).id());
+	}
+	grid.update(world);
+	REQUIRE(grid.len() == 100);
+
+	Vector<EntityId> out;
+
+	SUBCASE("Radius and bounds") {
+		grid.query_radius(Vector3<f32>(10.f, 0.f, 0.f), 2.5f, out);
+		CHECK(out.len() == 5);
+
+		out.reset();
+		grid.query_aabb(Vector3<f32>(-1.f), Vector3<f32>(3.f), out);
+		CHECK(out.len() == 4);
+
+		// Spans more cells than a query walks so every entity is tested directly.
+		out.reset();
+		grid.query_radius(Vector3<f32>(50.f, 0.f, 0.f), 30.f, out);
+		CHECK(out.len() == 61);
+	}
+
+	SUBCASE("Huge queries") {
+		grid.query_radius(Vector3<f32>(0.f), 1e9f, out);
+		CHECK(out.len() == 100);
+
+		out.reset();
+		constexpr f32 infinity = std::numeric_limits<f32>::infinity();
+		grid.query_aabb(Vector3<f32>(-infinity), Vector3<f32>(infinity), out);
+		CHECK(out.len() == 100);
+	}
+
+	SUBCASE("Update and remove") {
+		Query().write(Transform::type()).execute(world, [&](Query::View& view) {
+			if (view.entity() == ids[10]) view.write<Transform>().position = Vector3<f32>(-20.f, 0.f, 0.f);
+		});
+		grid.update(world);
+
+		grid.query_radius(Vector3<f32>(-20.f, 0.f, 0.f), 1.f, out);
+		CHECK(out.len() == 1);
+
+		out.reset();
+		grid.query_radius(Vector3<f32>(10.f, 0.f, 0.f), 0.5f, out);
+		CHECK(out.len() == 0);
+
+		// Despawned entities leave the grid once events are flushed.
+		CHECK(world.despawn(ids[11]));
+		world.flush_events();
+		CHECK(grid.len() == 99);
+
+		out.reset();
+		grid.query_radius(Vector3<f32>(11.f, 0.f, 0.f), 0.5f, out);
+		CHECK(out.len() == 0);
+	}
+}
+
+OP_TEST_END
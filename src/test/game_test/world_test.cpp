@@ -0,0 +1,244 @@
+// Copyright Colby Hall. All Rights Reserved.
+
+#include "game/query.h"
+#include "game/world.h"
+#include "doctest/doctest.h"
+
+OP_TEST_BEGIN
+
+using namespace op::game;
+
+namespace {
+	struct Fuel : public Component {
+		OP_GAME_COMPONENT(Fuel) {}
+
+		Fuel() = default;
+		explicit Fuel(i32 amount) : value(amount) {}
+
+		i32 value = 0;
+	};
+
+	struct Cargo : public Component {
+		OP_GAME_COMPONENT(Cargo) {}
+
+		Cargo() = default;
+		explicit Cargo(i32 amount) : value(amount) {}
+
+		i32 value = 0;
+	};
+
+	struct Event {
+		ComponentType type;
+		ComponentEvent event;
+		Vector<EntityId> entities;
+	};
+
+	bool contains(Slice<EntityId const> entities, EntityId id) {
+		for (auto it : entities) {
+			if (it == id) return true;
+		}
+		return false;
+	}
+
+	Option<i32> find_fuel(World& world, EntityId id) {
+		Option<i32> result;
+		Query().read(Fuel::type()).execute(world, [&](Query::View& view) {
+			if (view.entity() == id) result = view.read<Fuel>().value;
+		});
+		return result;
+	}
+
+	usize count(World& world, Query& query) {
+		usize result = 0;
+		query.execute(world, [&](Query::View&) { result += 1; });
+		return result;
+	}
+} // namespace
+
+TEST_CASE("op::game::World") {
+	auto registry = ComponentRegistry::make();
+	OP_GAME_REGISTER_COMPONENT(*registry, Fuel);
+	OP_GAME_REGISTER_COMPONENT(*registry, Cargo);
+
+	SUBCASE("Observers") {
+		Vector<Event> events;
+		const auto record = [&](ComponentType type, ComponentEvent event) {
+			registry->observe(type, event, [&events, type, event](World&, Slice<EntityId const> entities) {
+				events.push(Event{ type, event, Vector<EntityId>::from(entities) });
+			});
+		};
+		record(Fuel::type(), ComponentEvent::Added);
+		record(Fuel::type(), ComponentEvent::Removed);
+		record(Cargo::type(), ComponentEvent::Added);
+		record(Cargo::type(), ComponentEvent::Removed);
+
+		World world(*registry);
+		Vector<EntityId> ids;
+		for (i32 index = 0; index < 3; ++index) {
+			ids.push(world.spawn().add(Fuel(index)).add(Cargo(index)).id());
+		}
+
+		// Events are batched into one call per type.
+		world.flush_events();
+		REQUIRE(events.len() == 2);
+		for (auto& event : events) {
+			CHECK(event.event == ComponentEvent::Added);
+			CHECK(event.entities.len() == 3);
+		}
+		events.reset();
+
+		// Nothing is dispatched twice.
+		world.flush_events();
+		CHECK(events.len() == 0);
+
+		CHECK(world.despawn(ids[0]));
+		world.get(ids[1]).unwrap().remove(Fuel::type());
+		const auto short_lived = world.spawn().add(Cargo(8)).add(Fuel(9)).id();
+		world.get(short_lived).unwrap().remove(Fuel::type());
+		const auto kept = world.spawn().add(Fuel(10)).id();
+		world.flush_events();
+
+		// Every removal is dispatched before any addition.
+		REQUIRE(events.len() == 4);
+		CHECK(events[0].event == ComponentEvent::Removed);
+		CHECK(events[1].event == ComponentEvent::Removed);
+		CHECK(events[2].event == ComponentEvent::Added);
+		CHECK(events[3].event == ComponentEvent::Added);
+
+		for (auto& event : events) {
+			const bool fuel = event.type == Fuel::type();
+			if (event.event == ComponentEvent::Removed && fuel) {
+				CHECK(event.entities.len() == 3);
+				CHECK(contains(event.entities, ids[0]));
+				CHECK(contains(event.entities, ids[1]));
+				CHECK(contains(event.entities, short_lived));
+			} else if (event.event == ComponentEvent::Removed) {
+				CHECK(event.entities.len() == 1);
+				CHECK(contains(event.entities, ids[0]));
+			} else if (fuel) {
+				// The entity that gained and lost Fuel between flushes is only reported as removed.
+				CHECK(event.entities.len() == 1);
+				CHECK(contains(event.entities, kept));
+			} else {
+				CHECK(event.entities.len() == 1);
+				CHECK(contains(event.entities, short_lived));
+			}
+		}
+	}
+
+	SUBCASE("Merge") {
+		usize added = 0;
+		registry->observe(Fuel::type(), ComponentEvent::Added, [&](World&, Slice<EntityId const> entities) {
+			added += entities.len();
+		});
+
+		World world(*registry);
+		for (i32 index = 0; index < 5; ++index) {
+			OP_UNUSED(world.spawn().add(Fuel(index)).id());
+		}
+		world.flush_events();
+		added = 0;
+
+		World chunk(*registry);
+		Vector<EntityId> ids;
+		for (i32 index = 0; index < 10; ++index) {
+			ids.push(chunk.spawn().add(Fuel(100 + index)).add(Cargo(index)).id());
+		}
+		ids.push(chunk.spawn().add(Fuel(200)).id());
+		CHECK(chunk.despawn(ids[0]));
+
+		const auto remap = world.merge(op::move(chunk));
+
+		// Despawned entities are not remapped.
+		CHECK(remap.len() == 10);
+		CHECK(!remap.find(ids[0]).is_set());
+
+		// Columns are appended after the existing rows and keep their values.
+		CHECK(count(world, Query().read(Fuel::type())) == 15);
+		for (usize index = 1; index < 10; ++index) {
+			const auto id = remap.find(ids[index]).unwrap();
+			CHECK(find_fuel(world, id).unwrap() == 100 + static_cast<i32>(index));
+		}
+		CHECK(find_fuel(world, remap.find(ids[10]).unwrap()).unwrap() == 200);
+		Query().read(Cargo::type()).execute(world, [&](Query::View& view) {
+			CHECK(remap.find(ids[static_cast<usize>(view.read<Cargo>().value)]).unwrap() == view.entity());
+		});
+
+		// Merged entities are reported as added.
+		world.flush_events();
+		CHECK(added == 10);
+
+		// The moved-from world is empty but still usable.
+		CHECK(count(chunk, Query().read(Fuel::type())) == 0);
+		const auto respawned = chunk.spawn().add(Fuel(300)).id();
+		CHECK(count(chunk, Query().read(Fuel::type())) == 1);
+		CHECK(find_fuel(chunk, respawned).unwrap() == 300);
+	}
+
+	SUBCASE("Transfer") {
+		World source(*registry);
+		const auto stays = source.spawn().add(Fuel(1)).id();
+		const auto leaves = source.spawn().add(Fuel(2)).add(Cargo(20)).id();
+
+		World target(*registry);
+		OP_UNUSED(target.spawn().add(Fuel(3)).id());
+
+		const auto moved = source.transfer(leaves, target).unwrap();
+		CHECK(!source.get(leaves).is_set());
+		CHECK(source.get(stays).is_set());
+		CHECK(find_fuel(source, stays).unwrap() == 1);
+		CHECK(count(source, Query().read(Fuel::type())) == 1);
+
+		CHECK(target.get(moved).is_set());
+		CHECK(find_fuel(target, moved).unwrap() == 2);
+		CHECK(count(target, Query().read(Fuel::type())) == 2);
+		Query().read(Cargo::type()).execute(target, [&](Query::View& view) {
+			CHECK(view.entity() == moved);
+			CHECK(view.read<Cargo>().value == 20);
+		});
+
+		// Unknown ids are not transferred.
+		CHECK(!source.transfer(leaves, target).is_set());
+	}
+
+	SUBCASE("Compact") {
+		World world(*registry);
+		Vector<EntityId> ids;
+		for (i32 index = 0; index < 100; ++index) {
+			ids.push(world.spawn().add(Fuel(index)).add(Cargo(index * 2)).id());
+		}
+		for (usize index = 0; index < ids.len(); index += 2) {
+			CHECK(world.despawn(ids[index]));
+		}
+
+		const auto before = world.memory_report();
+		u32 free_rows = 0;
+		for (auto& archetype : before.archetypes) {
+			free_rows += archetype.free_rows;
+		}
+		CHECK(free_rows > 0);
+		for (auto& component : before.components) {
+			CHECK(component.used_slots == 50);
+		}
+
+		CHECK(world.compact() > 0);
+
+		// Freed rows are released.
+		const auto after = world.memory_report();
+		for (auto& archetype : after.archetypes) {
+			CHECK(archetype.free_rows == 0);
+		}
+		CHECK(after.archetype_bytes < before.archetype_bytes);
+
+		// Ids still resolve to the values they had before.
+		for (usize index = 1; index < ids.len(); index += 2) {
+			CHECK(find_fuel(world, ids[index]).unwrap() == static_cast<i32>(index));
+		}
+		Query().read(Fuel::type()).read(Cargo::type()).execute(world, [&](Query::View& view) {
+			CHECK(view.read<Cargo>().value == view.read<Fuel>().value * 2);
+		});
+		CHECK(count(world, Query().read(Fuel::type())) == 50);
+	}
+}
+
+OP_TEST_END
@@ -1 +1,3 @@
 include(${TEST_ROOT}/core_test/core_test.cmake)
+include(${TEST_ROOT}/game_test/game_test.cmake)
+include(${TEST_ROOT}/core_bench/core_bench.cmake)